@@ -0,0 +1,284 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "test_exportjournal.h"
+#include "../testdatalocation.h"
+#include "bootmodel.h"
+#include "exportjournal.h"
+#include "journaldexportreader.h"
+#include "journaldviewmodel.h"
+#include "journalindex.h"
+#include <QAbstractItemModelTester>
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QTemporaryFile>
+#include <QTest>
+#include <QTimeZone>
+#include <QtEndian>
+#include <algorithm>
+
+void TestExportJournal::indexAccess()
+{
+    JournalIndex index(JOURNAL_EXPORT_FORMAT_EXAMPLE);
+    QVERIFY(index.isValid());
+    QCOMPARE(index.size(), 2);
+    QCOMPARE(index.realtime(0), 1342540861416409);
+    QCOMPARE(index.monotonic(1), 21415221039);
+
+    const QList<JournaldExportReader::Field> fields = index.fields(1);
+    const auto message = std::find_if(fields.cbegin(), fields.cend(), [](const JournaldExportReader::Field &field) {
+        return field.name == "MESSAGE";
+    });
+    QVERIFY(message != fields.cend());
+    QCOMPARE(message->value, QByteArrayView("(root) CMD (run-parts /etc/cron.hourly)"));
+
+    const QList<JournaldHelper::BootInfo> boots = index.bootInfo();
+    QCOMPARE(boots.size(), 1);
+    QCOMPARE(boots.at(0).mBootId, QLatin1String("6c7c6013a26343b29e964691ff25d04c"));
+    QCOMPARE(boots.at(0).mSince, QDateTime::fromMSecsSinceEpoch(1342540861416));
+    QCOMPARE(boots.at(0).mUntil, QDateTime::fromMSecsSinceEpoch(1342540861421));
+
+    JournalIndex invalidIndex(QLatin1String("/does/not/exist.export"));
+    QVERIFY(!invalidIndex.isValid());
+    QCOMPARE(invalidIndex.size(), 0);
+}
+
+void TestExportJournal::filterSemantics()
+{
+    JournalIndex index(JOURNAL_EXPORT_FORMAT_EXAMPLE);
+
+    Filter filter;
+    QCOMPARE(index.filter(filter), QList<qsizetype>({0, 1}));
+
+    filter.setPriorityFilter(4);
+    QCOMPARE(index.filter(filter), QList<qsizetype>({0}));
+    filter.resetPriorityFilter();
+
+    filter.setExeFilter({QLatin1String("/usr/bin/bash")});
+    QCOMPARE(index.filter(filter), QList<qsizetype>({1}));
+    filter.setExeFilter({QLatin1String("/usr/bin/unknown")});
+    QCOMPARE(index.filter(filter), QList<qsizetype>());
+    filter.setExeFilter({});
+
+    // kernel messages only, because syslog transport is not part of kernel transports
+    filter.setKernelMessagesEnabled(true);
+    filter.setSystemdSystemUnitFilter({QLatin1String("foo.service")});
+    QCOMPARE(index.filter(filter), QList<qsizetype>());
+    filter.setSystemdSystemUnitFilter({});
+    QCOMPARE(index.filter(filter), QList<qsizetype>({0, 1}));
+    filter.setKernelMessagesEnabled(false);
+
+    filter.setBootFilter({QLatin1String("6c7c6013a26343b29e964691ff25d04c")});
+    QCOMPARE(index.filter(filter), QList<qsizetype>({0, 1}));
+    filter.setBootFilter({QLatin1String("27acae2fe35a40ac93f9c7732c0b8e59")});
+    QCOMPARE(index.filter(filter), QList<qsizetype>());
+}
+
+void TestExportJournal::uniqueCounts()
+{
+    JournalIndex index(JOURNAL_EXPORT_FORMAT_EXAMPLE);
+    const auto counts = index.uniqueCounts(QLatin1String("6c7c6013a26343b29e964691ff25d04c"),
+                                           {JournaldHelper::Field::_EXE, JournaldHelper::Field::PRIORITY, JournaldHelper::Field::_SYSTEMD_UNIT});
+    QCOMPARE(counts.value(JournaldHelper::Field::_EXE).value(QLatin1String("/usr/bin/bash")), 1);
+    QCOMPARE(counts.value(JournaldHelper::Field::_EXE).value(QLatin1String("/usr/libexec/gdm-session-worker")), 1);
+    QCOMPARE(counts.value(JournaldHelper::Field::PRIORITY).value(QLatin1String("4")), 1);
+    QCOMPARE(counts.value(JournaldHelper::Field::PRIORITY).value(QLatin1String("6")), 1);
+    QVERIFY(counts.value(JournaldHelper::Field::_SYSTEMD_UNIT).isEmpty());
+}
+
+void TestExportJournal::parallelIndex()
+{
+    QFile file(JOURNAL_EXPORT_FORMAT_EXAMPLE);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray example = file.readAll();
+    while (example.endsWith('\n')) {
+        example.chop(1);
+    }
+    example.append("\n\n");
+
+    // binary message that contains a sequence of entries with valid structure
+    const QByteArray payload("a\n\n_EXE=/usr/bin/fake\n\n_EXE=/usr/bin/fake\n\n_EXE=/usr/bin/fake\n\nb");
+    QByteArray adversarial("MESSAGE\n");
+    adversarial.append(8, '\0');
+    qToLittleEndian<quint64>(payload.size(), adversarial.data() + adversarial.size() - 8);
+    adversarial.append(payload);
+    adversarial.append("\nPRIORITY=3\n_BOOT_ID=27acae2fe35a40ac93f9c7732c0b8e59\n\n");
+
+    QTemporaryFile exportFile(QDir::tempPath() + QLatin1String("/XXXXXX.export"));
+    QVERIFY(exportFile.open());
+    for (int i = 0; i < 200; ++i) {
+        exportFile.write(i % 20 == 7 ? adversarial : example);
+    }
+    exportFile.close();
+
+    JournalIndex sequentialIndex(exportFile.fileName(), 1);
+    QCOMPARE(sequentialIndex.size(), 190 * 2 + 10);
+
+    Filter bootFilter;
+    bootFilter.setBootFilter({QLatin1String("27acae2fe35a40ac93f9c7732c0b8e59")});
+    Filter exeFilter;
+    exeFilter.setExeFilter({QLatin1String("/usr/bin/fake")});
+    QCOMPARE(sequentialIndex.filter(bootFilter).size(), 10);
+    QVERIFY(sequentialIndex.filter(exeFilter).isEmpty());
+
+    for (int threads : {2, 3, 4, 7, 16}) {
+        JournalIndex index(exportFile.fileName(), threads);
+        QCOMPARE(index.size(), sequentialIndex.size());
+        QCOMPARE(index.filter(Filter()), sequentialIndex.filter(Filter()));
+        QCOMPARE(index.filter(bootFilter), sequentialIndex.filter(bootFilter));
+        QVERIFY(index.filter(exeFilter).isEmpty());
+        for (qsizetype i = 0; i < index.size(); ++i) {
+            QCOMPARE(index.realtime(i), sequentialIndex.realtime(i));
+            QCOMPARE(index.fields(i).size(), sequentialIndex.fields(i).size());
+        }
+        QCOMPARE(index.bootInfo().size(), 2);
+    }
+}
+
+void TestExportJournal::viewModelAccess()
+{
+    ExportJournal provider(JOURNAL_EXPORT_FORMAT_BINARY_EXAMPLE);
+    QVERIFY(!provider.openJournal());
+    QVERIFY(provider.journalIndex());
+
+    JournaldViewModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+    model.setJournalProvider(&provider);
+    QVERIFY(model.isAvailable());
+    QCOMPARE(model.rowCount(), 1);
+
+    const QModelIndex index = model.index(0, 0);
+    QCOMPARE(model.data(index, JournaldViewModel::MESSAGE).toString(), QLatin1String("foo\nbar"));
+    QCOMPARE(model.data(index, JournaldViewModel::EXE).toString(), QLatin1String("/usr/bin/python3.9"));
+    QCOMPARE(model.data(index, JournaldViewModel::BOOT_ID).toString(), QLatin1String("750d24b817364f5ebc286c0b32df2ad0"));
+    QCOMPARE(model.data(index, JournaldViewModel::DATETIME).toDateTime(), QDateTime::fromMSecsSinceEpoch(1627721964791, QTimeZone::UTC));
+    QCOMPARE(model.data(index, JournaldViewModel::MONOTONIC_TIMESTAMP).toULongLong(), 44243800086);
+    QCOMPARE(model.data(index, JournaldViewModel::CURSOR).toString(),
+             QLatin1String("s=4801b45403ee41f9bfc72b56ef154ecf;i=1799;b=750d24b817364f5ebc286c0b32df2ad0;m=a4d22d016;t=5c8678d812639;x=8420cef2a679132b"));
+
+    // journal transport is no kernel transport
+    Filter filter = model.filter();
+    filter.setKernelMessagesEnabled(true);
+    filter.setExeFilter({QLatin1String("/usr/bin/bash")});
+    model.setFilter(filter);
+    QCOMPARE(model.rowCount(), 0);
+    filter.setExeFilter({QLatin1String("/usr/bin/python3.9")});
+    model.setFilter(filter);
+    QCOMPARE(model.rowCount(), 1);
+
+    model.seekTail();
+    QCOMPARE(model.rowCount(), 1);
+    model.seekHead();
+    QCOMPARE(model.rowCount(), 1);
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+}
+
+void TestExportJournal::backgroundIndex()
+{
+    ExportJournal provider(JOURNAL_EXPORT_FORMAT_BINARY_EXAMPLE, ExportJournal::IndexMode::Background);
+    QSignalSpy readySpy(&provider, &ExportJournal::indexReady);
+
+    // index is only published from the event loop
+    QVERIFY(!provider.isIndexReady());
+    QVERIFY(!provider.journalIndex());
+    JournaldViewModel model;
+    BootModel bootModel;
+    model.setJournalProvider(&provider);
+    bootModel.setJournalProvider(&provider);
+    QVERIFY(!model.isAvailable());
+    QCOMPARE(bootModel.rowCount(), 0);
+
+    QTRY_COMPARE_WITH_TIMEOUT(readySpy.count(), 1, 5000);
+    QVERIFY(provider.isIndexReady());
+    QVERIFY(provider.journalIndex());
+    model.setJournalProvider(&provider);
+    bootModel.setJournalProvider(&provider);
+    QVERIFY(model.isAvailable());
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(bootModel.rowCount(), 1);
+
+    // canceled indexing leaves the index empty
+    const std::atomic_bool canceled{true};
+    const JournalIndex canceledIndex(JOURNAL_EXPORT_FORMAT_EXAMPLE, 2, &canceled);
+    QCOMPARE(canceledIndex.size(), 0);
+
+    // destroying the provider while indexing does not wait for the worker
+    auto indexingProvider = std::make_unique<ExportJournal>(JOURNAL_EXPORT_FORMAT_EXAMPLE, ExportJournal::IndexMode::Background);
+    indexingProvider.reset();
+    QTest::qWait(100);
+}
+
+void TestExportJournal::bootModelAccess()
+{
+    ExportJournal provider(JOURNAL_EXPORT_FORMAT_EXAMPLE);
+    BootModel model;
+    model.setJournalProvider(&provider);
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(model.data(model.index(0, 0), BootModel::BOOT_ID).toString(), QLatin1String("6c7c6013a26343b29e964691ff25d04c"));
+}
+
+void TestExportJournal::exportFormats()
+{
+    ExportJournal provider(JOURNAL_EXPORT_FORMAT_EXAMPLE);
+    JournaldViewModel model;
+    model.setJournalProvider(&provider);
+    QCOMPARE(model.rowCount(), 2);
+    QSignalSpy progressSpy(&model, &JournaldViewModel::exportProgress);
+
+    // plain text
+    QCOMPARE(model.exportRowsToText(1, 0),
+             QLatin1String("16:01:01.416 UTC  AccountsService-DEBUG(+): ActUserManager: ignoring unspecified session '8' since it's not graphical: "
+                           "Success\n16:01:01.421 UTC  (root) CMD (run-parts /etc/cron.hourly)\n"));
+    QCOMPARE(model.exportRowsToText(1, -1), QLatin1String("16:01:01.421 UTC  (root) CMD (run-parts /etc/cron.hourly)\n"));
+    QCOMPARE(progressSpy.count(), 2);
+    QCOMPARE(progressSpy.last().at(0).value<qsizetype>(), 1);
+    QCOMPARE(progressSpy.last().at(1).value<qsizetype>(), 1);
+
+    // journald export format is read again with identical fields, also for binary data
+    for (const QString &path : {QString(JOURNAL_EXPORT_FORMAT_EXAMPLE), QString(JOURNAL_EXPORT_FORMAT_BINARY_EXAMPLE)}) {
+        ExportJournal exportProvider(path);
+        model.setJournalProvider(&exportProvider);
+        QBuffer exported;
+        QVERIFY(exported.open(QIODevice::WriteOnly));
+        QCOMPARE(model.exportJournal(&exported, JournaldViewModel::JOURNAL_EXPORT), model.rowCount());
+        exported.close();
+
+        QFile original(path);
+        JournaldExportReader originalReader(&original);
+        JournaldExportReader exportedReader(&exported);
+        while (originalReader.readNext()) {
+            QVERIFY(exportedReader.readNext());
+            QCOMPARE(exportedReader.entry(), originalReader.entry());
+        }
+        QVERIFY(exportedReader.atEnd());
+    }
+
+    // JSON lines
+    model.setJournalProvider(&provider);
+    QBuffer json;
+    QVERIFY(json.open(QIODevice::WriteOnly));
+    QCOMPARE(model.exportRows(&json, 0, -1, JournaldViewModel::JSON_LINES), 2);
+    const QList<QByteArray> lines = json.data().split('\n');
+    QCOMPARE(lines.size(), 3);
+    QVERIFY(lines.last().isEmpty());
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(lines.at(1), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QCOMPARE(document.object().value(QLatin1String("MESSAGE")).toString(), QLatin1String("(root) CMD (run-parts /etc/cron.hourly)"));
+    QCOMPARE(document.object().value(QLatin1String("__REALTIME_TIMESTAMP")).toString(), QLatin1String("1342540861421465"));
+
+    // writing to a device that is not writable fails
+    QBuffer readOnly;
+    QVERIFY(readOnly.open(QIODevice::ReadOnly));
+    QCOMPARE(model.exportJournal(&readOnly, JournaldViewModel::PLAIN_TEXT), -1);
+}
+
+QTEST_GUILESS_MAIN(TestExportJournal);
+
+#include "moc_test_exportjournal.cpp"
@@ -0,0 +1,37 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef TEST_EXPORTJOURNAL_H
+#define TEST_EXPORTJOURNAL_H
+
+#include <QObject>
+
+class TestExportJournal : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void indexAccess();
+    /**
+     * Filters on the index select the same entries as the journald matches of JournaldViewModel
+     */
+    void filterSemantics();
+    void uniqueCounts();
+    /**
+     * Index built by parallel parsing is identical to the sequentially built index
+     */
+    void parallelIndex();
+    void viewModelAccess();
+    /**
+     * Models stay empty until the background indexing finished
+     */
+    void backgroundIndex();
+    void bootModelAccess();
+    /**
+     * Filtered journal is written in all export formats, export format output can be read again
+     */
+    void exportFormats();
+};
+#endif
@@ -8,18 +8,29 @@
 #include "../containertesthelper.h"
 #include "../testdatalocation.h"
 #include "filtercriteriamodel.h"
+#include "flattenedfiltercriteriaproxymodel.h"
+#include "uniquevaluescache.h"
 #include <QAbstractItemModelTester>
 #include <QDebug>
 #include <QDir>
+#include <QSignalSpy>
+#include <QStandardPaths>
 #include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QTest>
 #include <QVector>
+#include <algorithm>
 
 // note: this test request several data from a real example journald database
 //       you can check them by using "journalctl -D journal" and requesting the values
 //       that are checked here
 
+void TestFilterCriteriaModel::initTestCase()
+{
+    // avoid that persistent unique value caches are shared with the user's cache
+    QStandardPaths::setTestModeEnabled(true);
+}
+
 void TestFilterCriteriaModel::basicTreeModelStructure()
 {
     FilterCriteriaModel model;
@@ -62,6 +73,7 @@ void TestFilterCriteriaModel::standaloneTestSystemdUnitSelectionOptionsUngrouped
     auto provider = LocalJournal(JOURNAL_LOCATION);
     model.setJournalProvider(&provider);
     QVERIFY(model.rowCount() > 0);
+    QTRY_VERIFY(!model.isLoading());
     QVERIFY(model.entries(FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT).count() > 0);
 
     {
@@ -97,6 +109,7 @@ void TestFilterCriteriaModel::standaloneTestSystemdUnitSelectionOptionsGrouped()
     auto provider = LocalJournal(JOURNAL_LOCATION);
     model.setJournalProvider(&provider);
     QVERIFY(model.rowCount() > 0);
+    QTRY_VERIFY(!model.isLoading());
     QVERIFY(model.entries(FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT).count() > 0);
 
     {
@@ -119,6 +132,20 @@ void TestFilterCriteriaModel::standaloneTestSystemdUnitSelectionOptionsGrouped()
         // value from first position
         QCOMPARE(model.data(model.index(0, 0, categoryIndex), FilterCriteriaModel::Roles::TEXT).toString(), "busybox-klogd.service");
     }
+
+    { // grouped entries are expanded to their instances in filter
+        QSignalSpy filterSpy(&model, &FilterCriteriaModel::systemdSystemUnitFilterChanged);
+        QCOMPARE(model.selectMatching(FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT, QStringLiteral("user@*")), 1);
+        QCOMPARE(filterSpy.count(), 1);
+        const QStringList filter = model.systemdSystemUnitFilter();
+        QVERIFY(filter.contains(QStringLiteral("user@1000.service")));
+        QVERIFY(std::all_of(filter.cbegin(), filter.cend(), [](const QString &unit) {
+            return unit.startsWith(QLatin1String("user@"));
+        }));
+        QCOMPARE(model.systemdSystemUnitFilter(), filter); // cached result
+        model.selectNone(FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT);
+        QVERIFY(model.systemdSystemUnitFilter().isEmpty());
+    }
 }
 
 void TestFilterCriteriaModel::standaloneTestExeSelectionOptions()
@@ -131,6 +158,7 @@ void TestFilterCriteriaModel::standaloneTestExeSelectionOptions()
     auto provider = LocalJournal(JOURNAL_LOCATION);
     model.setJournalProvider(&provider);
     QVERIFY(model.rowCount() > 0);
+    QTRY_VERIFY(!model.isLoading());
     QVERIFY(model.entries(FilterCriteriaModel::Category::EXE).count() > 0);
 
     {
@@ -157,6 +185,243 @@ void TestFilterCriteriaModel::standaloneTestExeSelectionOptions()
     }
 }
 
+void TestFilterCriteriaModel::asynchronousRebuild()
+{
+    FilterCriteriaModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::Fatal);
+    auto provider = LocalJournal(JOURNAL_LOCATION);
+    model.setJournalProvider(&provider);
+    model.componentComplete();
+
+    QSignalSpy loadingSpy(&model, &FilterCriteriaModel::loadingChanged);
+    model.setBootFilter(mBoots.at(1));
+    // superseded before query could finish
+    model.setBootFilter(mBoots.at(0));
+    QVERIFY(model.isLoading());
+
+    // transport and priority are available while units and processes are loaded
+    QVERIFY(model.entries(FilterCriteriaModel::Category::TRANSPORT).count() > 0);
+    QVERIFY(model.entries(FilterCriteriaModel::Category::PRIORITY).count() > 0);
+
+    QTRY_VERIFY(!model.isLoading());
+    QVERIFY(loadingSpy.count() >= 2);
+    const auto entries = model.entries(FilterCriteriaModel::Category::EXE);
+    QVERIFY(std::any_of(entries.cbegin(), entries.cend(), [=](std::pair<QString, bool> value) {
+        return value.first == "/lib/systemd/systemd"; // arbitrary process from test journal
+    }));
+
+    // second selection is served from in-memory cache synchronously
+    model.setBootFilter(mBoots.at(2));
+    QTRY_VERIFY(!model.isLoading());
+    model.setBootFilter(mBoots.at(0));
+    QVERIFY(!model.isLoading());
+    QVERIFY(model.entries(FilterCriteriaModel::Category::EXE).count() > 0);
+}
+
+void TestFilterCriteriaModel::bulkSelection()
+{
+    FilterCriteriaModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::Fatal);
+    model.setBootFilter(mBoots.at(0));
+    model.setGroupTemplatedSystemdUnits(false);
+    auto provider = LocalJournal(JOURNAL_LOCATION);
+    model.setJournalProvider(&provider);
+    QTRY_VERIFY(!model.isLoading());
+
+    QModelIndex categoryIndex;
+    for (int i = 0; i < model.rowCount(); ++i) {
+        if (model.data(model.index(i, 0), FilterCriteriaModel::Roles::CATEGORY) == FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT) {
+            categoryIndex = model.index(i, 0);
+            break;
+        }
+    }
+    QVERIFY(categoryIndex.isValid());
+    const int unitCount = model.rowCount(categoryIndex);
+    QVERIFY(unitCount > 1);
+
+    QSignalSpy filterSpy(&model, &FilterCriteriaModel::systemdSystemUnitFilterChanged);
+    QSignalSpy dataChangedSpy(&model, &FilterCriteriaModel::dataChanged);
+
+    const int matched = model.selectMatching(FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT, QStringLiteral("user@*"));
+    QVERIFY(matched > 0);
+    QCOMPARE(filterSpy.count(), 1);
+    QCOMPARE(model.systemdSystemUnitFilter().size(), matched);
+    QVERIFY(model.systemdSystemUnitFilter().contains(QStringLiteral("user@1000.service")));
+    QCOMPARE(model.data(categoryIndex, FilterCriteriaModel::Roles::SELECTED).toBool(), true);
+
+    filterSpy.clear();
+    dataChangedSpy.clear();
+    model.invertSelection(FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT);
+    QCOMPARE(filterSpy.count(), 1);
+    QCOMPARE(dataChangedSpy.count(), 1); // parent stays selected
+    QCOMPARE(model.systemdSystemUnitFilter().size(), unitCount - matched);
+    QVERIFY(!model.systemdSystemUnitFilter().contains(QStringLiteral("user@1000.service")));
+
+    filterSpy.clear();
+    model.selectAll(FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT);
+    QCOMPARE(filterSpy.count(), 1);
+    QCOMPARE(model.systemdSystemUnitFilter().size(), unitCount);
+
+    filterSpy.clear();
+    model.selectNone(FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT);
+    QCOMPARE(filterSpy.count(), 1);
+    QVERIFY(model.systemdSystemUnitFilter().isEmpty());
+    QCOMPARE(model.data(categoryIndex, FilterCriteriaModel::Roles::SELECTED).toBool(), false);
+
+    // no change, no signal
+    filterSpy.clear();
+    model.selectNone(FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT);
+    QCOMPARE(filterSpy.count(), 0);
+
+    // single selections keep parent state from selected children counter
+    QVERIFY(model.setData(model.index(0, 0, categoryIndex), true, FilterCriteriaModel::Roles::SELECTED));
+    QVERIFY(model.setData(model.index(1, 0, categoryIndex), true, FilterCriteriaModel::Roles::SELECTED));
+    QVERIFY(model.setData(model.index(0, 0, categoryIndex), false, FilterCriteriaModel::Roles::SELECTED));
+    QCOMPARE(model.data(categoryIndex, FilterCriteriaModel::Roles::SELECTED).toBool(), true);
+    QVERIFY(model.setData(model.index(1, 0, categoryIndex), false, FilterCriteriaModel::Roles::SELECTED));
+    QCOMPARE(model.data(categoryIndex, FilterCriteriaModel::Roles::SELECTED).toBool(), false);
+}
+
+void TestFilterCriteriaModel::flattenedProxyModel()
+{
+    FilterCriteriaModel model;
+    model.setBootFilter(mBoots.at(0));
+    model.setGroupTemplatedSystemdUnits(false);
+    FlattenedFilterCriteriaProxyModel proxy;
+    QAbstractItemModelTester tester(&proxy, QAbstractItemModelTester::FailureReportingMode::Fatal);
+    proxy.setSourceModel(&model);
+    auto provider = LocalJournal(JOURNAL_LOCATION);
+    model.setJournalProvider(&provider);
+    QTRY_VERIFY(!model.isLoading());
+    QCOMPARE(proxy.rowCount(), model.rowCount());
+
+    int exeRow{-1};
+    for (int i = 0; i < proxy.rowCount(); ++i) {
+        if (model.data(model.index(i, 0), FilterCriteriaModel::Roles::CATEGORY) == FilterCriteriaModel::Category::EXE) {
+            exeRow = i;
+            break;
+        }
+    }
+    QVERIFY(exeRow >= 0);
+    const QModelIndex exeCategory = model.index(exeRow, 0);
+    const int exeCount = model.rowCount(exeCategory);
+    QVERIFY(exeCount > 1);
+
+    // expanding only inserts the children of the category
+    QSignalSpy insertSpy(&proxy, &FlattenedFilterCriteriaProxyModel::rowsInserted);
+    QSignalSpy resetSpy(&proxy, &FlattenedFilterCriteriaProxyModel::modelReset);
+    QVERIFY(proxy.setData(proxy.index(exeRow, 0), true, FlattenedFilterCriteriaProxyModel::Roles::EXPANDED));
+    QCOMPARE(insertSpy.count(), 1);
+    QCOMPARE(insertSpy.at(0).at(1).toInt(), exeRow + 1);
+    QCOMPARE(insertSpy.at(0).at(2).toInt(), exeRow + exeCount);
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(proxy.rowCount(), model.rowCount() + exeCount);
+    QCOMPARE(proxy.data(proxy.index(exeRow + 2, 0), FlattenedFilterCriteriaProxyModel::Roles::TEXT),
+             model.data(model.index(1, 0, exeCategory), FilterCriteriaModel::Roles::TEXT));
+    QCOMPARE(proxy.data(proxy.index(exeRow + 2, 0), FlattenedFilterCriteriaProxyModel::Roles::INDENTATION).toInt(), 1);
+    QCOMPARE(proxy.data(proxy.index(exeRow + exeCount + 1, 0), FlattenedFilterCriteriaProxyModel::Roles::INDENTATION).toInt(), 0);
+
+    // source changes are forwarded to exactly the mapped proxy row
+    QSignalSpy dataChangedSpy(&proxy, &FlattenedFilterCriteriaProxyModel::dataChanged);
+    QVERIFY(model.setData(model.index(1, 0, exeCategory), true, FilterCriteriaModel::Roles::SELECTED));
+    QVERIFY(std::any_of(dataChangedSpy.cbegin(), dataChangedSpy.cend(), [exeRow](const QList<QVariant> &arguments) {
+        return arguments.at(0).value<QModelIndex>().row() == exeRow + 2;
+    }));
+    QCOMPARE(proxy.data(proxy.index(exeRow + 2, 0), FlattenedFilterCriteriaProxyModel::Roles::SELECTED).toBool(), true);
+
+    // collapsing only removes the children of the category
+    QSignalSpy removeSpy(&proxy, &FlattenedFilterCriteriaProxyModel::rowsRemoved);
+    QVERIFY(proxy.setData(proxy.index(exeRow, 0), false, FlattenedFilterCriteriaProxyModel::Roles::EXPANDED));
+    QCOMPARE(removeSpy.count(), 1);
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(proxy.rowCount(), model.rowCount());
+
+    // changes of collapsed children are not forwarded
+    dataChangedSpy.clear();
+    QVERIFY(model.setData(model.index(1, 0, exeCategory), false, FilterCriteriaModel::Roles::SELECTED));
+    for (const auto &arguments : std::as_const(dataChangedSpy)) {
+        QCOMPARE(arguments.at(0).value<QModelIndex>().row(), exeRow);
+    }
+}
+
+void TestFilterCriteriaModel::entryCounts()
+{
+    FilterCriteriaModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::Fatal);
+    model.setBootFilter(mBoots.at(0));
+    auto provider = LocalJournal(JOURNAL_LOCATION);
+    model.setJournalProvider(&provider);
+    QTRY_VERIFY(!model.isLoading());
+
+    auto categoryIndex = [&model](FilterCriteriaModel::Category category) {
+        for (int i = 0; i < model.rowCount(); ++i) {
+            if (model.data(model.index(i, 0), FilterCriteriaModel::Roles::CATEGORY) == category) {
+                return model.index(i, 0);
+            }
+        }
+        return QModelIndex();
+    };
+
+    // every listed process has at least one entry
+    const QModelIndex exeIndex = categoryIndex(FilterCriteriaModel::Category::EXE);
+    QVERIFY(model.rowCount(exeIndex) > 0);
+    for (int i = 0; i < model.rowCount(exeIndex); ++i) {
+        const QVariant count = model.data(model.index(i, 0, exeIndex), FilterCriteriaModel::Roles::COUNT);
+        QVERIFY(count.isValid());
+        QVERIFY(count.toLongLong() > 0);
+    }
+
+    // "no filter" priority option counts all entries with a priority
+    const QModelIndex priorityIndex = categoryIndex(FilterCriteriaModel::Category::PRIORITY);
+    const int priorityRows = model.rowCount(priorityIndex);
+    qint64 prioritySum{0};
+    for (int i = 0; i < priorityRows - 1; ++i) {
+        prioritySum += model.data(model.index(i, 0, priorityIndex), FilterCriteriaModel::Roles::COUNT).toLongLong();
+    }
+    QVERIFY(prioritySum > 0);
+    QCOMPARE(model.data(model.index(priorityRows - 1, 0, priorityIndex), FilterCriteriaModel::Roles::COUNT).toLongLong(), prioritySum);
+
+    // cached boots provide the same counts synchronously
+    const QVariant firstExeCount = model.data(model.index(0, 0, exeIndex), FilterCriteriaModel::Roles::COUNT);
+    model.setBootFilter(mBoots.at(1));
+    QTRY_VERIFY(!model.isLoading());
+    model.setBootFilter(mBoots.at(0));
+    QVERIFY(!model.isLoading());
+    QCOMPARE(model.data(model.index(0, 0, categoryIndex(FilterCriteriaModel::Category::EXE)), FilterCriteriaModel::Roles::COUNT), firstExeCount);
+}
+
+void TestFilterCriteriaModel::valuesBeforeCounts()
+{
+    // persistent cache would provide values and counts at once
+    QDir(UniqueValuesCache::cacheDirectory()).removeRecursively();
+
+    FilterCriteriaModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::Fatal);
+    auto provider = LocalJournal(JOURNAL_LOCATION);
+    model.setJournalProvider(&provider);
+    model.componentComplete();
+
+    bool valuesWithoutCounts{false};
+    int countChanges{0};
+    connect(&model, &QAbstractItemModel::rowsInserted, this, [&](const QModelIndex &parent, int first) {
+        if (parent.isValid() && !model.data(model.index(first, 0, parent), FilterCriteriaModel::Roles::COUNT).isValid()) {
+            valuesWithoutCounts = true;
+        }
+    });
+    connect(&model, &QAbstractItemModel::dataChanged, this, [&](const QModelIndex &, const QModelIndex &, const QList<int> &roles) {
+        if (roles.contains(FilterCriteriaModel::Roles::COUNT)) {
+            ++countChanges;
+        }
+    });
+    model.setBootFilter(mBoots.at(2));
+    QTRY_VERIFY(!model.isLoading());
+    QVERIFY(valuesWithoutCounts);
+    QVERIFY(countChanges > 0);
+
+    const auto exes = model.entries(FilterCriteriaModel::Category::EXE);
+    QVERIFY(!exes.isEmpty());
+}
+
 void TestFilterCriteriaModel::standaloneTestPrioritySelectionOptions()
 {
     FilterCriteriaModel model;
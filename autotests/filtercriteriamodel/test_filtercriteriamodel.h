@@ -13,6 +13,8 @@ class TestFilterCriteriaModel : public QObject
     Q_OBJECT
 
 private Q_SLOTS:
+    void initTestCase();
+
     /**
      * @brief Test basic assumptions about this model when loading a journal
      */
@@ -24,6 +26,28 @@ private Q_SLOTS:
     void standaloneTestExeSelectionOptions();
     void standaloneTestPrioritySelectionOptions();
 
+    /**
+     * @brief Test that units and processes are inserted after background query and superseded queries are dropped
+     */
+    void asynchronousRebuild();
+
+    /**
+     * @brief Test bulk selection operations and their signal emissions
+     */
+    void bulkSelection();
+    /**
+     * Check incremental expand/collapse and data forwarding of the flattened proxy model
+     */
+    void flattenedProxyModel();
+    /**
+     * Check entry counts of filter options for freshly queried and cached boots
+     */
+    void entryCounts();
+    /**
+     * Unique values are shown before the entries of the boot are counted
+     */
+    void valuesBeforeCounts();
+
 private:
     const QStringList mBoots{"68f2e61d061247d8a8ba0b8d53a97a52", "27acae2fe35a40ac93f9c7732c0b8e59", "2dbe99dd855049af8f2865c5da2b8fda"};
 };
@@ -6,6 +6,7 @@
 #include "test_journaldhelper.h"
 #include "../testdatalocation.h"
 #include "journaldhelper.h"
+#include "localjournal.h"
 #include "sdjournal.h"
 #include <QDebug>
 #include <QFile>
@@ -46,6 +47,79 @@ void TestJournaldHelper::queryUniquePerBoot()
     }
 }
 
+void TestJournaldHelper::queryUniqueMatchesScan()
+{
+    SdJournal journal{JOURNAL_LOCATION};
+    QVERIFY(journal.isValid());
+
+    const QList<JournaldHelper::Field> fields{JournaldHelper::Field::_SYSTEMD_UNIT, JournaldHelper::Field::_SYSTEMD_USER_UNIT, JournaldHelper::Field::_EXE};
+    const QList<QString> bootIds = JournaldHelper::queryUnique(journal.get(), JournaldHelper::Field::_BOOT_ID);
+    QVERIFY(bootIds.size() > 0);
+    for (const QString &bootId : bootIds) {
+        auto fast = JournaldHelper::queryUnique(journal.get(), bootId, fields);
+        auto scan = JournaldHelper::queryUniqueByScan(journal.get(), bootId, fields);
+        auto counts = JournaldHelper::queryUniqueCounts(journal.get(), bootId, fields);
+        for (const auto field : fields) {
+            QStringList fastValues = fast.value(field);
+            QStringList scanValues = scan.value(field);
+            QStringList countedValues = counts.value(field).keys();
+            fastValues.sort();
+            scanValues.sort();
+            countedValues.sort();
+            QCOMPARE(fastValues, scanValues);
+            QCOMPARE(countedValues, scanValues);
+            for (const quint64 count : counts.value(field)) {
+                QVERIFY(count > 0);
+            }
+        }
+    }
+}
+
+void TestJournaldHelper::queryUniqueCountsIncremental()
+{
+    SdJournal journal{JOURNAL_LOCATION};
+    QVERIFY(journal.isValid());
+    const QString bootId = JournaldHelper::queryUnique(journal.get(), JournaldHelper::Field::_BOOT_ID).first();
+    // every entry of the boot has exactly one boot ID, thus its count is the number of counted entries
+    const QList<JournaldHelper::Field> fields{JournaldHelper::Field::_BOOT_ID, JournaldHelper::Field::_EXE};
+
+    QString lastCursor;
+    const auto fullCounts = JournaldHelper::queryUniqueCounts(journal.get(), bootId, fields, QString(), &lastCursor);
+    const quint64 entries = fullCounts.value(JournaldHelper::Field::_BOOT_ID).value(bootId);
+    QVERIFY(entries > 100);
+    QVERIFY(!lastCursor.isEmpty());
+
+    // cursor of 100th entry of the boot
+    QString midCursor;
+    {
+        sd_journal_flush_matches(journal.get());
+        const QByteArray match = QString("_BOOT_ID=" + bootId).toUtf8();
+        QCOMPARE(sd_journal_add_match(journal.get(), match.constData(), match.size()), 0);
+        QCOMPARE(sd_journal_seek_head(journal.get()), 0);
+        for (int i = 0; i < 100; ++i) {
+            QCOMPARE(sd_journal_next(journal.get()), 1);
+        }
+        char *cursor{nullptr};
+        QCOMPARE(sd_journal_get_cursor(journal.get(), &cursor), 0);
+        midCursor = QString::fromUtf8(cursor);
+        free(cursor);
+    }
+
+    QString incrementalCursor;
+    const auto incrementalCounts = JournaldHelper::queryUniqueCounts(journal.get(), bootId, fields, midCursor, &incrementalCursor);
+    QCOMPARE(incrementalCounts.value(JournaldHelper::Field::_BOOT_ID).value(bootId), entries - 100);
+    QCOMPARE(incrementalCursor, lastCursor);
+    for (auto iter = incrementalCounts.value(JournaldHelper::Field::_EXE).cbegin(); iter != incrementalCounts.value(JournaldHelper::Field::_EXE).cend(); ++iter) {
+        QVERIFY(iter.value() <= fullCounts.value(JournaldHelper::Field::_EXE).value(iter.key()));
+    }
+
+    // nothing to count after the last entry, cursor is kept
+    QString unchangedCursor;
+    const auto emptyCounts = JournaldHelper::queryUniqueCounts(journal.get(), bootId, fields, lastCursor, &unchangedCursor);
+    QCOMPARE(emptyCounts.value(JournaldHelper::Field::_BOOT_ID).value(bootId), quint64(0));
+    QCOMPARE(unchangedCursor, lastCursor);
+}
+
 void TestJournaldHelper::cleanupString()
 {
     QStringList rawInput;
@@ -77,6 +151,87 @@ void TestJournaldHelper::cleanupString()
     }
 }
 
+void TestJournaldHelper::normalizeUnit()
+{
+    {
+        const auto unit = JournaldHelper::normalizeUnit(u"user@1000.service");
+        QCOMPARE(unit.mName, QStringLiteral("user@1000.service"));
+        QCOMPARE(unit.mTemplate, QStringLiteral("user@.service"));
+        QCOMPARE(unit.mInstance, QStringLiteral("1000"));
+        QVERIFY(unit.isTemplateInstance());
+    }
+    { // escaped template argument is cleaned
+        const auto unit = JournaldHelper::normalizeUnit(u"systemd-fsck@dev-disk-by\\x2duuid-1234.service");
+        QCOMPARE(unit.mName, QStringLiteral("systemd-fsck@dev-disk-by-uuid-1234.service"));
+        QCOMPARE(unit.mTemplate, QStringLiteral("systemd-fsck@.service"));
+        QCOMPARE(unit.mInstance, QStringLiteral("dev-disk-by-uuid-1234"));
+    }
+    { // plain units and templates without instance
+        for (const QString &name : {QStringLiteral("dbus.service"), QStringLiteral("getty@.service"), QStringLiteral("user@1000.slice")}) {
+            const auto unit = JournaldHelper::normalizeUnit(name);
+            QCOMPARE(unit.mName, name);
+            QCOMPARE(unit.mTemplate, name);
+            QVERIFY(!unit.isTemplateInstance());
+        }
+    }
+    { // cache returns same results for raw UTF-8 and string input
+        UnitNameCache cache;
+        const auto first = cache.normalize(QByteArrayView("user@1000.service"));
+        const auto second = cache.normalize(QStringLiteral("user@1000.service"));
+        QCOMPARE(first.mTemplate, second.mTemplate);
+        QCOMPARE(first.mInstance, second.mInstance);
+    }
+}
+
+void TestJournaldHelper::parseCursor()
+{
+    const QString cursorString{
+        "s=739ad463348b4ceca5a9e69c95a3c93f;i=4ece7;b=6c7c6013a26343b29e964691ff25d04c;m=4fc72436e;t=4c508a72423d9;x=d3e5610681098c10;p=system.journal"};
+    const auto cursor = JournaldHelper::parseCursor(cursorString);
+    QVERIFY(cursor.has_value());
+    QCOMPARE(cursor->mSeqnumId, "739ad463348b4ceca5a9e69c95a3c93f");
+    QCOMPARE(cursor->mSeqnum, 0x4ece7);
+    QCOMPARE(cursor->mBootId, "6c7c6013a26343b29e964691ff25d04c");
+    QCOMPARE(cursor->mMonotonicUsec, 21415215982); // see __MONOTONIC_TIMESTAMP in export example
+    QCOMPARE(cursor->mRealtimeUsec, 1342540861416409); // see __REALTIME_TIMESTAMP in export example
+    QCOMPARE(cursor->mXorHash, 0xd3e5610681098c10);
+    QVERIFY(cursor->isSameEntry(cursor.value()));
+
+    // same entry found in a different file with different seqnum domain
+    auto otherFileCursor = JournaldHelper::parseCursor(QStringLiteral("s=0000;i=1;b=6c7c6013a26343b29e964691ff25d04c;m=4fc72436e;t=4c508a72423d9;x=d3e5610681098c10"));
+    QVERIFY(otherFileCursor.has_value());
+    QVERIFY(cursor->isSameEntry(otherFileCursor.value()));
+
+    // successor entry
+    auto nextCursor = JournaldHelper::parseCursor(QStringLiteral("s=739ad463348b4ceca5a9e69c95a3c93f;i=4ece8;b=6c7c6013a26343b29e964691ff25d04c;m=4fc72436f;t=4c508a72423da"));
+    QVERIFY(nextCursor.has_value());
+    QVERIFY(!cursor->isSameEntry(nextCursor.value()));
+
+    QVERIFY(!JournaldHelper::parseCursor(QStringLiteral("not a cursor")).has_value());
+}
+
+void TestJournaldHelper::queryOrderedBootIdsFromProvider()
+{
+    LocalJournal provider{JOURNAL_LOCATION};
+    QVERIFY(!JournaldHelper::journalFilesFingerprint(provider.journalFiles()).isEmpty());
+
+    SdJournal journal{JOURNAL_LOCATION};
+    QVERIFY(journal.isValid());
+    const auto serialBoots = JournaldHelper::queryOrderedBootIds(journal.get());
+    QVERIFY(serialBoots.size() > 0);
+
+    // first call computes in parallel, second call is served from cache
+    for (int run = 0; run < 2; ++run) {
+        const auto boots = JournaldHelper::queryOrderedBootIds(&provider);
+        QCOMPARE(boots.size(), serialBoots.size());
+        for (qsizetype i = 0; i < boots.size(); ++i) {
+            QCOMPARE(boots.at(i).mBootId, serialBoots.at(i).mBootId);
+            QCOMPARE(boots.at(i).mSince, serialBoots.at(i).mSince);
+            QCOMPARE(boots.at(i).mUntil, serialBoots.at(i).mUntil);
+        }
+    }
+}
+
 QTEST_GUILESS_MAIN(TestJournaldHelper);
 
 #include "moc_test_journaldhelper.cpp"
@@ -13,5 +13,10 @@ class TestJournaldHelper : public QObject
 
 private Q_SLOTS:
     void queryUniquePerBoot();
+    void queryUniqueMatchesScan();
+    void queryUniqueCountsIncremental();
     void cleanupString();
+    void normalizeUnit();
+    void parseCursor();
+    void queryOrderedBootIdsFromProvider();
 };
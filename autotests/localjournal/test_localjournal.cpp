@@ -11,7 +11,11 @@
 #include <QTemporaryFile>
 #include <QTest>
 #include <QVector>
+#include <journaldhelper.h>
+#include <journaldviewmodel.h>
 #include <localjournal.h>
+#include <multijournal.h>
+#include <sdjournal.h>
 
 // note: this test request several data from a real example journald database
 //       you can check them by using "journalctl -D journal" and requesting the values
@@ -24,6 +28,37 @@ void TestLocalJournal::journalAccess()
     QCOMPARE(journal.usage(), 12845056);
 }
 
+void TestLocalJournal::mergedJournalAccess()
+{
+    LocalJournal localJournal(JOURNAL_LOCATION);
+    const QFileInfoList localFiles = localJournal.journalFiles();
+    QVERIFY(localFiles.size() > 1);
+
+    // file that is also part of the directory must only be opened once
+    MultiJournal journal({JOURNAL_LOCATION, localFiles.first().absoluteFilePath()});
+    QCOMPARE(journal.journalFiles().size(), localFiles.size());
+    QVERIFY(journal.currentBootId().isEmpty());
+    QVERIFY(journal.openJournal()->isValid());
+
+    const auto boots = JournaldHelper::queryOrderedBootIds(&journal);
+    QCOMPARE(boots.size(), mBoots.size());
+    for (const auto &boot : boots) {
+        QVERIFY(mBoots.contains(boot.mBootId));
+    }
+
+    JournaldViewModel model;
+    model.setJournalProvider(&journal);
+    QVERIFY(model.rowCount() > 0);
+    QVERIFY(!model.data(model.index(0, 0), JournaldViewModel::SOURCE).toString().isEmpty());
+
+    // sources are only read for merged journals
+    QVERIFY(journal.hasMultipleSources());
+    QVERIFY(!localJournal.hasMultipleSources());
+    model.setJournalProvider(&localJournal);
+    QVERIFY(model.rowCount() > 0);
+    QVERIFY(model.data(model.index(0, 0), JournaldViewModel::SOURCE).toString().isEmpty());
+}
+
 QTEST_GUILESS_MAIN(TestLocalJournal);
 
 #include "moc_test_localjournal.cpp"
@@ -14,6 +14,7 @@ class TestLocalJournal : public QObject
 
 private Q_SLOTS:
     void journalAccess();
+    void mergedJournalAccess();
 
 private:
     const QStringList mBoots{"68f2e61d061247d8a8ba0b8d53a97a52", "27acae2fe35a40ac93f9c7732c0b8e59", "2dbe99dd855049af8f2865c5da2b8fda"};
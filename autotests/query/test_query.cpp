@@ -0,0 +1,142 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "test_query.h"
+#include "../testdatalocation.h"
+#include "journaldhelper.h"
+#include "journaldviewmodel.h"
+#include "localjournal.h"
+#include "sdjournal.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QTest>
+#include <algorithm>
+
+namespace
+{
+/**
+ * run kjournaldquery on the test journal with @p arguments
+ * @return exit code and standard output of the process
+ */
+std::pair<int, QByteArray> runQuery(const QStringList &arguments)
+{
+    QProcess process;
+    process.setProgram(QStringLiteral(KJOURNALDQUERY_EXECUTABLE));
+    process.setArguments(QStringList{QStringLiteral("-D"), JOURNAL_LOCATION} + arguments);
+    process.start();
+    if (!process.waitForFinished(30000) || process.exitStatus() != QProcess::NormalExit) {
+        qWarning() << "kjournaldquery did not finish" << process.errorString();
+        return {-1, QByteArray()};
+    }
+    return {process.exitCode(), process.readAllStandardOutput()};
+}
+
+QList<QByteArray> outputLines(const QByteArray &output)
+{
+    QList<QByteArray> lines = output.split('\n');
+    if (!lines.isEmpty() && lines.constLast().isEmpty()) {
+        lines.removeLast();
+    }
+    return lines;
+}
+}
+
+void TestQuery::entries()
+{
+    const QString bootId = QStringLiteral("68f2e61d061247d8a8ba0b8d53a97a52");
+    const auto [exitCode, output] = runQuery({QStringLiteral("entries"), QStringLiteral("-o"), QStringLiteral("json"), QStringLiteral("-b"), bootId});
+    QCOMPARE(exitCode, 0);
+
+    // same entries as loaded by the view model with same filter
+    JournaldViewModel model;
+    LocalJournal provider(JOURNAL_LOCATION);
+    Filter filter;
+    filter.setBootFilter({bootId});
+    model.setFilter(filter);
+    model.setJournalProvider(&provider);
+    while (model.canFetchMore(QModelIndex())) {
+        model.fetchMore(QModelIndex());
+    }
+
+    const QList<QByteArray> lines = outputLines(output);
+    QVERIFY(lines.size() > 0);
+    QCOMPARE(lines.size(), model.rowCount());
+    for (const QByteArray &line : lines) {
+        QJsonParseError error;
+        const QJsonObject entry = QJsonDocument::fromJson(line, &error).object();
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        QCOMPARE(entry.value(QLatin1String("_BOOT_ID")).toString(), bootId);
+    }
+}
+
+void TestQuery::uniqueValues()
+{
+    const QString bootId = QStringLiteral("68f2e61d061247d8a8ba0b8d53a97a52");
+    const auto [exitCode, output] = runQuery({QStringLiteral("unique"), QStringLiteral("_SYSTEMD_UNIT"), QStringLiteral("-b"), bootId});
+    QCOMPARE(exitCode, 0);
+
+    SdJournal journal{JOURNAL_LOCATION};
+    QVERIFY(journal.isValid());
+    QStringList expected = JournaldHelper::queryUnique(journal.get(), bootId, JournaldHelper::Field::_SYSTEMD_UNIT);
+    std::sort(expected.begin(), expected.end());
+    QVERIFY(expected.size() > 0);
+
+    QStringList values;
+    for (const QByteArray &line : outputLines(output)) {
+        values.append(QString::fromUtf8(line));
+    }
+    QCOMPARE(values, expected);
+
+    // counts are prepended and add up to the number of entries of the boot
+    const auto [countsExitCode, countsOutput] = runQuery({QStringLiteral("unique"), QStringLiteral("_SYSTEMD_UNIT"), QStringLiteral("--counts"), QStringLiteral("-b"), bootId});
+    QCOMPARE(countsExitCode, 0);
+    const QList<QByteArray> countLines = outputLines(countsOutput);
+    QCOMPARE(countLines.size(), expected.size());
+    for (const QByteArray &line : countLines) {
+        bool ok{false};
+        QVERIFY(line.split('\t').constFirst().toULongLong(&ok) > 0);
+        QVERIFY(ok);
+    }
+}
+
+void TestQuery::boots()
+{
+    const auto [exitCode, output] = runQuery({QStringLiteral("boots"), QStringLiteral("-o"), QStringLiteral("json")});
+    QCOMPARE(exitCode, 0);
+
+    LocalJournal provider(JOURNAL_LOCATION);
+    const auto expected = JournaldHelper::queryOrderedBootIds(&provider);
+    const QList<QByteArray> lines = outputLines(output);
+    QCOMPARE(lines.size(), 3);
+    QCOMPARE(lines.size(), expected.size());
+    for (qsizetype i = 0; i < lines.size(); ++i) {
+        const QJsonObject boot = QJsonDocument::fromJson(lines.at(i)).object();
+        QCOMPARE(boot.value(QLatin1String("_BOOT_ID")).toString(), expected.at(i).mBootId);
+        QVERIFY(!boot.value(QLatin1String("SINCE")).toString().isEmpty());
+        QVERIFY(!boot.value(QLatin1String("UNTIL")).toString().isEmpty());
+    }
+}
+
+void TestQuery::rejectUnsupportedFilters()
+{
+    const QList<QStringList> arguments{
+        {QStringLiteral("unique"), QStringLiteral("_SYSTEMD_UNIT"), QStringLiteral("-u"), QStringLiteral("systemd-networkd.service")},
+        {QStringLiteral("unique"), QStringLiteral("_EXE"), QStringLiteral("--user-unit"), QStringLiteral("plasma-kwin_wayland.service")},
+        {QStringLiteral("unique"), QStringLiteral("_SYSTEMD_UNIT"), QStringLiteral("-p"), QStringLiteral("3")},
+        {QStringLiteral("boots"), QStringLiteral("-e"), QStringLiteral("/usr/bin/kwin_wayland")},
+        {QStringLiteral("boots"), QStringLiteral("-k")},
+        {QStringLiteral("boots"), QStringLiteral("-b"), QStringLiteral("68f2e61d061247d8a8ba0b8d53a97a52")},
+    };
+    for (const QStringList &argument : arguments) {
+        const auto [exitCode, output] = runQuery(argument);
+        QCOMPARE(exitCode, 1);
+        QVERIFY(output.isEmpty());
+    }
+}
+
+QTEST_GUILESS_MAIN(TestQuery);
+
+#include "moc_test_query.cpp"
@@ -6,12 +6,19 @@
 #include "test_remotejournal.h"
 #include "../testdatalocation.h"
 #include "journaldexportreader.h"
+#include <KCompressionDevice>
+#include <QBuffer>
 #include <QDebug>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QProcess>
+#include <QSignalSpy>
+#include <QTemporaryDir>
 #include <QTest>
+#include <QtEndian>
 #include <QVector>
+#include <algorithm>
 #include <systemd/sd-journal.h>
 #include <systemdjournalremote.h>
 
@@ -122,6 +129,161 @@ void TestRemoteJournal::exportFormatReaderBinaryMessageAccess()
     QVERIFY(reader.atEnd());
 }
 
+void TestRemoteJournal::exportFormatReaderFieldViews()
+{
+    QFile exportData(JOURNAL_EXPORT_FORMAT_BINARY_EXAMPLE);
+    JournaldExportReader reader(&exportData);
+
+    QVERIFY(reader.readNext());
+    QCOMPARE(reader.value("MESSAGE"), QByteArrayView("foo\nbar"));
+    QCOMPARE(reader.value("_SELINUX_CONTEXT"), QByteArrayView("unconfined\n"));
+    QCOMPARE(reader.value("_TRANSPORT"), QByteArrayView("journal"));
+    QVERIFY(reader.value("NOT_EXISTING").isNull());
+    QCOMPARE(reader.fields().size(), reader.entry().size());
+
+    // same data is read from non-mappable devices
+    QFile file(JOURNAL_EXPORT_FORMAT_BINARY_EXAMPLE);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QBuffer buffer;
+    buffer.setData(file.readAll());
+    JournaldExportReader bufferReader(&buffer);
+    QVERIFY(bufferReader.readNext());
+    QCOMPARE(bufferReader.entry(), reader.entry());
+
+    // field names are interned
+    QFile multiEntryData(JOURNAL_EXPORT_FORMAT_EXAMPLE);
+    JournaldExportReader multiEntryReader(&multiEntryData);
+    QVERIFY(multiEntryReader.readNext());
+    const QByteArrayView firstName = multiEntryReader.fields().constFirst().name;
+    const char *firstNameData = firstName.data();
+    QVERIFY(multiEntryReader.readNext());
+    const auto &fields = multiEntryReader.fields();
+    const auto it = std::find_if(fields.cbegin(), fields.cend(), [&firstName](const JournaldExportReader::Field &field) {
+        return field.name == firstName;
+    });
+    QVERIFY(it != fields.cend());
+    QVERIFY(it->name.data() == firstNameData);
+    QVERIFY(multiEntryReader.atEnd());
+}
+
+void TestRemoteJournal::exportFormatReaderPartitions()
+{
+    QFile file(JOURNAL_EXPORT_FORMAT_BINARY_EXAMPLE);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray example = file.readAll();
+    while (example.endsWith('\n')) {
+        example.chop(1);
+    }
+    example.append("\n\n");
+
+    // binary message that contains a sequence of entries with valid structure
+    const QByteArray payload("a\n\nMESSAGE=x\n\nMESSAGE=y\n\nMESSAGE=z\n\nb");
+    QByteArray adversarial("MESSAGE\n");
+    adversarial.append(8, '\0');
+    qToLittleEndian<quint64>(payload.size(), adversarial.data() + adversarial.size() - 8);
+    adversarial.append(payload);
+    adversarial.append("\n_TRANSPORT=journal\n\n");
+
+    QByteArray data;
+    for (int i = 0; i < 100; ++i) {
+        data.append(i % 10 == 5 ? adversarial : example);
+    }
+    QBuffer buffer;
+    buffer.setData(data);
+    JournaldExportReader reader(&buffer);
+
+    QList<qsizetype> sequentialOffsets;
+    while (!reader.atEnd()) {
+        const qsizetype offset = reader.position();
+        QVERIFY(reader.readNext());
+        sequentialOffsets.append(offset);
+    }
+    QCOMPARE(sequentialOffsets.size(), 100);
+
+    for (int count = 1; count <= 32; ++count) {
+        const QList<JournaldExportReader::Partition> partitions = reader.partitions(count);
+        QVERIFY(!partitions.isEmpty());
+        QVERIFY(partitions.size() <= count);
+        QCOMPARE(partitions.constFirst().begin, 0);
+        QCOMPARE(partitions.constLast().end, data.size());
+
+        // merge in file order, parsing continues where the previous partition ended, which skips false boundaries
+        QList<qsizetype> offsets;
+        qsizetype position{0};
+        for (const auto &partition : partitions) {
+            QList<qsizetype> partitionOffsets;
+            const qsizetype end = reader.parsePartition({position, partition.end}, [&partitionOffsets](qsizetype offset, const QList<JournaldExportReader::Field> &) {
+                partitionOffsets.append(offset);
+            });
+            offsets.append(partitionOffsets);
+            position = std::max(position, end);
+        }
+        QCOMPARE(offsets, sequentialOffsets);
+    }
+}
+
+void TestRemoteJournal::exportFormatReaderCompressedStreams_data()
+{
+    QTest::addColumn<QString>("suffix");
+    QTest::addColumn<int>("type");
+    QTest::newRow("gzip") << QStringLiteral(".gz") << int(KCompressionDevice::GZip);
+    QTest::newRow("bzip2") << QStringLiteral(".bz2") << int(KCompressionDevice::BZip2);
+    QTest::newRow("xz") << QStringLiteral(".xz") << int(KCompressionDevice::Xz);
+    QTest::newRow("zstd") << QStringLiteral(".zst") << int(KCompressionDevice::Zstd);
+}
+
+void TestRemoteJournal::exportFormatReaderCompressedStreams()
+{
+    QFETCH(QString, suffix);
+    QFETCH(int, type);
+
+    QFile file(JOURNAL_EXPORT_FORMAT_BINARY_EXAMPLE);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray example = file.readAll();
+    while (example.endsWith('\n')) {
+        example.chop(1);
+    }
+    example.append("\n\n");
+    // more than one streaming chunk, such that entries and binary fields cross window boundaries
+    QByteArray data;
+    while (data.size() < 3 * 1024 * 1024) {
+        data.append(example);
+    }
+
+    QTemporaryDir dir;
+    const QString path = dir.path() + QLatin1String("/test.export") + suffix;
+    QVERIFY(JournaldExportReader::isCompressed(path));
+    {
+        KCompressionDevice compressor(path, static_cast<KCompressionDevice::CompressionType>(type));
+        if (!compressor.open(QIODevice::WriteOnly)) {
+            QSKIP("Compression type is not supported by KArchive");
+        }
+        QCOMPARE(compressor.write(data), data.size());
+    }
+    QVERIFY(QFileInfo(path).size() < data.size());
+
+    QBuffer buffer;
+    buffer.setData(data);
+    JournaldExportReader expectedReader(&buffer);
+    QVERIFY(!expectedReader.isStreaming());
+
+    std::unique_ptr<QIODevice> device = JournaldExportReader::createDevice(path);
+    JournaldExportReader reader(device.get());
+    QVERIFY(reader.isStreaming());
+    QVERIFY(!reader.seek(0));
+    QVERIFY(reader.partitions(4).isEmpty());
+    qsizetype entries{0};
+    while (expectedReader.readNext()) {
+        QVERIFY(reader.readNext());
+        QCOMPARE(reader.entry(), expectedReader.entry());
+        QCOMPARE(reader.position(), expectedReader.position());
+        ++entries;
+    }
+    QVERIFY(!reader.readNext());
+    QVERIFY(reader.atEnd());
+    QVERIFY(entries > 1000);
+}
+
 void TestRemoteJournal::systemdJournalRemoteJournalFromFile()
 {
     // out variables for reading
@@ -131,19 +293,21 @@ void TestRemoteJournal::systemdJournalRemoteJournalFromFile()
     sd_id128_t bootId;
 
     SystemdJournalRemote provider(JOURNAL_EXPORT_FORMAT_EXAMPLE);
-    auto journal = provider.openJournal();
-    QVERIFY(journal);
-
     if (!provider.isSystemdRemoteAvailable()) {
         QSKIP("Systemd remote is not correctly installed");
     }
 
-    QTRY_COMPARE_WITH_TIMEOUT(journal->isValid(), true, 5000);
+    // import is running asynchronously
+    QSignalSpy progressSpy(&provider, &SystemdJournalRemote::importProgressChanged);
+    QSignalSpy readySpy(&provider, &SystemdJournalRemote::journalReady);
+    QTRY_VERIFY_WITH_TIMEOUT(provider.isImportFinished(), 5000);
+    QCOMPARE(readySpy.count(), 1);
+    QVERIFY(progressSpy.count() > 0);
+    QCOMPARE(provider.importProgress(), 1.);
 
-    if (!provider.isSystemdRemoteAvailable()) {
-        qWarning() << "Skip further test operations due to systemd remote not being available";
-        return;
-    }
+    auto journal = provider.openJournal();
+    QVERIFY(journal);
+    QVERIFY(journal->isValid());
 
     QCOMPARE(sd_journal_seek_head(journal->get()), 0);
 
@@ -239,6 +403,40 @@ void TestRemoteJournal::systemdJournalRemoteJournalFromFile()
     }
 }
 
+void TestRemoteJournal::systemdJournalRemoteJournalFromCompressedFile()
+{
+    QFile file(JOURNAL_EXPORT_FORMAT_EXAMPLE);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QTemporaryDir dir;
+    const QString path = dir.path() + QLatin1String("/example.export.gz");
+    {
+        KCompressionDevice compressor(path, KCompressionDevice::GZip);
+        QVERIFY(compressor.open(QIODevice::WriteOnly));
+        QVERIFY(compressor.write(file.readAll()) > 0);
+    }
+
+    SystemdJournalRemote provider(path);
+    if (!provider.isSystemdRemoteAvailable()) {
+        QSKIP("Systemd remote is not correctly installed");
+    }
+    QTRY_VERIFY_WITH_TIMEOUT(provider.isImportFinished(), 5000);
+    QCOMPARE(provider.importProgress(), 1.);
+    auto journal = provider.openJournal();
+    QVERIFY(journal);
+    QVERIFY(journal->isValid());
+
+    const char *data;
+    size_t length;
+    QCOMPARE(sd_journal_seek_head(journal->get()), 0);
+    QCOMPARE(sd_journal_next(journal->get()), 1);
+    QCOMPARE(sd_journal_get_data(journal->get(), "_EXE", (const void **)&data, &length), 0);
+    QCOMPARE(QString::fromUtf8(data, length), "_EXE=/usr/libexec/gdm-session-worker");
+    QCOMPARE(sd_journal_next(journal->get()), 1);
+    QCOMPARE(sd_journal_get_data(journal->get(), "MESSAGE", (const void **)&data, &length), 0);
+    QCOMPARE(QString::fromUtf8(data, length), "MESSAGE=(root) CMD (run-parts /etc/cron.hourly)");
+    QCOMPARE(sd_journal_next(journal->get()), 0);
+}
+
 void TestRemoteJournal::systemdJournalRemoteJournalFromLocalhost()
 {
     // spawning systemd-journal-gatwayd to provide http access
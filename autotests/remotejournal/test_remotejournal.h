@@ -16,8 +16,19 @@ private Q_SLOTS:
     // parser tests
     void exportFormatReaderBasicAccess();
     void exportFormatReaderBinaryMessageAccess();
+    void exportFormatReaderFieldViews();
+    /**
+     * Entries of parallel parsed partitions are the same as of sequential parsing, also if binary fields contain empty lines
+     */
+    void exportFormatReaderPartitions();
+    /**
+     * Compressed export files are read in streaming mode with the same entries as uncompressed files
+     */
+    void exportFormatReaderCompressedStreams_data();
+    void exportFormatReaderCompressedStreams();
 
     void systemdJournalRemoteJournalFromFile();
+    void systemdJournalRemoteJournalFromCompressedFile();
     void systemdJournalRemoteJournalFromLocalhost();
 };
 #endif
@@ -0,0 +1,148 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "test_uniquevaluescache.h"
+#include "../testdatalocation.h"
+#include "localjournal.h"
+#include "sdjournal.h"
+#include "uniquevaluescache.h"
+#include <QDir>
+#include <QFile>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTest>
+
+void TestUniqueValuesCache::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    QDir(UniqueValuesCache::cacheDirectory()).removeRecursively();
+}
+
+void TestUniqueValuesCache::cleanupTestCase()
+{
+    QDir(UniqueValuesCache::cacheDirectory()).removeRecursively();
+}
+
+void TestUniqueValuesCache::storeAndLoad()
+{
+    LocalJournal provider{JOURNAL_LOCATION};
+    const QByteArray identity = UniqueValuesCache::journalIdentity(provider.journalFiles());
+    QVERIFY(!identity.isEmpty());
+
+    SdJournal journal{JOURNAL_LOCATION};
+    QVERIFY(journal.isValid());
+    const auto boot = JournaldHelper::queryBootInfo(journal.get(), QStringLiteral("2dbe99dd855049af8f2865c5da2b8fda"));
+    QVERIFY(boot.has_value());
+
+    QVERIFY(!UniqueValuesCache::load(identity, boot.value()).has_value());
+    const auto values = JournaldHelper::queryUnique(journal.get(),
+                                                    boot->mBootId,
+                                                    {JournaldHelper::Field::_SYSTEMD_UNIT, JournaldHelper::Field::_SYSTEMD_USER_UNIT, JournaldHelper::Field::_EXE});
+    QVERIFY(UniqueValuesCache::store(identity, boot.value(), values));
+
+    const auto loaded = UniqueValuesCache::load(identity, boot.value());
+    QVERIFY(loaded.has_value());
+    QCOMPARE(loaded.value(), values);
+
+    // different journal must not see the cache entry
+    QVERIFY(!UniqueValuesCache::load(QByteArrayLiteral("0000"), boot.value()).has_value());
+}
+
+void TestUniqueValuesCache::storeAndLoadCounts()
+{
+    LocalJournal provider{JOURNAL_LOCATION};
+    const QByteArray identity = UniqueValuesCache::journalIdentity(provider.journalFiles());
+    SdJournal journal{JOURNAL_LOCATION};
+    QVERIFY(journal.isValid());
+    const auto boot = JournaldHelper::queryBootInfo(journal.get(), QStringLiteral("2dbe99dd855049af8f2865c5da2b8fda"));
+    QVERIFY(boot.has_value());
+
+    const UniqueValuesCache::ValueCounts counts =
+        JournaldHelper::queryUniqueCounts(journal.get(), boot->mBootId, {JournaldHelper::Field::_EXE, JournaldHelper::Field::PRIORITY});
+    QVERIFY(!counts.value(JournaldHelper::Field::_EXE).isEmpty());
+    UniqueValuesCache::UniqueValues values;
+    values.insert(JournaldHelper::Field::_EXE, counts.value(JournaldHelper::Field::_EXE).keys());
+    values.insert(JournaldHelper::Field::PRIORITY, counts.value(JournaldHelper::Field::PRIORITY).keys());
+    QVERIFY(UniqueValuesCache::store(identity, boot.value(), values, counts));
+
+    UniqueValuesCache::ValueCounts loadedCounts;
+    const auto loaded = UniqueValuesCache::load(identity, boot.value(), &loadedCounts);
+    QVERIFY(loaded.has_value());
+    QCOMPARE(loaded.value(), values);
+    QCOMPARE(loadedCounts, counts);
+
+    // values stored without counts do not provide counts
+    QVERIFY(UniqueValuesCache::store(identity, boot.value(), values));
+    QVERIFY(UniqueValuesCache::load(identity, boot.value(), &loadedCounts).has_value());
+    QVERIFY(loadedCounts.isEmpty());
+}
+
+void TestUniqueValuesCache::rejectOutdatedBoot()
+{
+    const QByteArray identity{"outdated"};
+    JournaldHelper::BootInfo boot{QStringLiteral("68f2e61d061247d8a8ba0b8d53a97a52"),
+                                  QDateTime::fromMSecsSinceEpoch(1000),
+                                  QDateTime::fromMSecsSinceEpoch(2000)};
+    UniqueValuesCache::UniqueValues values;
+    values[JournaldHelper::Field::_EXE] = QStringList{QStringLiteral("/usr/bin/foo")};
+    QVERIFY(UniqueValuesCache::store(identity, boot, values));
+    QVERIFY(UniqueValuesCache::load(identity, boot).has_value());
+
+    // boot got new entries since cache was written
+    boot.mUntil = QDateTime::fromMSecsSinceEpoch(3000);
+    QVERIFY(!UniqueValuesCache::load(identity, boot).has_value());
+}
+
+void TestUniqueValuesCache::rejectUnsuitableEntries()
+{
+    UniqueValuesCache::UniqueValues values;
+    values[JournaldHelper::Field::_EXE] = QStringList{QStringLiteral("/usr/bin/foo")};
+
+    // boot IDs are used in file names
+    const JournaldHelper::BootInfo invalidBoot{QStringLiteral("../../68f2e61d061247d8a8ba0b8d53a9"),
+                                               QDateTime::fromMSecsSinceEpoch(1000),
+                                               QDateTime::fromMSecsSinceEpoch(2000)};
+    QVERIFY(!UniqueValuesCache::store(QByteArrayLiteral("identity"), invalidBoot, values));
+    QVERIFY(!UniqueValuesCache::load(QByteArrayLiteral("identity"), invalidBoot).has_value());
+
+    // temporary journals, e.g. of imports, are never opened again
+    QTemporaryDir temporaryJournal;
+    QVERIFY(temporaryJournal.isValid());
+    QFile journalFile(temporaryJournal.filePath(QStringLiteral("remote.journal")));
+    QVERIFY(journalFile.open(QIODevice::WriteOnly));
+    journalFile.close();
+    QVERIFY(UniqueValuesCache::journalIdentity({QFileInfo(journalFile.fileName())}).isEmpty());
+}
+
+void TestUniqueValuesCache::prune()
+{
+    QDir(UniqueValuesCache::cacheDirectory()).removeRecursively();
+    UniqueValuesCache::UniqueValues values;
+    values[JournaldHelper::Field::_EXE] = QStringList{QStringLiteral("/usr/bin/foo")};
+    const JournaldHelper::BootInfo boot{QStringLiteral("68f2e61d061247d8a8ba0b8d53a97a52"),
+                                        QDateTime::fromMSecsSinceEpoch(1000),
+                                        QDateTime::fromMSecsSinceEpoch(2000)};
+    QVERIFY(UniqueValuesCache::store(QByteArrayLiteral("old"), boot, values));
+    QVERIFY(UniqueValuesCache::store(QByteArrayLiteral("recent"), boot, values));
+    const QDir cacheDir(UniqueValuesCache::cacheDirectory());
+    QCOMPARE(cacheDir.entryList(QDir::Files).size(), 2);
+
+    // mark one file as unused for a long time
+    QFile oldFile(cacheDir.filePath(cacheDir.entryList({QStringLiteral("*_old.cache")}, QDir::Files).constFirst()));
+    QVERIFY(oldFile.open(QIODevice::ReadWrite));
+    QVERIFY(oldFile.setFileTime(QDateTime::currentDateTime().addDays(-UniqueValuesCache::MAX_AGE_DAYS - 1), QFileDevice::FileModificationTime));
+    oldFile.close();
+    UniqueValuesCache::prune();
+    QVERIFY(!UniqueValuesCache::load(QByteArrayLiteral("old"), boot).has_value());
+    QVERIFY(UniqueValuesCache::load(QByteArrayLiteral("recent"), boot).has_value());
+
+    // size limit removes everything if it is too small
+    UniqueValuesCache::prune(UniqueValuesCache::MAX_AGE_DAYS, 0);
+    QVERIFY(cacheDir.entryList(QDir::Files).isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestUniqueValuesCache);
+
+#include "moc_test_uniquevaluescache.cpp"
@@ -0,0 +1,24 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef TEST_UNIQUEVALUESCACHE_H
+#define TEST_UNIQUEVALUESCACHE_H
+
+#include <QObject>
+
+class TestUniqueValuesCache : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void storeAndLoad();
+    void rejectOutdatedBoot();
+    void storeAndLoadCounts();
+    void rejectUnsuitableEntries();
+    void prune();
+};
+#endif
@@ -4,14 +4,22 @@
 */
 
 #include "test_viewmodel.h"
+#include "../../org/kde/kjournald/colorizer.h"
 #include "../../org/kde/kjournald/journaldviewmodel.h"
+#include "../../org/kde/kjournald/journaldviewmodel_p.h"
 #include "../../org/kde/kjournald/localjournal.h"
 #include "../../org/kde/kjournald/logentry.h"
+#include "../../org/kde/kjournald/logentryhandle.h"
+#include "../../org/kde/kjournald/sdjournal.h"
 #include "../containertesthelper.h"
 #include "../testdatalocation.h"
 #include <QAbstractItemModelTester>
+#include <QBuffer>
 #include <QDebug>
 #include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSignalSpy>
 #include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QTest>
@@ -83,6 +91,21 @@ void TestViewModel::rowAccess()
         QCOMPARE(model.data(model.index(i, 0), JournaldViewModel::SYSTEMD_UNIT), expectedData.at(i).unit());
         QCOMPARE(model.data(model.index(i, 0), JournaldViewModel::BOOT_ID), expectedData.at(i).bootId());
         QCOMPARE(model.data(model.index(i, 0), JournaldViewModel::EXE), expectedData.at(i).exe());
+        // precomputed palette indices yield the same colors as key based lookup
+        QCOMPARE(model.data(model.index(i, 0), JournaldViewModel::EXE_COLOR_FOREGROUND).value<QColor>(),
+                 Colorizer::color(expectedData.at(i).exe(), Colorizer::COLOR_TYPE::FOREGROUND));
+        QCOMPARE(model.data(model.index(i, 0), JournaldViewModel::SYSTEMD_UNIT_COLOR_BACKGROUND).value<QColor>(),
+                 Colorizer::color(expectedData.at(i).unit(), Colorizer::COLOR_TYPE::BACKGROUND));
+
+        // batch access provides the same values as individual access
+        std::vector<QModelRoleData> roleData;
+        for (const int role : {JournaldViewModel::MESSAGE, JournaldViewModel::SYSTEMD_UNIT, JournaldViewModel::EXE, JournaldViewModel::PRIORITY}) {
+            roleData.emplace_back(role);
+        }
+        model.multiData(model.index(i, 0), roleData);
+        for (const QModelRoleData &data : roleData) {
+            QCOMPARE(data.data(), model.data(model.index(i, 0), data.role()));
+        }
     }
 }
 
@@ -434,4 +457,224 @@ void TestViewModel::stringSearch()
 
 QTEST_GUILESS_MAIN(TestViewModel);
 
+void TestViewModel::changedSubstrings()
+{
+    JournaldViewModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+    auto provider = LocalJournal(JOURNAL_LOCATION);
+    model.setJournalProvider(&provider);
+    Filter filter = model.filter();
+    filter.setBootFilter({mBoots.at(0)});
+    model.setFilter(filter);
+
+    // start at tail with small chunks, such that rows are prepended multiple times
+    model.setFetchMoreChunkSize(50);
+    model.seekTail();
+    for (int i = 0; i < 5; ++i) {
+        model.fetchMore(QModelIndex());
+    }
+    QVERIFY(model.rowCount() > 100);
+
+    for (int row = 0; row < model.rowCount(); ++row) {
+        QString expectedUnit = model.data(model.index(row, 0), JournaldViewModel::SYSTEMD_UNIT).toString();
+        QString expectedExe = model.data(model.index(row, 0), JournaldViewModel::EXE).toString();
+        if (row > 0) {
+            expectedUnit.remove(model.data(model.index(row - 1, 0), JournaldViewModel::SYSTEMD_UNIT).toString());
+            expectedExe.remove(model.data(model.index(row - 1, 0), JournaldViewModel::EXE).toString());
+        }
+        QCOMPARE(model.data(model.index(row, 0), JournaldViewModel::SYSTEMD_UNIT_CHANGED_SUBSTRING).toString(), expectedUnit);
+        QCOMPARE(model.data(model.index(row, 0), JournaldViewModel::EXE_CHANGED_SUBSTRING).toString(), expectedExe);
+    }
+
+    // changed substrings are computed when the continuity is updated
+    LogEntry previous;
+    previous.setUnit("user@1000.service");
+    previous.setExe("/usr/bin/kwin");
+    LogEntry entry;
+    entry.setUnit("user@1000.service");
+    entry.setExe("/usr/bin/kwin_wayland");
+    entry.updateContinuity(&previous);
+    QCOMPARE(entry.unitContinuity(), LogEntry::Continuity::UNCHANGED);
+    QCOMPARE(entry.unitChangedSubstring(), QString());
+    QCOMPARE(entry.exeContinuity(), LogEntry::Continuity::EXTENDED);
+    QCOMPARE(entry.exeChangedSubstring(), QStringLiteral("_wayland"));
+    entry.updateContinuity(nullptr);
+    QCOMPARE(entry.unitChangedSubstring(), QStringLiteral("user@1000.service"));
+    QCOMPARE(entry.exeChangedSubstring(), QStringLiteral("/usr/bin/kwin_wayland"));
+}
+
+void TestViewModel::entryHandle()
+{
+    JournaldViewModel model;
+    auto provider = LocalJournal(JOURNAL_LOCATION);
+    model.setJournalProvider(&provider);
+    Filter filter = model.filter();
+    filter.setBootFilter({mBoots.at(0)});
+    model.setFilter(filter);
+
+    model.setFetchMoreChunkSize(50);
+    model.seekTail();
+    QVERIFY(model.rowCount() > 0);
+
+    const int lastRow = model.rowCount() - 1;
+    const auto handle = model.data(model.index(lastRow, 0), JournaldViewModel::ENTRY).value<LogEntryHandle>();
+    QVERIFY(handle.isValid());
+    const QString cursor = model.data(model.index(lastRow, 0), JournaldViewModel::CURSOR).toString();
+    QCOMPARE(handle.cursor(), cursor);
+    QCOMPARE(handle.message(), model.data(model.index(lastRow, 0), JournaldViewModel::MESSAGE).toString());
+    QCOMPARE(handle.date(), model.data(model.index(lastRow, 0), JournaldViewModel::DATETIME).toDateTime());
+    QCOMPARE(handle.date(), model.datetime(lastRow));
+    QCOMPARE(handle.entry().cursor(), cursor);
+
+    // prepending rows keeps handle pointing to same entry
+    const int rowsBefore = model.rowCount();
+    model.fetchMore(QModelIndex());
+    QVERIFY(model.rowCount() > rowsBefore);
+    QVERIFY(handle.isValid());
+    QCOMPARE(handle.cursor(), cursor);
+    const int prependedRows = model.rowCount() - rowsBefore;
+    QCOMPARE(model.data(model.index(lastRow + prependedRows, 0), JournaldViewModel::ENTRY).value<LogEntryHandle>().cursor(), cursor);
+
+    // reset invalidates handle
+    model.seekHead();
+    QVERIFY(!handle.isValid());
+    QCOMPARE(handle.cursor(), QString());
+    QCOMPARE(model.datetime(-1), QDateTime());
+}
+
+void TestViewModel::exportRows()
+{
+    JournaldViewModel model;
+    auto provider = LocalJournal(JOURNAL_LOCATION);
+    model.setJournalProvider(&provider);
+    Filter filter = model.filter();
+    filter.setSystemdSystemUnitFilter({"systemd-networkd.service"});
+    model.setFilter(filter);
+    model.setFetchMoreChunkSize(50);
+    model.seekHead();
+    QVERIFY(model.rowCount() > 20);
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QCOMPARE(model.exportRows(&buffer, 10, 19, JournaldViewModel::JSON_LINES), 10);
+    const QList<QByteArray> lines = buffer.data().split('\n');
+    QCOMPARE(lines.size(), 11);
+    for (int i = 0; i < 10; ++i) {
+        const QJsonObject entry = QJsonDocument::fromJson(lines.at(i)).object();
+        QCOMPARE(entry.value("_SYSTEMD_UNIT").toString(), "systemd-networkd.service");
+        QCOMPARE(entry.value("__CURSOR").toString(), model.data(model.index(10 + i, 0), JournaldViewModel::CURSOR).toString());
+        QCOMPARE(entry.value("MESSAGE").toString(), model.data(model.index(10 + i, 0), JournaldViewModel::MESSAGE).toString());
+    }
+
+    // complete filtered journal is independent of loaded rows
+    while (model.canFetchMore(QModelIndex())) {
+        model.fetchMore(QModelIndex());
+    }
+    QBuffer journalBuffer;
+    QVERIFY(journalBuffer.open(QIODevice::WriteOnly));
+    QCOMPARE(model.exportJournal(&journalBuffer, JournaldViewModel::PLAIN_TEXT), model.rowCount());
+    QVERIFY(journalBuffer.data().count('\n') >= model.rowCount());
+
+    // model-free export streams the same entries
+    QBuffer providerBuffer;
+    QVERIFY(providerBuffer.open(QIODevice::WriteOnly));
+    QCOMPARE(JournaldViewModel::exportJournal(&provider, filter, &providerBuffer, JournaldViewModel::PLAIN_TEXT), model.rowCount());
+    QCOMPARE(providerBuffer.data(), journalBuffer.data());
+    QVERIFY(model.exportRowsToText(0, 0).endsWith(QLatin1String(" systemd-networkd.service ") + model.data(model.index(0, 0), JournaldViewModel::MESSAGE).toString() + '\n'));
+
+    // copied text uses the unit names as shown by the view, independent of the row order
+    const QStringList textLines = model.exportRowsToText(19, 10).split(QLatin1Char('\n'), Qt::SkipEmptyParts);
+    QCOMPARE(textLines.size(), 10);
+    for (int i = 0; i < 10; ++i) {
+        const QModelIndex index = model.index(10 + i, 0);
+        QVERIFY(textLines.at(i).endsWith(QLatin1String(" UTC ") + model.data(index, JournaldViewModel::SYSTEMD_UNIT).toString() + QLatin1Char(' ')
+                                         + model.data(index, JournaldViewModel::MESSAGE).toString()));
+    }
+
+    // file export is written by a worker and reports its result asynchronously
+    QTemporaryDir exportDir;
+    QVERIFY(exportDir.isValid());
+    const QString exportFile = exportDir.filePath("export.txt");
+    QSignalSpy finishedSpy(&model, &JournaldViewModel::exportFinished);
+    QSignalSpy progressSpy(&model, &JournaldViewModel::exportProgress);
+    QVERIFY(model.exportJournalToFile(QUrl::fromLocalFile(exportFile), JournaldViewModel::PLAIN_TEXT));
+    QVERIFY(!model.exportJournalToFile(QUrl::fromLocalFile(exportFile), JournaldViewModel::PLAIN_TEXT));
+    QVERIFY(finishedSpy.wait());
+    QCOMPARE(finishedSpy.constFirst().at(0).toBool(), true);
+    QCOMPARE(progressSpy.constLast().at(0).value<qsizetype>(), model.rowCount());
+    QFile file(exportFile);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), journalBuffer.data());
+
+    // failed exports report an error and do not create the file
+    const QString missingFolderFile = exportDir.filePath("missing/export.txt");
+    QVERIFY(model.exportJournalToFile(QUrl::fromLocalFile(missingFolderFile), JournaldViewModel::PLAIN_TEXT));
+    QVERIFY(finishedSpy.wait());
+    QCOMPARE(finishedSpy.constLast().at(0).toBool(), false);
+    QVERIFY(!finishedSpy.constLast().at(1).toString().isEmpty());
+    QVERIFY(!QFile::exists(missingFolderFile));
+}
+
+void TestViewModel::recoverCursor()
+{
+    auto currentCursor = [](sd_journal *journal) {
+        char *cursor{nullptr};
+        if (sd_journal_get_cursor(journal, &cursor) < 0) {
+            return QString();
+        }
+        const QString result = QString::fromUtf8(cursor);
+        free(cursor);
+        return result;
+    };
+
+    // pick an entry in the middle of the journal, such that entries exist before and after it
+    SdJournal sourceJournal{JOURNAL_LOCATION};
+    QVERIFY(sourceJournal.isValid());
+    QVERIFY(sd_journal_seek_head(sourceJournal.get()) >= 0);
+    QCOMPARE(sd_journal_next_skip(sourceJournal.get(), 100), 100);
+    const QString cursor = currentCursor(sourceJournal.get());
+    QVERIFY(!cursor.isEmpty());
+    uint64_t realtime{0};
+    QVERIFY(sd_journal_get_realtime_usec(sourceJournal.get(), &realtime) >= 0);
+
+    // same entry as seen by a journal instance with a different seqnum domain, e.g. after the
+    // journal files were copied or merged
+    QStringList fields = cursor.split(QLatin1Char(';'));
+    for (QString &field : fields) {
+        if (field.startsWith(QLatin1String("s="))) {
+            field = QStringLiteral("s=0123456789abcdef0123456789abcdef");
+        } else if (field.startsWith(QLatin1String("i="))) {
+            field = QStringLiteral("i=1");
+        }
+    }
+    const QString foreignCursor = fields.join(QLatin1Char(';'));
+    QVERIFY(foreignCursor != cursor);
+
+    {
+        SdJournal journal{JOURNAL_LOCATION};
+        QVERIFY(journal.isValid());
+        QCOMPARE(JournaldViewModelPrivate::recoverCursor(journal.get(), foreignCursor), JournaldViewModelPrivate::SeekCursorResult::CURSOR_MADE_CURRENT);
+        QCOMPARE(currentCursor(journal.get()), cursor);
+        uint64_t recoveredRealtime{0};
+        QVERIFY(sd_journal_get_realtime_usec(journal.get(), &recoveredRealtime) >= 0);
+        QCOMPARE(recoveredRealtime, realtime);
+    }
+
+    // complete seek logic falls back to recovery when the cursor test fails
+    {
+        SdJournal journal{JOURNAL_LOCATION};
+        QVERIFY(journal.isValid());
+        QCOMPARE(JournaldViewModelPrivate::seekCursor(journal.get(), foreignCursor), JournaldViewModelPrivate::SeekCursorResult::CURSOR_MADE_CURRENT);
+        QCOMPARE(currentCursor(journal.get()), cursor);
+    }
+
+    // without any timestamp, the position cannot be recovered
+    {
+        SdJournal journal{JOURNAL_LOCATION};
+        QVERIFY(journal.isValid());
+        QCOMPARE(JournaldViewModelPrivate::recoverCursor(journal.get(), QStringLiteral("s=0123456789abcdef0123456789abcdef;i=1")),
+                 JournaldViewModelPrivate::SeekCursorResult::ERROR);
+    }
+}
+
 #include "moc_test_viewmodel.cpp"
@@ -32,6 +32,23 @@ private Q_SLOTS:
      * Search mechanism with automatic fetching
      */
     void stringSearch();
+    /**
+     * Changed substring roles match the string difference to the previous row across chunk boundaries
+     */
+    void changedSubstrings();
+
+    /**
+     * Check that entry handles resolve lazily to the current storage and survive prepending of rows
+     */
+    void entryHandle();
+    /**
+     * Exported rows are the filtered entries of the model rows
+     */
+    void exportRows();
+    /**
+     * Cursors of other journal instances with a different seqnum domain are recovered by their timestamps
+     */
+    void recoverCursor();
 
 private:
     const QStringList mBoots{"68f2e61d061247d8a8ba0b8d53a97a52", "27acae2fe35a40ac93f9c7732c0b8e59", "2dbe99dd855049af8f2865c5da2b8fda"};
@@ -0,0 +1,119 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef BENCHMARKDATAGENERATOR_H
+#define BENCHMARKDATAGENERATOR_H
+
+#include "journalwriter.h"
+#include "systemdjournalremote.h"
+#include <QCryptographicHash>
+#include <QDeadlineTimer>
+#include <QTemporaryFile>
+#include <QTest>
+#include <array>
+#include <chrono>
+#include <memory>
+
+/**
+ * @return number of generated entries given by KJOURNALD_BENCHMARK_GENERATED_ENTRIES or 200k as fallback
+ */
+inline qsizetype benchmarkGeneratedEntries()
+{
+    bool ok{false};
+    const qsizetype entries = qEnvironmentVariableIntValue("KJOURNALD_BENCHMARK_GENERATED_ENTRIES", &ok);
+    return ok && entries > 0 ? entries : 200000;
+}
+
+/**
+ * @brief Write @p entries synthetic log entries in journald export format to @p device
+ *
+ * The entries are spread over 4 boots and 2 hosts and use a mix of plain, template and user units,
+ * executables and priorities similar to a desktop system. Messages are distinct, such that searches
+ * only match where expected.
+ */
+inline bool writeGeneratedExport(QIODevice *device, qsizetype entries)
+{
+    constexpr int boots{4};
+    const std::array<QByteArray, 8> units{"dbus.service",
+                                          "systemd-journald.service",
+                                          "NetworkManager.service",
+                                          "init.scope",
+                                          "user@1000.service",
+                                          "systemd-fsck@dev-disk-by\\x2duuid-1234.service",
+                                          "getty@tty1.service",
+                                          "session-2.scope"};
+    const std::array<QByteArray, 6> userUnits{"plasma-plasmashell.service",
+                                              "plasma-kwin_wayland.service",
+                                              "pipewire.service",
+                                              "app-org.kde.konsole-1234.scope",
+                                              "app-org.kde.dolphin-5678.scope",
+                                              "xdg-desktop-portal.service"};
+    const std::array<QByteArray, 6> exes{"/usr/bin/dbus-broker",
+                                         "/usr/lib/systemd/systemd-journald",
+                                         "/usr/bin/NetworkManager",
+                                         "/usr/bin/plasmashell",
+                                         "/usr/bin/kwin_wayland",
+                                         "/usr/bin/pipewire"};
+    const std::array<QByteArray, 2> hosts{"server", "client"};
+    const QByteArray machineId = QCryptographicHash::hash("kjournald-benchmark-machine", QCryptographicHash::Md5).toHex();
+
+    JournalWriter writer(device, JournaldViewModel::JOURNAL_EXPORT);
+    const quint64 firstRealtime{1767225600000000}; // 2026-01-01 in usec
+    for (qsizetype i = 0; i < entries; ++i) {
+        const qsizetype boot = i * boots / entries;
+        const QByteArray bootId = QCryptographicHash::hash("kjournald-benchmark-boot-" + QByteArray::number(boot), QCryptographicHash::Md5).toHex();
+        const quint64 realtime = firstRealtime + i * 1000;
+        const quint64 monotonic = (i - boot * entries / boots) * 1000 + 1;
+        writer.beginEntry();
+        writer.addField("__REALTIME_TIMESTAMP", QByteArray::number(realtime));
+        writer.addField("__MONOTONIC_TIMESTAMP", QByteArray::number(monotonic));
+        writer.addField("_BOOT_ID", bootId);
+        writer.addField("_MACHINE_ID", machineId);
+        writer.addField("_HOSTNAME", hosts.at(i % hosts.size()));
+        writer.addField("_TRANSPORT", "journal");
+        writer.addField("PRIORITY", QByteArray::number(i % 8));
+        if (i % 3 == 0) {
+            writer.addField("_SYSTEMD_UNIT", "user@1000.service");
+            writer.addField("_SYSTEMD_USER_UNIT", userUnits.at(i % userUnits.size()));
+        } else {
+            writer.addField("_SYSTEMD_UNIT", units.at(i % units.size()));
+        }
+        writer.addField("_EXE", exes.at(i % exes.size()));
+        writer.addField("MESSAGE", "Generated benchmark message " + QByteArray::number(i) + " of boot " + QByteArray::number(boot));
+        if (!writer.endEntry()) {
+            return false;
+        }
+    }
+    return writer.flush();
+}
+
+/**
+ * @brief Import @p entries generated log entries into a journal via systemd-journal-remote
+ *
+ * @param exportFile file that is used for the generated export data, must be kept until the import finished
+ * @return provider of the imported journal or nullptr if systemd-journal-remote is not available
+ */
+inline std::unique_ptr<SystemdJournalRemote> createGeneratedJournal(QTemporaryFile &exportFile, qsizetype entries = benchmarkGeneratedEntries())
+{
+    if (!exportFile.open() || !writeGeneratedExport(&exportFile, entries)) {
+        return nullptr;
+    }
+    exportFile.close();
+
+    auto journal = std::make_unique<SystemdJournalRemote>(exportFile.fileName());
+    if (!journal->isSystemdRemoteAvailable()) {
+        return nullptr;
+    }
+    QDeadlineTimer deadline(std::chrono::minutes(5));
+    while (!journal->isImportFinished() && !deadline.hasExpired()) {
+        QTest::qWait(100);
+    }
+    if (!journal->isImportFinished()) {
+        return nullptr;
+    }
+    return journal;
+}
+
+#endif
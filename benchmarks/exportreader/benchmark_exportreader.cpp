@@ -0,0 +1,170 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "benchmark_exportreader.h"
+#include "../benchmarkdatagenerator.h"
+#include "../benchmarkdatalocation.h"
+#include "journaldexportreader.h"
+#include "journalindex.h"
+#include <KCompressionDevice>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTest>
+#include <QThread>
+#include <algorithm>
+
+// to benchmark with a real dump, run with KJOURNALD_BENCHMARK_EXPORT pointing to a file created by
+// "journalctl -o export", otherwise the binary autotest example is repeated to a file of 64 MiB;
+// additionally, all cases are run for an export file with generated log entries
+
+namespace
+{
+constexpr qint64 GENERATED_EXPORT_SIZE{64 * 1024 * 1024};
+}
+
+void BenchmarkExportReader::initTestCase()
+{
+    mExportFile = benchmarkExportLocation();
+    if (mExportFile.isEmpty()) {
+        QFile example(BENCHMARK_EXPORT_FORMAT_EXAMPLE);
+        QVERIFY(example.open(QIODevice::ReadOnly));
+        const QByteArray entry = example.readAll() + '\n';
+        QVERIFY(mGeneratedExport.open());
+        while (mGeneratedExport.size() < GENERATED_EXPORT_SIZE) {
+            QCOMPARE(mGeneratedExport.write(entry), entry.size());
+        }
+        mGeneratedExport.close();
+        mExportFile = mGeneratedExport.fileName();
+    }
+    qDebug() << "Benchmarking export file" << mExportFile << "of size" << QFile(mExportFile).size();
+
+    QVERIFY(mGeneratedEntriesExport.open());
+    QVERIFY(writeGeneratedExport(&mGeneratedEntriesExport, benchmarkGeneratedEntries()));
+    mGeneratedEntriesExport.close();
+    qDebug() << "Benchmarking generated export file of size" << mGeneratedEntriesExport.size();
+}
+
+QString BenchmarkExportReader::exportFile(bool generated) const
+{
+    return generated ? mGeneratedEntriesExport.fileName() : mExportFile;
+}
+
+void BenchmarkExportReader::parseThroughput_data()
+{
+    QTest::addColumn<bool>("generated");
+    QTest::addColumn<bool>("convert");
+    for (const bool generated : {false, true}) {
+        const char *file = generated ? "generated" : "example";
+        QTest::addRow("%s, field views", file) << generated << false;
+        QTest::addRow("%s, hash adapter", file) << generated << true;
+    }
+}
+
+void BenchmarkExportReader::parseThroughput()
+{
+    QFETCH(bool, generated);
+    QFETCH(bool, convert);
+    QFile file(exportFile(generated));
+
+    QElapsedTimer timer;
+    timer.start();
+    JournaldExportReader reader(&file);
+    qsizetype entries{0};
+    qsizetype fields{0};
+    while (reader.readNext()) {
+        if (convert) {
+            fields += reader.entry().size();
+        } else {
+            fields += reader.fields().size();
+        }
+        ++entries;
+    }
+    const qint64 elapsed = std::max<qint64>(timer.nsecsElapsed(), 1);
+
+    QVERIFY(entries > 0);
+    qDebug() << "Parsed" << entries << "entries with" << fields << "fields," << (file.size() / 1e6) / (elapsed / 1e9) << "MB/s";
+    QTest::setBenchmarkResult(file.size() / (elapsed / 1e9), QTest::BytesPerSecond);
+}
+
+void BenchmarkExportReader::indexScaling_data()
+{
+    QTest::addColumn<bool>("generated");
+    QTest::addColumn<int>("threads");
+    const int idealThreadCount = std::max(1, QThread::idealThreadCount());
+    for (const bool generated : {false, true}) {
+        const char *file = generated ? "generated" : "example";
+        for (int threads = 1; threads < idealThreadCount; threads *= 2) {
+            QTest::addRow("%s, %d threads", file, threads) << generated << threads;
+        }
+        QTest::addRow("%s, %d threads", file, idealThreadCount) << generated << idealThreadCount;
+    }
+}
+
+void BenchmarkExportReader::indexScaling()
+{
+    QFETCH(bool, generated);
+    QFETCH(int, threads);
+    const QString path = exportFile(generated);
+    const qint64 size = QFile(path).size();
+
+    QElapsedTimer timer;
+    timer.start();
+    JournalIndex index(path, threads);
+    const qint64 elapsed = std::max<qint64>(timer.nsecsElapsed(), 1);
+
+    QVERIFY(index.size() > 0);
+    qDebug() << "Indexed" << index.size() << "entries with" << threads << "threads," << (size / 1e6) / (elapsed / 1e9) << "MB/s";
+    QTest::setBenchmarkResult(size / (elapsed / 1e9), QTest::BytesPerSecond);
+}
+
+void BenchmarkExportReader::compressedParseThroughput_data()
+{
+    QTest::addColumn<QString>("suffix");
+    QTest::addColumn<int>("type");
+    QTest::newRow("gzip") << QStringLiteral(".gz") << int(KCompressionDevice::GZip);
+    QTest::newRow("xz") << QStringLiteral(".xz") << int(KCompressionDevice::Xz);
+    QTest::newRow("zstd") << QStringLiteral(".zst") << int(KCompressionDevice::Zstd);
+}
+
+void BenchmarkExportReader::compressedParseThroughput()
+{
+    QFETCH(QString, suffix);
+    QFETCH(int, type);
+
+    // compressed file is created before measuring
+    const QString path = mCompressedExportDir.path() + QLatin1String("/benchmark.export") + suffix;
+    {
+        QFile file(mExportFile);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        KCompressionDevice compressor(path, static_cast<KCompressionDevice::CompressionType>(type));
+        if (!compressor.open(QIODevice::WriteOnly)) {
+            QSKIP("Compression type is not supported by KArchive");
+        }
+        while (!file.atEnd()) {
+            QVERIFY(compressor.write(file.read(1024 * 1024)) > 0);
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    std::unique_ptr<QIODevice> device = JournaldExportReader::createDevice(path);
+    JournaldExportReader reader(device.get());
+    qsizetype entries{0};
+    while (reader.readNext()) {
+        ++entries;
+    }
+    const double seconds = std::max<qint64>(timer.nsecsElapsed(), 1) / 1e9;
+
+    QVERIFY(entries > 0);
+    const qint64 compressedSize = QFile(path).size();
+    const qint64 uncompressedSize = reader.position();
+    qDebug() << "Parsed" << entries << "entries," << (compressedSize / 1e6) / seconds << "MB/s compressed," << (uncompressedSize / 1e6) / seconds
+             << "MB/s uncompressed";
+    QTest::setBenchmarkResult(uncompressedSize / seconds, QTest::BytesPerSecond);
+}
+
+QTEST_GUILESS_MAIN(BenchmarkExportReader);
+
+#include "moc_benchmark_exportreader.cpp"
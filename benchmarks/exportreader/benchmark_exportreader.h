@@ -0,0 +1,46 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef BENCHMARK_EXPORTREADER_H
+#define BENCHMARK_EXPORTREADER_H
+
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTemporaryFile>
+
+class BenchmarkExportReader : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    /**
+     * Parse throughput in bytes per second, once with field views only and once with QHash conversion
+     */
+    void parseThroughput_data();
+    void parseThroughput();
+    /**
+     * Index build throughput in bytes per second for 1 to QThread::idealThreadCount() parser threads
+     */
+    void indexScaling_data();
+    void indexScaling();
+    /**
+     * Streaming parse throughput of compressed export files, reported for the uncompressed data
+     */
+    void compressedParseThroughput_data();
+    void compressedParseThroughput();
+
+private:
+    /**
+     * @return repeated example or provided export file, or the export file with generated log entries if @p generated
+     */
+    QString exportFile(bool generated) const;
+
+    QTemporaryFile mGeneratedExport;
+    QTemporaryFile mGeneratedEntriesExport;
+    QString mExportFile;
+    QTemporaryDir mCompressedExportDir;
+};
+#endif
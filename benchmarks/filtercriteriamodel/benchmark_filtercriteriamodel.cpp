@@ -0,0 +1,109 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "benchmark_filtercriteriamodel.h"
+#include "../benchmarkdatagenerator.h"
+#include "../benchmarkdatalocation.h"
+#include "filtercriteriamodel.h"
+#include "journaldhelper.h"
+#include "localjournal.h"
+#include <QStandardPaths>
+#include <QTest>
+
+namespace
+{
+// visit every index like a tree view does, parent() is requested for every visited index
+int walk(const QAbstractItemModel &model, const QModelIndex &parent)
+{
+    int visited{0};
+    for (int row = 0; row < model.rowCount(parent); ++row) {
+        const QModelIndex index = model.index(row, 0, parent);
+        Q_ASSERT(model.parent(index) == parent);
+        model.data(index, FilterCriteriaModel::Roles::TEXT);
+        model.data(index, FilterCriteriaModel::Roles::SELECTED);
+        visited += 1 + walk(model, index);
+    }
+    return visited;
+}
+}
+
+BenchmarkFilterCriteriaModel::BenchmarkFilterCriteriaModel() = default;
+
+BenchmarkFilterCriteriaModel::~BenchmarkFilterCriteriaModel() = default;
+
+void BenchmarkFilterCriteriaModel::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    SdJournal journal{benchmarkJournalLocation()};
+    QVERIFY(journal.isValid());
+    mBootId = qEnvironmentVariable("KJOURNALD_BENCHMARK_BOOT");
+    if (mBootId.isEmpty()) {
+        const auto boots = JournaldHelper::queryOrderedBootIds(journal.get());
+        QVERIFY(!boots.isEmpty());
+        mBootId = boots.constLast().mBootId;
+    }
+
+    mGeneratedJournal = createGeneratedJournal(mGeneratedExport);
+    if (!mGeneratedJournal) {
+        qDebug() << "Generated journal is not available, benchmarks are only run for the bundled journal";
+    }
+}
+
+void BenchmarkFilterCriteriaModel::walkTree()
+{
+    LocalJournal provider{benchmarkJournalLocation()};
+    FilterCriteriaModel model;
+    model.setJournalProvider(&provider);
+    model.setBootFilter(mBootId);
+    model.componentComplete();
+    QTRY_VERIFY_WITH_TIMEOUT(!model.isLoading(), 60000);
+
+    int visited{0};
+    QBENCHMARK {
+        visited = walk(model, QModelIndex());
+    }
+    QVERIFY(visited > 0);
+    qDebug() << "Visited entries per walk:" << visited;
+}
+
+void BenchmarkFilterCriteriaModel::rebuildModel_data()
+{
+    QTest::addColumn<bool>("generated");
+    QTest::newRow("bundled") << false;
+    QTest::newRow("generated") << true;
+}
+
+void BenchmarkFilterCriteriaModel::rebuildModel()
+{
+    QFETCH(bool, generated);
+    if (generated && !mGeneratedJournal) {
+        QSKIP("Generated journal requires systemd-journal-remote");
+    }
+    LocalJournal bundledJournal{benchmarkJournalLocation()};
+    IJournalProvider *provider = generated ? static_cast<IJournalProvider *>(mGeneratedJournal.get()) : &bundledJournal;
+    QString bootId = mBootId;
+    if (generated) {
+        const auto boots = JournaldHelper::queryOrderedBootIds(provider);
+        QVERIFY(!boots.isEmpty());
+        bootId = boots.constLast().mBootId;
+    }
+    FilterCriteriaModel model;
+    model.setJournalProvider(provider);
+    model.setBootFilter(bootId);
+    model.componentComplete();
+    QTRY_VERIFY_WITH_TIMEOUT(!model.isLoading(), 60000);
+
+    QBENCHMARK {
+        model.setGroupTemplatedSystemdUnits(!model.groupTemplatedSystemdUnits());
+        while (model.isLoading()) {
+            QCoreApplication::processEvents();
+        }
+    }
+    QVERIFY(model.rowCount() > 0);
+}
+
+QTEST_GUILESS_MAIN(BenchmarkFilterCriteriaModel);
+
+#include "moc_benchmark_filtercriteriamodel.cpp"
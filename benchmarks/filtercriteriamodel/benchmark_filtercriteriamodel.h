@@ -0,0 +1,37 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef BENCHMARK_FILTERCRITERIAMODEL_H
+#define BENCHMARK_FILTERCRITERIAMODEL_H
+
+#include <QObject>
+#include <QTemporaryFile>
+#include <memory>
+
+class SystemdJournalRemote;
+
+class BenchmarkFilterCriteriaModel : public QObject
+{
+    Q_OBJECT
+
+public:
+    BenchmarkFilterCriteriaModel();
+    ~BenchmarkFilterCriteriaModel() override;
+
+private Q_SLOTS:
+    void initTestCase();
+    void walkTree();
+    /**
+     * Rebuild of the selection tree from already queried unique values, triggered by toggling the template grouping
+     */
+    void rebuildModel_data();
+    void rebuildModel();
+
+private:
+    QString mBootId;
+    QTemporaryFile mGeneratedExport;
+    std::unique_ptr<SystemdJournalRemote> mGeneratedJournal;
+};
+#endif
@@ -0,0 +1,107 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "benchmark_uniquequery.h"
+#include "../benchmarkdatagenerator.h"
+#include "../benchmarkdatalocation.h"
+#include "journaldhelper.h"
+#include "sdjournal.h"
+#include <QTest>
+
+// to benchmark with a large boot, run with KJOURNALD_BENCHMARK_JOURNAL pointing to a journal
+// directory and optionally KJOURNALD_BENCHMARK_BOOT set to the boot id, otherwise the newest boot is used
+
+BenchmarkUniqueQuery::BenchmarkUniqueQuery() = default;
+
+BenchmarkUniqueQuery::~BenchmarkUniqueQuery() = default;
+
+void BenchmarkUniqueQuery::initTestCase()
+{
+    SdJournal journal{benchmarkJournalLocation()};
+    QVERIFY(journal.isValid());
+    mBootId = qEnvironmentVariable("KJOURNALD_BENCHMARK_BOOT");
+    if (mBootId.isEmpty()) {
+        const auto boots = JournaldHelper::queryOrderedBootIds(journal.get());
+        QVERIFY(!boots.isEmpty());
+        mBootId = boots.constLast().mBootId;
+    }
+    qDebug() << "Benchmarking boot" << mBootId << "of journal" << benchmarkJournalLocation();
+
+    mGeneratedJournal = createGeneratedJournal(mGeneratedExport);
+    if (mGeneratedJournal) {
+        std::unique_ptr<SdJournal> generatedJournal = mGeneratedJournal->openJournal();
+        QVERIFY(generatedJournal && generatedJournal->isValid());
+        const auto boots = JournaldHelper::queryOrderedBootIds(generatedJournal->get());
+        QVERIFY(!boots.isEmpty());
+        mGeneratedBootId = boots.constLast().mBootId;
+    } else {
+        qDebug() << "Generated journal is not available, benchmarks are only run for the bundled journal";
+    }
+}
+
+std::unique_ptr<SdJournal> BenchmarkUniqueQuery::openJournal(bool generated) const
+{
+    if (generated) {
+        return mGeneratedJournal ? mGeneratedJournal->openJournal() : nullptr;
+    }
+    return std::make_unique<SdJournal>(benchmarkJournalLocation());
+}
+
+void BenchmarkUniqueQuery::queryUniquePerBoot_data()
+{
+    QTest::addColumn<bool>("generated");
+    QTest::addColumn<bool>("scan");
+    for (const bool generated : {false, true}) {
+        const char *journal = generated ? "generated" : "bundled";
+        QTest::addRow("%s, enumerate unique", journal) << generated << false;
+        QTest::addRow("%s, entry scan", journal) << generated << true;
+    }
+}
+
+void BenchmarkUniqueQuery::queryUniquePerBoot()
+{
+    QFETCH(bool, generated);
+    QFETCH(bool, scan);
+    const QList<JournaldHelper::Field> fields{JournaldHelper::Field::_SYSTEMD_UNIT, JournaldHelper::Field::_SYSTEMD_USER_UNIT, JournaldHelper::Field::_EXE};
+    std::unique_ptr<SdJournal> journal = openJournal(generated);
+    if (!journal) {
+        QSKIP("Generated journal requires systemd-journal-remote");
+    }
+    QVERIFY(journal->isValid());
+    const QString bootId = generated ? mGeneratedBootId : mBootId;
+
+    QMap<JournaldHelper::Field, QStringList> result;
+    QBENCHMARK {
+        result = scan ? JournaldHelper::queryUniqueByScan(journal->get(), bootId, fields) : JournaldHelper::queryUnique(journal->get(), bootId, fields);
+    }
+    QVERIFY(!result.value(JournaldHelper::Field::_SYSTEMD_UNIT).isEmpty());
+}
+
+void BenchmarkUniqueQuery::queryOrderedBootIds_data()
+{
+    QTest::addColumn<bool>("generated");
+    QTest::newRow("bundled") << false;
+    QTest::newRow("generated") << true;
+}
+
+void BenchmarkUniqueQuery::queryOrderedBootIds()
+{
+    QFETCH(bool, generated);
+    std::unique_ptr<SdJournal> journal = openJournal(generated);
+    if (!journal) {
+        QSKIP("Generated journal requires systemd-journal-remote");
+    }
+    QVERIFY(journal->isValid());
+
+    QList<JournaldHelper::BootInfo> boots;
+    QBENCHMARK {
+        boots = JournaldHelper::queryOrderedBootIds(journal->get());
+    }
+    QVERIFY(!boots.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(BenchmarkUniqueQuery);
+
+#include "moc_benchmark_uniquequery.cpp"
@@ -0,0 +1,45 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef BENCHMARK_UNIQUEQUERY_H
+#define BENCHMARK_UNIQUEQUERY_H
+
+#include <QObject>
+#include <QTemporaryFile>
+#include <memory>
+
+class SdJournal;
+class SystemdJournalRemote;
+
+class BenchmarkUniqueQuery : public QObject
+{
+    Q_OBJECT
+
+public:
+    BenchmarkUniqueQuery();
+    ~BenchmarkUniqueQuery() override;
+
+private Q_SLOTS:
+    void initTestCase();
+    void queryUniquePerBoot_data();
+    void queryUniquePerBoot();
+    /**
+     * Boot list ordered by time, without the boot info cache of the provider based query
+     */
+    void queryOrderedBootIds_data();
+    void queryOrderedBootIds();
+
+private:
+    /**
+     * @return new journal object for the bundled or generated journal, nullptr if the generated journal is not available
+     */
+    std::unique_ptr<SdJournal> openJournal(bool generated) const;
+
+    QString mBootId;
+    QString mGeneratedBootId;
+    QTemporaryFile mGeneratedExport;
+    std::unique_ptr<SystemdJournalRemote> mGeneratedJournal;
+};
+#endif
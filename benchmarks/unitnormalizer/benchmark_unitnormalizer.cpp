@@ -0,0 +1,86 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "benchmark_unitnormalizer.h"
+#include "journaldhelper.h"
+#include <QRegularExpression>
+#include <QTest>
+
+void BenchmarkUnitNormalizer::initTestCase()
+{
+    // 10k unit names with typical distribution of plain units, template instances and escaped arguments,
+    // units repeat like they do when reading log entries
+    const QStringList plainUnits{QStringLiteral("dbus.service"),
+                                 QStringLiteral("systemd-journald.service"),
+                                 QStringLiteral("NetworkManager.service"),
+                                 QStringLiteral("init.scope"),
+                                 QStringLiteral("session-2.scope")};
+    mUnits.reserve(10000);
+    for (int i = 0; i < 10000; ++i) {
+        switch (i % 4) {
+        case 0:
+            mUnits << plainUnits.at(i % plainUnits.size());
+            break;
+        case 1:
+            mUnits << QStringLiteral("user@%1.service").arg(1000 + i % 8);
+            break;
+        case 2:
+            mUnits << QStringLiteral("systemd-fsck@dev-disk-by\\x2duuid-%1.service").arg(i % 32);
+            break;
+        case 3:
+            mUnits << QStringLiteral("app-org.kde.konsole-%1.scope").arg(i % 64);
+            break;
+        }
+    }
+}
+
+void BenchmarkUnitNormalizer::regularExpression()
+{
+    // previous approach of the filter criteria model
+    static const QRegularExpression templateArgumentExpr(QLatin1String("@.+\\.service"));
+    QBENCHMARK {
+        for (const QString &unit : std::as_const(mUnits)) {
+            QString cleaned = JournaldHelper::cleanupString(unit);
+            cleaned.replace(templateArgumentExpr, QLatin1String("@.service"));
+        }
+    }
+}
+
+void BenchmarkUnitNormalizer::normalizeUnit()
+{
+    QBENCHMARK {
+        for (const QString &unit : std::as_const(mUnits)) {
+            JournaldHelper::normalizeUnit(unit);
+        }
+    }
+}
+
+void BenchmarkUnitNormalizer::cachedNormalizeUnit()
+{
+    QList<QByteArray> rawUnits;
+    rawUnits.reserve(mUnits.size());
+    for (const QString &unit : std::as_const(mUnits)) {
+        rawUnits << unit.toUtf8();
+    }
+    QBENCHMARK {
+        UnitNameCache cache;
+        for (const QByteArray &unit : std::as_const(rawUnits)) {
+            cache.normalize(QByteArrayView(unit));
+        }
+    }
+}
+
+void BenchmarkUnitNormalizer::cleanupString()
+{
+    QBENCHMARK {
+        for (const QString &unit : std::as_const(mUnits)) {
+            JournaldHelper::cleanupString(unit);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(BenchmarkUnitNormalizer);
+
+#include "moc_benchmark_unitnormalizer.cpp"
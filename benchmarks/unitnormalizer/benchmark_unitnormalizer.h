@@ -0,0 +1,26 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef BENCHMARK_UNITNORMALIZER_H
+#define BENCHMARK_UNITNORMALIZER_H
+
+#include <QObject>
+#include <QStringList>
+
+class BenchmarkUnitNormalizer : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void regularExpression();
+    void normalizeUnit();
+    void cachedNormalizeUnit();
+    void cleanupString();
+
+private:
+    QStringList mUnits;
+};
+#endif
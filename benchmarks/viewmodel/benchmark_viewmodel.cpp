@@ -0,0 +1,259 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "benchmark_viewmodel.h"
+#include "../benchmarkdatagenerator.h"
+#include "../benchmarkdatalocation.h"
+#include "fieldfilterproxymodel.h"
+#include "filter.h"
+#include "journaldhelper.h"
+#include "journaldviewmodel.h"
+#include "localjournal.h"
+#include "sdjournal.h"
+#include <QTest>
+#include <array>
+#include <vector>
+
+namespace
+{
+constexpr int VIEWPORT_ROWS{80};
+
+// roles requested by a log line delegate
+constexpr std::array<int, 15> DELEGATE_ROLES{
+    JournaldViewModel::Roles::MESSAGE,
+    JournaldViewModel::Roles::MESSAGE_ID,
+    JournaldViewModel::Roles::DATE,
+    JournaldViewModel::Roles::DATETIME,
+    JournaldViewModel::Roles::MONOTONIC_TIMESTAMP,
+    JournaldViewModel::Roles::PRIORITY,
+    JournaldViewModel::Roles::SYSTEMD_UNIT,
+    JournaldViewModel::Roles::SYSTEMD_UNIT_CHANGED_SUBSTRING,
+    JournaldViewModel::Roles::BOOT_ID,
+    JournaldViewModel::Roles::SYSTEMD_UNIT_COLOR_BACKGROUND,
+    JournaldViewModel::Roles::SYSTEMD_UNIT_COLOR_FOREGROUND,
+    JournaldViewModel::Roles::EXE_COLOR_BACKGROUND,
+    JournaldViewModel::Roles::EXE_COLOR_FOREGROUND,
+    JournaldViewModel::Roles::EXE,
+    JournaldViewModel::Roles::EXE_CHANGED_SUBSTRING,
+};
+
+// entry filters of increasing complexity for resetJournal()
+enum FilterComplexity {
+    PRIORITY, //!< only priority
+    UNITS, //!< priority and several system and user units
+    COMPLEX, //!< priority, boot, units, executables and kernel messages
+};
+
+// render one frame of the viewport, every row with one multiData() call
+void renderFrame(const QAbstractItemModel &model, std::vector<QModelRoleData> &roleData)
+{
+    const int rows = std::min(VIEWPORT_ROWS, model.rowCount());
+    for (int row = 0; row < rows; ++row) {
+        model.multiData(model.index(row, 0), roleData);
+    }
+}
+
+std::vector<QModelRoleData> delegateRoleData()
+{
+    std::vector<QModelRoleData> roleData;
+    roleData.reserve(DELEGATE_ROLES.size());
+    for (const int role : DELEGATE_ROLES) {
+        roleData.emplace_back(role);
+    }
+    return roleData;
+}
+}
+
+BenchmarkViewModel::BenchmarkViewModel() = default;
+
+BenchmarkViewModel::~BenchmarkViewModel() = default;
+
+void BenchmarkViewModel::initTestCase()
+{
+    mBundledJournal = std::make_unique<LocalJournal>(benchmarkJournalLocation());
+    JournaldViewModel model;
+    model.setJournalProvider(mBundledJournal.get());
+    QVERIFY(model.rowCount() >= VIEWPORT_ROWS);
+
+    mGeneratedJournal = createGeneratedJournal(mGeneratedExport);
+    if (mGeneratedJournal) {
+        qDebug() << "Generated journal with" << benchmarkGeneratedEntries() << "entries";
+    } else {
+        qDebug() << "Generated journal is not available, benchmarks are only run for the bundled journal";
+    }
+}
+
+IJournalProvider *BenchmarkViewModel::provider(bool generated) const
+{
+    return generated ? static_cast<IJournalProvider *>(mGeneratedJournal.get()) : mBundledJournal.get();
+}
+
+void BenchmarkViewModel::viewportData()
+{
+    LocalJournal provider{benchmarkJournalLocation()};
+    JournaldViewModel model;
+    model.setJournalProvider(&provider);
+    QBENCHMARK {
+        for (int row = 0; row < VIEWPORT_ROWS; ++row) {
+            const QModelIndex index = model.index(row, 0);
+            for (const int role : DELEGATE_ROLES) {
+                model.data(index, role);
+            }
+        }
+    }
+}
+
+void BenchmarkViewModel::viewportMultiData()
+{
+    LocalJournal provider{benchmarkJournalLocation()};
+    JournaldViewModel model;
+    model.setJournalProvider(&provider);
+    std::vector<QModelRoleData> roleData = delegateRoleData();
+    QBENCHMARK {
+        renderFrame(model, roleData);
+    }
+}
+
+void BenchmarkViewModel::viewportProxyMultiData()
+{
+    LocalJournal provider{benchmarkJournalLocation()};
+    JournaldViewModel model;
+    model.setJournalProvider(&provider);
+    FieldFilterProxyModel proxy;
+    proxy.setSourceModel(&model);
+    proxy.componentComplete();
+    std::vector<QModelRoleData> roleData = delegateRoleData();
+    QBENCHMARK {
+        renderFrame(proxy, roleData);
+    }
+}
+
+void BenchmarkViewModel::readEntries_data()
+{
+    QTest::addColumn<bool>("generated");
+    QTest::addColumn<bool>("towardsTail");
+    QTest::addColumn<int>("chunkSize");
+    for (const bool generated : {false, true}) {
+        for (const bool towardsTail : {true, false}) {
+            for (const int chunkSize : {100, 500, 2000}) {
+                QTest::addRow("%s, %s, %d entries", generated ? "generated" : "bundled", towardsTail ? "towards tail" : "towards head", chunkSize)
+                    << generated << towardsTail << chunkSize;
+            }
+        }
+    }
+}
+
+void BenchmarkViewModel::readEntries()
+{
+    QFETCH(bool, generated);
+    QFETCH(bool, towardsTail);
+    QFETCH(int, chunkSize);
+    IJournalProvider *journal = provider(generated);
+    if (!journal) {
+        QSKIP("Generated journal requires systemd-journal-remote");
+    }
+    JournaldViewModel model;
+    model.setFetchMoreChunkSize(chunkSize);
+    model.setJournalProvider(journal);
+    QBENCHMARK {
+        // seeking reads exactly one chunk in the respective direction
+        if (towardsTail) {
+            model.seekHead();
+        } else {
+            model.seekTail();
+        }
+    }
+    QVERIFY(model.rowCount() > 0);
+}
+
+void BenchmarkViewModel::resetJournal_data()
+{
+    QTest::addColumn<bool>("generated");
+    QTest::addColumn<int>("complexity");
+    for (const bool generated : {false, true}) {
+        const char *journal = generated ? "generated" : "bundled";
+        QTest::addRow("%s, priority", journal) << generated << int(PRIORITY);
+        QTest::addRow("%s, units", journal) << generated << int(UNITS);
+        QTest::addRow("%s, complex", journal) << generated << int(COMPLEX);
+    }
+}
+
+void BenchmarkViewModel::resetJournal()
+{
+    QFETCH(bool, generated);
+    QFETCH(int, complexity);
+    IJournalProvider *journal = provider(generated);
+    if (!journal) {
+        QSKIP("Generated journal requires systemd-journal-remote");
+    }
+
+    // filter values are taken from the newest boot, such that every filter matches entries
+    const auto boots = JournaldHelper::queryOrderedBootIds(journal);
+    QVERIFY(!boots.isEmpty());
+    const QString bootId = boots.constLast().mBootId;
+    std::unique_ptr<SdJournal> sdJournal = journal->openJournal();
+    QVERIFY(sdJournal && sdJournal->isValid());
+    const auto unique = JournaldHelper::queryUnique(sdJournal->get(),
+                                                    bootId,
+                                                    {JournaldHelper::Field::_SYSTEMD_UNIT, JournaldHelper::Field::_SYSTEMD_USER_UNIT, JournaldHelper::Field::_EXE});
+
+    Filter filter;
+    filter.setPriorityFilter(4);
+    if (complexity >= UNITS) {
+        filter.setSystemdSystemUnitFilter(unique.value(JournaldHelper::Field::_SYSTEMD_UNIT).mid(0, 5));
+        filter.setSystemdUserUnitFilter(unique.value(JournaldHelper::Field::_SYSTEMD_USER_UNIT).mid(0, 3));
+    }
+    if (complexity >= COMPLEX) {
+        filter.setBootFilter({bootId});
+        filter.setExeFilter(unique.value(JournaldHelper::Field::_EXE).mid(0, 3));
+        filter.setKernelMessagesEnabled(true);
+    }
+
+    JournaldViewModel model;
+    model.setJournalProvider(journal);
+    QBENCHMARK {
+        model.setFilter(filter);
+    }
+    qDebug() << "Entries after reset:" << model.rowCount();
+}
+
+void BenchmarkViewModel::search_data()
+{
+    QTest::addColumn<bool>("generated");
+    QTest::addColumn<bool>("hit");
+    for (const bool generated : {false, true}) {
+        const char *journal = generated ? "generated" : "bundled";
+        QTest::addRow("%s, hit", journal) << generated << true;
+        QTest::addRow("%s, miss", journal) << generated << false;
+    }
+}
+
+void BenchmarkViewModel::search()
+{
+    QFETCH(bool, generated);
+    QFETCH(bool, hit);
+    IJournalProvider *journal = provider(generated);
+    if (!journal) {
+        QSKIP("Generated journal requires systemd-journal-remote");
+    }
+    JournaldViewModel model;
+    model.setJournalProvider(journal);
+    QVERIFY(model.rowCount() > 0);
+    // a miss fetches and compares all entries of the journal
+    const QString needle = hit ? model.data(model.index(model.rowCount() - 1, 0), JournaldViewModel::Roles::MESSAGE).toString()
+                               : QStringLiteral("kjournald benchmark string without match");
+    QVERIFY(!needle.isEmpty());
+
+    int row{-1};
+    QBENCHMARK {
+        model.seekHead();
+        row = model.search(needle, 0, false);
+    }
+    QCOMPARE(row >= 0, hit);
+}
+
+QTEST_GUILESS_MAIN(BenchmarkViewModel);
+
+#include "moc_benchmark_viewmodel.cpp"
@@ -0,0 +1,64 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef BENCHMARK_VIEWMODEL_H
+#define BENCHMARK_VIEWMODEL_H
+
+#include <QObject>
+#include <QTemporaryFile>
+#include <memory>
+
+class IJournalProvider;
+class SystemdJournalRemote;
+
+class BenchmarkViewModel : public QObject
+{
+    Q_OBJECT
+
+public:
+    BenchmarkViewModel();
+    ~BenchmarkViewModel() override;
+
+private Q_SLOTS:
+    void initTestCase();
+    /**
+     * Viewport of 80 rows with 15 roles each, requested via individual data() calls
+     */
+    void viewportData();
+    /**
+     * Same viewport requested via one multiData() call per row
+     */
+    void viewportMultiData();
+    /**
+     * Same viewport requested via multiData() through FieldFilterProxyModel
+     */
+    void viewportProxyMultiData();
+    /**
+     * Read one chunk of entries from head towards tail and from tail towards head for several chunk sizes
+     */
+    void readEntries_data();
+    void readEntries();
+    /**
+     * Reset of the journal for filters with priority, boot, unit and executable matches
+     */
+    void resetJournal_data();
+    void resetJournal();
+    /**
+     * Forward search from the head, for a message at the end of the first chunk and for a string that never matches
+     */
+    void search_data();
+    void search();
+
+private:
+    /**
+     * @return bundled autotest journal or generated journal, nullptr if the generated journal is not available
+     */
+    IJournalProvider *provider(bool generated) const;
+
+    QTemporaryFile mGeneratedExport;
+    std::unique_ptr<IJournalProvider> mBundledJournal;
+    std::unique_ptr<SystemdJournalRemote> mGeneratedJournal;
+};
+#endif
@@ -6,22 +6,39 @@
 #include "bootmodel.h"
 #include "bootmodel_p.h"
 #include "kjournaldlib_log_general.h"
+#include <QtConcurrentRun>
+#include <algorithm>
 
 BootModel::BootModel(QObject *parent)
     : QAbstractListModel(parent)
     , d(new BootModelPrivate)
 {
+    d->mUpdateTimer.setSingleShot(true);
+    d->mUpdateTimer.setInterval(BootModelPrivate::UPDATE_INTERVAL);
+    connect(&d->mUpdateTimer, &QTimer::timeout, this, &BootModel::startBootInfoUpdate);
 }
 
-BootModel::~BootModel() = default;
+BootModel::~BootModel()
+{
+    if (d->mUpdateWatcher) {
+        d->mUpdateWatcher->disconnect();
+        d->mUpdateWatcher->waitForFinished();
+    }
+}
 
 void BootModel::setJournalProvider(IJournalProvider *provider)
 {
+    d->mUpdateTimer.stop();
+    if (d->mUpdateWatcher) {
+        // result belongs to previous journal
+        d->mUpdateWatcher->disconnect();
+        d->mUpdateWatcher.release()->deleteLater();
+    }
     d->mJournalProvider = provider;
     if (provider) {
         qCDebug(KJOURNALDLIB_GENERAL) << "rebuild boot model due to journal change";
+        // journal might not be available yet, e.g. while an export file is indexed
         d->mJournal = provider->openJournal();
-        Q_ASSERT(d->mJournal);
     } else {
         qCDebug(KJOURNALDLIB_GENERAL) << "build empty boot model, because no provider set";
         d->mJournal.reset();
@@ -30,11 +47,88 @@ void BootModel::setJournalProvider(IJournalProvider *provider)
 
     beginResetModel();
     d->mBootInfo.clear();
-    if (d->mJournal) {
-        d->mBootInfo = JournaldHelper::queryOrderedBootIds(d->mJournal->get());
+    if (d->mJournal || (provider && provider->journalIndex())) {
+        d->mBootInfo = JournaldHelper::queryOrderedBootIds(provider);
         d->sort(Qt::SortOrder::DescendingOrder);
     }
     endResetModel();
+
+    if (d->mJournal) {
+        connect(d->mJournal.get(), &SdJournal::journalUpdated, this, [this]() {
+            if (!d->mUpdateTimer.isActive()) {
+                d->mUpdateTimer.start();
+            }
+        });
+    }
+}
+
+void BootModel::startBootInfoUpdate()
+{
+    if (!d->mJournalProvider || !d->mJournal) {
+        return;
+    }
+    if (d->mUpdateWatcher) {
+        // retry once the running query finished, such that the last journal change is considered
+        d->mUpdateTimer.start();
+        return;
+    }
+    // the provider's boot info cache never hits for a growing journal, thus a separate journal object is
+    // queried directly; seeking head and tail of every boot must not block the GUI thread
+    std::shared_ptr<SdJournal> journal = d->mJournalProvider->openJournal();
+    QFuture<QList<BootModelPrivate::BootInfo>> future = QtConcurrent::run([journal]() {
+        if (!journal || !journal->isValid()) {
+            return QList<BootModelPrivate::BootInfo>();
+        }
+        return JournaldHelper::queryOrderedBootIds(journal->get());
+    });
+    d->mUpdateWatcher = std::make_unique<QFutureWatcher<QList<BootModelPrivate::BootInfo>>>();
+    connect(d->mUpdateWatcher.get(), &QFutureWatcherBase::finished, this, [this]() {
+        // watcher must not be deleted while emitting the signal
+        QFutureWatcher<QList<BootModelPrivate::BootInfo>> *watcher = d->mUpdateWatcher.release();
+        watcher->deleteLater();
+        if (watcher->future().resultCount() > 0 && !watcher->future().result().isEmpty()) {
+            updateBootInfo(watcher->future().result());
+        }
+    });
+    d->mUpdateWatcher->setFuture(future);
+}
+
+void BootModel::updateBootInfo(QList<JournaldHelper::BootInfo> bootInfo)
+{
+    std::sort(std::begin(bootInfo), std::end(bootInfo), [](const BootModelPrivate::BootInfo &left, const BootModelPrivate::BootInfo &right) {
+        return left.mSince > right.mSince;
+    });
+    auto contains = [](const QList<BootModelPrivate::BootInfo> &list, const QString &bootId) {
+        return std::any_of(list.cbegin(), list.cend(), [&bootId](const BootModelPrivate::BootInfo &info) {
+            return info.mBootId == bootId;
+        });
+    };
+
+    // while a journal grows, boots are only added or extended; everything else is handled by a reset
+    bool requiresReset = std::any_of(d->mBootInfo.cbegin(), d->mBootInfo.cend(), [&](const BootModelPrivate::BootInfo &info) {
+        return !contains(bootInfo, info.mBootId);
+    });
+    for (int row = 0; row < bootInfo.size() && !requiresReset; ++row) {
+        const BootModelPrivate::BootInfo &info = bootInfo.at(row);
+        if (row < d->mBootInfo.size() && d->mBootInfo.at(row).mBootId == info.mBootId) {
+            if (d->mBootInfo.at(row).mSince != info.mSince || d->mBootInfo.at(row).mUntil != info.mUntil) {
+                d->mBootInfo[row] = info;
+                Q_EMIT dataChanged(index(row, 0), index(row, 0));
+            }
+        } else if (contains(d->mBootInfo, info.mBootId)) {
+            requiresReset = true;
+        } else {
+            beginInsertRows(QModelIndex(), row, row);
+            d->mBootInfo.insert(row, info);
+            endInsertRows();
+        }
+    }
+    if (requiresReset) {
+        qCDebug(KJOURNALDLIB_GENERAL) << "rebuild boot model due to removed or reordered boots";
+        beginResetModel();
+        d->mBootInfo = bootInfo;
+        endResetModel();
+    }
 }
 
 IJournalProvider *BootModel::journalProvider() const
@@ -7,6 +7,7 @@
 #define BOOTMODEL_H
 
 #include "ijournalprovider.h"
+#include "journaldhelper.h"
 #include "kjournald_export.h"
 #include <QAbstractItemModel>
 #include <QQmlEngine>
@@ -81,6 +82,18 @@ Q_SIGNALS:
     void journalProviderChanged();
 
 private:
+    /**
+     * @brief query boot information on a worker thread after the journal changed
+     */
+    void startBootInfoUpdate();
+
+    /**
+     * @brief update boot information to @p bootInfo, with row insertions and data changes
+     *
+     * The model is only reset if boots were removed or changed their order.
+     */
+    void updateBootInfo(QList<JournaldHelper::BootInfo> bootInfo);
+
     std::unique_ptr<BootModelPrivate> d;
 };
 
@@ -7,6 +7,10 @@
 #define BOOT_MODEL_PRIVATE_H
 
 #include "journaldhelper.h"
+#include <QFutureWatcher>
+#include <QTimer>
+#include <chrono>
+#include <memory>
 
 class BootModelPrivate
 {
@@ -23,6 +27,10 @@ public:
     QVector<BootInfo> mBootInfo;
     IJournalProvider *mJournalProvider{nullptr};
     std::unique_ptr<SdJournal> mJournal;
+    QTimer mUpdateTimer; //!< coalesces journal updates, since boot times are only shown with minute precision
+    std::unique_ptr<QFutureWatcher<QList<BootInfo>>> mUpdateWatcher; //!< boot information query running on a worker thread
+
+    static constexpr std::chrono::milliseconds UPDATE_INTERVAL{5000};
 };
 
 QString BootModelPrivate::prettyPrintBoot(const BootInfo &bootInfo, TIME_FORMAT format)
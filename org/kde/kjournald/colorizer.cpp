@@ -1,32 +1,54 @@
 /*
     SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
-    SPDX-FileCopyrightText: 2021 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+    SPDX-FileCopyrightText: 2021-2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
 */
 
 #include "colorizer.h"
-#include <QMap>
+#include <array>
 #include <string_view>
 
-struct LineColor {
-    QColor foreground;
-    QColor background;
+namespace
+{
+struct Palette {
+    std::array<QColor, Colorizer::PALETTE_SIZE> foreground;
+    std::array<QColor, Colorizer::PALETTE_SIZE> background;
 };
 
-QColor Colorizer::color(const QString &key, COLOR_TYPE type)
+const Palette &palette()
 {
-    QColor color;
-    static QMap<QString, LineColor> sUnitToColorMap;
+    // initialization of function local statics is thread safe, afterwards the palette is read-only
+    static const Palette sPalette = [] {
+        Palette palette;
+        for (int hue = 0; hue < Colorizer::PALETTE_SIZE; ++hue) {
+            palette.foreground[hue] = QColor::fromHsl(hue, 220, 150);
+            palette.background[hue] = QColor::fromHsl(hue, 200, 220);
+        }
+        return palette;
+    }();
+    return sPalette;
+}
+}
 
-    auto needle = sUnitToColorMap.constFind(key);
-    if (needle != sUnitToColorMap.cend()) {
-        color = type == COLOR_TYPE::FOREGROUND ? needle->foreground : needle->background;
-    } else {
-        // uniformly project value into size_t area, then map to [0,255]
-        quint32 hue = std::hash<std::string_view>{}(key.toStdString().c_str()) % 256;
-        QColor foreground = QColor::fromHsl(hue, 220, 150);
-        QColor background = QColor::fromHsl(hue, 200, 220);
-        sUnitToColorMap[key] = {foreground, background};
-        color = type == COLOR_TYPE::FOREGROUND ? foreground : background;
+quint8 Colorizer::colorIndex(QByteArrayView key)
+{
+    if (key.isEmpty()) {
+        return 0;
     }
-    return color;
+    // uniformly project value into size_t area, then map to [0,255]
+    return std::hash<std::string_view>{}(std::string_view(key.data(), key.size())) % PALETTE_SIZE;
+}
+
+quint8 Colorizer::colorIndex(QStringView key)
+{
+    return colorIndex(QByteArrayView(key.toUtf8()));
+}
+
+QColor Colorizer::color(quint8 index, COLOR_TYPE type)
+{
+    return type == COLOR_TYPE::FOREGROUND ? palette().foreground[index] : palette().background[index];
+}
+
+QColor Colorizer::color(const QString &key, COLOR_TYPE type)
+{
+    return color(colorIndex(QStringView(key)), type);
 }
@@ -7,9 +7,17 @@
 #define COLORIZER_H
 
 #include "kjournald_export.h"
+#include <QByteArrayView>
 #include <QColor>
 #include <QString>
 
+/**
+ * @brief Maps keys like unit or process names to colors of a fixed palette
+ *
+ * The palette is created once and never modified afterwards, hence all methods are thread safe.
+ * Callers that color many items with few distinct keys should compute the palette index of each
+ * key once via colorIndex() and only store the index.
+ */
 class KJOURNALD_EXPORT Colorizer
 {
 public:
@@ -18,6 +26,19 @@ public:
         BACKGROUND,
     };
 
+    static constexpr int PALETTE_SIZE{256};
+
+    /**
+     * @return palette index for UTF-8 encoded @p key, empty keys map to index 0
+     */
+    static quint8 colorIndex(QByteArrayView key);
+    static quint8 colorIndex(QStringView key);
+
+    /**
+     * @return palette color at @p index
+     */
+    static QColor color(quint8 index, COLOR_TYPE = COLOR_TYPE::FOREGROUND);
+
     static QColor color(const QString &key, COLOR_TYPE = COLOR_TYPE::FOREGROUND);
 };
 
@@ -0,0 +1,74 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "exportjournal.h"
+#include "journalindex.h"
+#include "kjournaldlib_log_general.h"
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
+
+ExportJournal::ExportJournal(const QString &filePath, IndexMode mode)
+    : mFilePath(filePath)
+{
+    if (!filePath.endsWith(QLatin1String("export"))) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Provided export file has uncommon file ending that is not \".export\":" << filePath;
+    }
+    if (mode == IndexMode::Blocking) {
+        mIndex = std::make_shared<const JournalIndex>(filePath);
+        return;
+    }
+
+    // the index uses its own thread pool for parsing partitions, thus the worker only waits for them
+    mIndexCanceled = std::make_shared<std::atomic_bool>(false);
+    mIndexWatcher = std::make_unique<QFutureWatcher<std::shared_ptr<const JournalIndex>>>();
+    connect(mIndexWatcher.get(), &QFutureWatcherBase::finished, this, [this]() {
+        mIndex = mIndexWatcher->result();
+        qCDebug(KJOURNALDLIB_GENERAL) << "Indexed export file" << mFilePath << "with" << mIndex->size() << "entries";
+        Q_EMIT indexReady();
+    });
+    mIndexWatcher->setFuture(QtConcurrent::run([filePath, canceled = mIndexCanceled]() {
+        return std::make_shared<const JournalIndex>(filePath, QThread::idealThreadCount(), canceled.get());
+    }));
+}
+
+ExportJournal::~ExportJournal()
+{
+    if (mIndexWatcher && mIndexWatcher->isRunning()) {
+        // do not block the caller until the file is parsed, the worker stops at its next check and
+        // only holds its own references, the watcher deletes itself when the worker finished
+        mIndexCanceled->store(true);
+        mIndexWatcher->disconnect();
+        QFutureWatcher<std::shared_ptr<const JournalIndex>> *watcher = mIndexWatcher.release();
+        connect(watcher, &QFutureWatcherBase::finished, watcher, &QObject::deleteLater);
+    }
+}
+
+std::unique_ptr<SdJournal> ExportJournal::openJournal() const
+{
+    return nullptr;
+}
+
+std::shared_ptr<const JournalIndex> ExportJournal::journalIndex() const
+{
+    return mIndex;
+}
+
+QString ExportJournal::currentBootId() const
+{
+    return QString();
+}
+
+QFileInfoList ExportJournal::journalFiles() const
+{
+    return {QFileInfo(mFilePath)};
+}
+
+bool ExportJournal::isIndexReady() const
+{
+    return mIndex != nullptr;
+}
+
+#include "moc_exportjournal.cpp"
@@ -0,0 +1,94 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef EXPORTJOURNAL_H
+#define EXPORTJOURNAL_H
+
+#include "ijournalprovider.h"
+#include "kjournald_export.h"
+#include <QString>
+#include <atomic>
+#include <memory>
+
+class JournalIndex;
+template<typename T>
+class QFutureWatcher;
+
+/**
+ * @brief The ExportJournal class provides a journal from a file in systemd's export format
+ *
+ * In contrast to SystemdJournalRemote, no journald database is created from the export file. The file
+ * is memory mapped and indexed in place, such that neither the systemd-journal-remote helper binary
+ * nor a full copy of the journal is required.
+ *
+ * Indexing large export files takes seconds, thus it can be done in the background. Until the index is
+ * ready, journalIndex() returns nullptr and models stay empty; indexReady() signals that they can be
+ * populated.
+ */
+class KJOURNALD_EXPORT ExportJournal : public IJournalProvider
+{
+    Q_OBJECT
+    /**
+     * true once the export file is indexed and entries are available via journalIndex()
+     */
+    Q_PROPERTY(bool indexReady READ isIndexReady NOTIFY indexReady)
+
+public:
+    enum class IndexMode {
+        Blocking, //!< index export file in constructor
+        Background, //!< index export file in worker thread, see indexReady()
+    };
+
+    /**
+     * @brief Construct journal object from file containing logs in systemd's journal export format
+     */
+    explicit ExportJournal(const QString &filePath, IndexMode mode = IndexMode::Blocking);
+
+    /**
+     * @brief Destroys the journal
+     */
+    ~ExportJournal() override;
+
+    /**
+     * @brief Export journals are not backed by a journald database
+     * @return always nullptr, entries are accessed via journalIndex()
+     */
+    std::unique_ptr<SdJournal> openJournal() const override;
+
+    /**
+     * @copydoc IJournalProvider::journalIndex()
+     */
+    std::shared_ptr<const JournalIndex> journalIndex() const override;
+
+    /**
+     * @brief Export files do not contain information about the current boot
+     * @return always empty string
+     */
+    QString currentBootId() const override;
+
+    /**
+     * @copydoc IJournalProvider::journalFiles()
+     */
+    QFileInfoList journalFiles() const override;
+
+    /**
+     * @return true if the index is built, always true for IndexMode::Blocking
+     */
+    bool isIndexReady() const;
+
+Q_SIGNALS:
+    /**
+     * emitted once the background indexing finished, also if the export file could not be read
+     */
+    void indexReady();
+
+private:
+    QString mFilePath;
+    std::shared_ptr<const JournalIndex> mIndex;
+    std::unique_ptr<QFutureWatcher<std::shared_ptr<const JournalIndex>>> mIndexWatcher;
+    std::shared_ptr<std::atomic_bool> mIndexCanceled; //!< shared with the indexing worker, which may outlive this object
+};
+
+#endif // EXPORTJOURNAL_H
@@ -67,6 +67,16 @@ QJSValue FieldFilterProxyModel::get(int idx) const
     return value;
 }
 
+void FieldFilterProxyModel::multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const
+{
+    QAbstractItemModel *source = sourceModel();
+    if (!source || !index.isValid()) {
+        QSortFilterProxyModel::multiData(index, roleDataSpan);
+        return;
+    }
+    source->multiData(mapToSource(index), roleDataSpan);
+}
+
 void FieldFilterProxyModel::classBegin()
 {
 }
@@ -34,6 +34,13 @@ public:
 
     Q_INVOKABLE QJSValue get(int index) const;
 
+    /**
+     * @copydoc QAbstractItemModel::multiData()
+     *
+     * Forward batch role access to the source model.
+     */
+    void multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const override;
+
     void classBegin() override;
     void componentComplete() override;
 
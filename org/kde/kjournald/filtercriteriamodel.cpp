@@ -6,14 +6,43 @@
 #include "filtercriteriamodel.h"
 #include "filtercriteriamodel_p.h"
 #include "journaldhelper.h"
+#include "journalindex.h"
 #include "kjournaldlib_log_general.h"
+#include "uniquevaluescache.h"
 #include <KLocalizedString>
 #include <QDebug>
 #include <QDir>
 #include <QRegularExpression>
+#include <QSet>
+#include <QtConcurrentRun>
 #include <QString>
 #include <memory>
 
+namespace
+{
+/**
+ * @return unique entries whose values are the keys of @p counts
+ */
+UniqueEntries uniqueEntriesFromCounts(const UniqueValuesCache::ValueCounts &counts)
+{
+    UniqueEntries uniqueEntries;
+    uniqueEntries.mCounts = counts;
+    for (auto iter = counts.cbegin(); iter != counts.cend(); ++iter) {
+        uniqueEntries.mValues.insert(iter.key(), iter.value().keys());
+    }
+    return uniqueEntries;
+}
+
+/**
+ * fields that are counted for the filter criteria of a boot
+ */
+const QList<JournaldHelper::Field> COUNTED_FIELDS{JournaldHelper::Field::_SYSTEMD_UNIT,
+                                                  JournaldHelper::Field::_SYSTEMD_USER_UNIT,
+                                                  JournaldHelper::Field::_EXE,
+                                                  JournaldHelper::Field::PRIORITY,
+                                                  JournaldHelper::Field::_TRANSPORT};
+}
+
 QString FilterCriteriaModelPrivate::mapPriorityToString(qint32 priority)
 {
     switch (priority) {
@@ -39,48 +68,57 @@ QString FilterCriteriaModelPrivate::mapPriorityToString(qint32 priority)
     return QLatin1String("");
 }
 
-SelectionEntry::SelectionEntry(const QString &text,
-                               const QVariant &data,
-                               FilterCriteriaModel::Category category,
-                               bool selected,
-                               std::shared_ptr<SelectionEntry> parent)
-    : mText(text)
+SelectionEntry::SelectionEntry(const QString &text, const QVariant &data, FilterCriteriaModel::Category category, bool selected, int parent, int row)
+    : mParent(parent)
+    , mRow(row)
+    , mText(text)
     , mData(data)
-    , mCategory(category)
     , mSelected(selected)
-    , mParentItem(parent)
+    , mCategory(category)
 {
 }
 
-void SelectionEntry::appendChild(std::shared_ptr<SelectionEntry> item)
+int SelectionEntry::child(int row) const
 {
-    mChildItems.push_back(item);
+    if (row < 0 || row >= static_cast<int>(mChildren.size())) {
+        return -1;
+    }
+    return mChildren.at(row);
 }
 
-std::shared_ptr<SelectionEntry> SelectionEntry::child(int row)
+const std::vector<int> &SelectionEntry::children() const
 {
-    if (row < 0 || row >= mChildItems.size()) {
-        return nullptr;
-    }
-    return mChildItems.at(row);
+    return mChildren;
 }
 
 int SelectionEntry::childCount() const
 {
-    return mChildItems.size();
+    return mChildren.size();
+}
+
+int SelectionEntry::selectedChildCount() const
+{
+    return mSelectedChildren;
+}
+
+qint64 SelectionEntry::count() const
+{
+    return mCount;
+}
+
+void SelectionEntry::setCount(qint64 count)
+{
+    mCount = count;
 }
 
 int SelectionEntry::row() const
 {
-    auto parent = mParentItem.lock();
-    if (parent) {
-        for (int i = 0; i < parent->mChildItems.size(); ++i) {
-            if (parent->mChildItems.at(i).get() == this) {
-                return i;
-            }
-        }
-    }
-    return 0;
+    return mRow;
+}
+
+int SelectionEntry::parent() const
+{
+    return mParent;
 }
 
 int SelectionEntry::columnCount() const
@@ -103,6 +141,8 @@ QVariant SelectionEntry::data(FilterCriteriaModel::Roles role) const
         return QVariant::fromValue(mSelected);
     case FilterCriteriaModel::Roles::HAS_CHILDREN:
         return childCount() > 0;
+    case FilterCriteriaModel::Roles::COUNT:
+        return mCount >= 0 ? QVariant::fromValue(mCount) : QVariant();
     }
     return QVariant();
 }
@@ -117,14 +157,107 @@ bool SelectionEntry::setData(const QVariant &value, FilterCriteriaModel::Roles r
     return false;
 }
 
-std::shared_ptr<SelectionEntry> SelectionEntry::parentItem()
+SelectionTree::SelectionTree()
+{
+    clear();
+}
+
+void SelectionTree::clear()
+{
+    mEntries.clear();
+    mEntries.emplace_back();
+}
+
+int SelectionTree::appendChild(int parent, const QString &text, const QVariant &data, FilterCriteriaModel::Category category, bool selected)
+{
+    Q_ASSERT(parent >= 0 && parent < static_cast<int>(mEntries.size()));
+    const int index = mEntries.size();
+    const int row = mEntries[parent].mChildren.size();
+    mEntries.emplace_back(text, data, category, selected, parent, row);
+    mEntries[parent].mChildren.push_back(index);
+    if (selected) {
+        ++mEntries[parent].mSelectedChildren;
+    }
+    return index;
+}
+
+int SelectionTree::insertChild(int parent, int row, const QString &text, const QVariant &data, FilterCriteriaModel::Category category, bool selected)
+{
+    Q_ASSERT(parent >= 0 && parent < static_cast<int>(mEntries.size()));
+    Q_ASSERT(row >= 0 && row <= static_cast<int>(mEntries[parent].mChildren.size()));
+    const int index = mEntries.size();
+    mEntries.emplace_back(text, data, category, selected, parent, row);
+    std::vector<int> &children = mEntries[parent].mChildren;
+    children.insert(children.begin() + row, index);
+    for (int sibling = row + 1; sibling < static_cast<int>(children.size()); ++sibling) {
+        mEntries[children[sibling]].mRow = sibling;
+    }
+    if (selected) {
+        ++mEntries[parent].mSelectedChildren;
+    }
+    return index;
+}
+
+bool SelectionTree::setData(int index, const QVariant &value, FilterCriteriaModel::Roles role)
 {
-    return mParentItem.lock();
+    SelectionEntry &entry = mEntries[index];
+    const bool wasSelected = entry.mSelected;
+    if (!entry.setData(value, role)) {
+        return false;
+    }
+    if (entry.mParent >= 0 && wasSelected != entry.mSelected) {
+        mEntries[entry.mParent].mSelectedChildren += entry.mSelected ? 1 : -1;
+    }
+    return true;
 }
 
-FilterCriteriaModelPrivate::FilterCriteriaModelPrivate() = default;
+int SelectionTree::child(int parent, int row) const
+{
+    if (parent < 0 || parent >= static_cast<int>(mEntries.size())) {
+        return -1;
+    }
+    return mEntries[parent].child(row);
+}
 
-FilterCriteriaModelPrivate::~FilterCriteriaModelPrivate() = default;
+SelectionEntry &SelectionTree::entry(int index)
+{
+    return mEntries[index];
+}
+
+const SelectionEntry &SelectionTree::entry(int index) const
+{
+    return mEntries[index];
+}
+
+void SelectionTree::reserve(std::size_t size)
+{
+    mEntries.reserve(size);
+}
+
+std::size_t SelectionTree::size() const
+{
+    return mEntries.size();
+}
+
+FilterCriteriaModelPrivate::FilterCriteriaModelPrivate(FilterCriteriaModel *q)
+    : q(q)
+{
+    mRefreshTimer.setSingleShot(true);
+    mRefreshTimer.setInterval(REFRESH_INTERVAL);
+    QObject::connect(&mRefreshTimer, &QTimer::timeout, q, [this]() {
+        startUniqueEntriesRefresh();
+    });
+}
+
+FilterCriteriaModelPrivate::~FilterCriteriaModelPrivate()
+{
+    for (auto *watcher : {mUniqueEntriesWatcher.get(), mRefreshWatcher.get()}) {
+        if (watcher) {
+            watcher->disconnect();
+            watcher->cancel();
+        }
+    }
+}
 
 bool FilterCriteriaModelPrivate::isRebuildModelPending() const
 {
@@ -135,204 +268,570 @@ void FilterCriteriaModelPrivate::rebuildModel()
 {
     Q_ASSERT(!mQmlEngineIncubationActive);
     qCDebug(KJOURNALDLIB_GENERAL) << "Rebuilding filter criteria model for boot-id:" << mBootFilter.value_or(QString());
+    cancelUniqueEntriesQuery();
     mIndexMap = {0, 0, 0, 0, 0};
     quint32 rootIndex{0};
 
-    QMap<JournaldHelper::Field, QStringList> uniqueEntries;
-    if (!mBootFilter.has_value() || !mUniqueEntriesCache.contains(mBootFilter.value_or(QString()))) {
-        if (mJournal && JournaldHelper::queryUnique(mJournal->get(), JournaldHelper::Field::_BOOT_ID).contains(mBootFilter.value_or(QString()))) {
-            auto iter = mUniqueEntriesCache.insert(
-                mBootFilter.value_or(QString()),
-                JournaldHelper::queryUnique(mJournal->get(),
-                                            mBootFilter.value_or(QString()),
-                                            {JournaldHelper::Field::_SYSTEMD_UNIT, JournaldHelper::Field::_SYSTEMD_USER_UNIT, JournaldHelper::Field::_EXE}));
-
-            uniqueEntries = *iter;
-        } else {
-            qCWarning(KJOURNALDLIB_GENERAL) << "Skip filter criteria model build, boot-id not available:" << mBootFilter.value_or(QString());
-        }
-    } else {
-        uniqueEntries = mUniqueEntriesCache.value(mBootFilter.value_or(QString()));
-        qCDebug(KJOURNALDLIB_GENERAL) << "Populate filter criteria model from cache for boot-id:" << mBootFilter.value_or(QString());
-    }
-
-    mRootItem = std::make_unique<SelectionEntry>();
-    mUniqueServiceUnitCache.clear();
+    mTree.clear();
+    mTemplateGroupInstances.clear();
+    invalidateUnitFilterCache();
     {
-        auto parent = std::make_shared<SelectionEntry>(i18nc("Section title for log message source", "Transport"),
-                                                       QVariant(),
-                                                       FilterCriteriaModel::Category::TRANSPORT,
-                                                       false,
-                                                       mRootItem);
-        mRootItem->appendChild(parent);
-        mRootItem->child(rootIndex)->appendChild(std::move(std::make_unique<SelectionEntry>(i18nc("Checkbox option for kernel log messages", "Kernel"),
-                                                                                            QLatin1String("kernel"),
-                                                                                            FilterCriteriaModel::Category::TRANSPORT,
-                                                                                            false,
-                                                                                            parent)));
+        const int parent = mTree.appendChild(SelectionTree::ROOT,
+                                             i18nc("Section title for log message source", "Transport"),
+                                             QVariant(),
+                                             FilterCriteriaModel::Category::TRANSPORT);
+        mTree.appendChild(parent, i18nc("Checkbox option for kernel log messages", "Kernel"), QLatin1String("kernel"), FilterCriteriaModel::Category::TRANSPORT);
         mIndexMap[FilterCriteriaModel::Category::TRANSPORT] = rootIndex;
         ++rootIndex;
     }
     {
-        auto parent = std::make_shared<SelectionEntry>(i18nc("Section title for log message priority", "Priority"),
-                                                       QVariant(),
-                                                       FilterCriteriaModel::Category::PRIORITY,
-                                                       false,
-                                                       mRootItem);
-        mRootItem->appendChild(parent);
+        const int parent = mTree.appendChild(SelectionTree::ROOT,
+                                             i18nc("Section title for log message priority", "Priority"),
+                                             QVariant(),
+                                             FilterCriteriaModel::Category::PRIORITY);
         for (int i = 0; i <= 7; ++i) {
-            mRootItem->child(rootIndex)->appendChild(
-                std::move(std::make_unique<SelectionEntry>(mapPriorityToString(i),
-                                                           QString::number(i),
-                                                           FilterCriteriaModel::Category::PRIORITY,
-                                                           mPriorityLevel.has_value() && i == mPriorityLevel.value() ? true : false,
-                                                           parent)));
+            mTree.appendChild(parent,
+                              mapPriorityToString(i),
+                              QString::number(i),
+                              FilterCriteriaModel::Category::PRIORITY,
+                              mPriorityLevel.has_value() && i == mPriorityLevel.value() ? true : false);
             // magic index 8 means "unset priority"
         }
         // add "no filter" option at end
-        mRootItem->child(rootIndex)->appendChild(std::move(std::make_unique<SelectionEntry>(mapPriorityToString(-1),
-                                                                                            QString::number(-1),
-                                                                                            FilterCriteriaModel::Category::PRIORITY,
-                                                                                            !mPriorityLevel.has_value() || 8 == mPriorityLevel,
-                                                                                            parent)));
+        mTree.appendChild(parent,
+                          mapPriorityToString(-1),
+                          QString::number(-1),
+                          FilterCriteriaModel::Category::PRIORITY,
+                          !mPriorityLevel.has_value() || 8 == mPriorityLevel);
         mIndexMap[FilterCriteriaModel::Category::PRIORITY] = rootIndex;
         ++rootIndex;
     }
     if (mLogViewMode == FilterCriteriaModel::LogViewMode::ALL_LOGS || mLogViewMode == FilterCriteriaModel::LogViewMode::ONLY_USER) {
-        auto parent = std::make_shared<SelectionEntry>(i18nc("Section title for systemd user unit", "User Unit"),
-                                                       QVariant(),
-                                                       FilterCriteriaModel::Category::SYSTEMD_USER_UNIT,
-                                                       false,
-                                                       mRootItem);
-        mRootItem->appendChild(parent);
-        if (mJournal) {
-            QStringList units = uniqueEntries.value(JournaldHelper::Field::_SYSTEMD_USER_UNIT);
-            mUniqueServiceUnitCache.append(units);
-
-            if (mGroupTemplatedSystemdUnits) {
-                // systemd templates use '@' as delimiter between service name and the argument
-                for (auto it = units.begin(); it != units.end(); it++) {
-                    static const QRegularExpression templateArgumentExpr(QLatin1String("@.+\\.service"));
-                    it->replace(templateArgumentExpr, FilterCriteriaModelPrivate::GROUPED_SERVICE_SUFFIX);
-                }
+        mTree.appendChild(SelectionTree::ROOT,
+                          i18nc("Section title for systemd user unit", "User Unit"),
+                          QVariant(),
+                          FilterCriteriaModel::Category::SYSTEMD_USER_UNIT);
+        mIndexMap[FilterCriteriaModel::Category::SYSTEMD_USER_UNIT] = rootIndex;
+        ++rootIndex;
+    } else {
+        mIndexMap[FilterCriteriaModel::Category::SYSTEMD_USER_UNIT] = -1;
+    }
+    if (mLogViewMode == FilterCriteriaModel::LogViewMode::ALL_LOGS || mLogViewMode == FilterCriteriaModel::LogViewMode::ONLY_SYSTEM) {
+        mTree.appendChild(SelectionTree::ROOT,
+                          i18nc("Section title for systemd sytem unit", "System Unit"),
+                          QVariant(),
+                          FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT);
+        mIndexMap[FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT] = rootIndex;
+        ++rootIndex;
+    } else {
+        mIndexMap[FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT] = -1;
+    }
+    {
+        mTree.appendChild(SelectionTree::ROOT, i18nc("Section title for process list", "Process"), QVariant(), FilterCriteriaModel::Category::EXE);
+        mIndexMap[FilterCriteriaModel::Category::EXE] = rootIndex;
+        ++rootIndex;
+    }
+
+    if (!mJournal && !(mJournalProvider && mJournalProvider->journalIndex())) {
+        return;
+    }
+    const QString bootId = mBootFilter.value_or(QString());
+    if (mBootFilter.has_value() && mUniqueEntriesCache.contains(bootId)) {
+        qCDebug(KJOURNALDLIB_GENERAL) << "Populate filter criteria model from cache for boot-id:" << bootId;
+        const UniqueValuesCache::UniqueValues uniqueEntries = mUniqueEntriesCache.value(bootId);
+        const UniqueValuesCache::ValueCounts counts = mUniqueEntryCountsCache.value(bootId);
+        for (const auto category : {FilterCriteriaModel::Category::SYSTEMD_USER_UNIT,
+                                    FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT,
+                                    FilterCriteriaModel::Category::EXE}) {
+            if (mIndexMap[category] >= 0) {
+                appendCategoryEntries(category, categoryValues(category, uniqueEntries));
             }
+        }
+        for (const auto category : {FilterCriteriaModel::Category::TRANSPORT,
+                                    FilterCriteriaModel::Category::PRIORITY,
+                                    FilterCriteriaModel::Category::SYSTEMD_USER_UNIT,
+                                    FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT,
+                                    FilterCriteriaModel::Category::EXE}) {
+            applyEntryCounts(category, counts, false);
+        }
+    } else if (mBootFilter.has_value()) {
+        startUniqueEntriesQuery(bootId);
+    } else {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Skip filter criteria model build, boot-id not available:" << bootId;
+    }
+}
 
-            units.erase(std::remove_if(std::begin(units),
-                                       std::end(units),
-                                       [](QStringView unit) {
-                                           return unit.startsWith(QLatin1String("systemd-coredump@"))
-                                               || unit.startsWith(QLatin1String("drkonqi-coredump-processor@"))
-                                               || unit.startsWith(QLatin1String("drkonqi-coredump-launcher@"));
-                                       }),
-                        std::end(units));
-            std::sort(std::begin(units), std::end(units), [](const QString &a, const QString &b) {
-                return QString::compare(a, b, Qt::CaseInsensitive) <= 0;
-            });
-            // duplicates might come from template grouping
-            units.erase(std::unique(std::begin(units), std::end(units)), std::end(units));
+void FilterCriteriaModelPrivate::startUniqueEntriesQuery(const QString &bootId)
+{
+    Q_ASSERT(mJournalProvider);
+    // sd_journal objects must not be shared between threads, hence the worker uses its own one
+    // indexed journals are held in memory, thus they are counted directly without persistent cache
+    const std::shared_ptr<const JournalIndex> index = mJournalProvider->journalIndex();
+    std::shared_ptr<SdJournal> journal = index ? nullptr : mJournalProvider->openJournal();
+    const QByteArray journalIdentity = mJournalIdentity;
+    const bool isCurrentBoot = mJournalProvider->currentBootId() == bootId;
 
-            for (const auto &unit : std::as_const(units)) {
-                // skip any non-service units, because we expect users only be interested in filtering those
-                if (!unit.endsWith(QLatin1String(".service"))) {
-                    continue;
+    QFuture<UniqueEntries> future = QtConcurrent::run([journal, index, bootId, journalIdentity, isCurrentBoot](QPromise<UniqueEntries> &promise) {
+        if (promise.isCanceled()) {
+            return;
+        }
+        if (index) {
+            promise.addResult(uniqueEntriesFromCounts(index->uniqueCounts(bootId, COUNTED_FIELDS)));
+            return;
+        }
+        if (!journal || !journal->isValid()) {
+            return;
+        }
+        if (!JournaldHelper::queryUnique(journal->get(), JournaldHelper::Field::_BOOT_ID).contains(bootId)) {
+            qCWarning(KJOURNALDLIB_GENERAL) << "Skip filter criteria model build, boot-id not available:" << bootId;
+            return;
+        }
+        // entries of finished boots are immutable, thus their unique values can be persisted
+        std::optional<JournaldHelper::BootInfo> bootInfo;
+        if (!isCurrentBoot && !journalIdentity.isEmpty()) {
+            bootInfo = JournaldHelper::queryBootInfo(journal->get(), bootId);
+            if (bootInfo) {
+                UniqueEntries cachedEntries;
+                if (auto cachedValues = UniqueValuesCache::load(journalIdentity, bootInfo.value(), &cachedEntries.mCounts)) {
+                    qCDebug(KJOURNALDLIB_GENERAL) << "Populate filter criteria model from persistent cache for boot-id:" << bootId;
+                    cachedEntries.mValues = cachedValues.value();
+                    promise.addResult(cachedEntries);
+                    return;
                 }
-                mRootItem->child(rootIndex)->appendChild(std::move(std::make_unique<SelectionEntry>(JournaldHelper::cleanupString(unit),
-                                                                                                    unit,
-                                                                                                    FilterCriteriaModel::Category::SYSTEMD_USER_UNIT,
-                                                                                                    false,
-                                                                                                    parent)));
             }
         }
-        mIndexMap[FilterCriteriaModel::Category::SYSTEMD_USER_UNIT] = rootIndex;
-        ++rootIndex;
+        // unique values are read from the field hash tables of the journal files with O(distinct values) and
+        // are published first, the counts require a pass over all entries of the boot and follow as second result
+        UniqueEntries uniqueValues;
+        uniqueValues.mValues = JournaldHelper::queryUnique(journal->get(), bootId, COUNTED_FIELDS);
+        promise.addResult(uniqueValues);
+        if (promise.isCanceled()) {
+            return;
+        }
+        QString cursor;
+        UniqueEntries uniqueEntries = uniqueEntriesFromCounts(JournaldHelper::queryUniqueCounts(journal->get(), bootId, COUNTED_FIELDS, QString(), &cursor));
+        uniqueEntries.mCursor = cursor;
+        if (bootInfo) {
+            UniqueValuesCache::store(journalIdentity, bootInfo.value(), uniqueEntries.mValues, uniqueEntries.mCounts);
+        }
+        promise.addResult(uniqueEntries);
+    });
+
+    mUniqueEntriesWatcher = std::make_unique<QFutureWatcher<UniqueEntries>>();
+    QObject::connect(mUniqueEntriesWatcher.get(), &QFutureWatcherBase::resultReadyAt, q, [this, bootId](int resultIndex) {
+        const UniqueEntries uniqueEntries = mUniqueEntriesWatcher->resultAt(resultIndex);
+        if (resultIndex == 0) {
+            applyUniqueEntries(bootId, uniqueEntries);
+        } else {
+            // counts for the already shown values, values of entries that were added meanwhile are inserted
+            mergeUniqueEntries(bootId, uniqueEntries, true);
+        }
+    });
+    QObject::connect(mUniqueEntriesWatcher.get(), &QFutureWatcherBase::finished, q, [this]() {
+        // watcher must not be deleted while emitting the signal
+        mUniqueEntriesWatcher.release()->deleteLater();
+        Q_EMIT q->loadingChanged();
+    });
+    mUniqueEntriesWatcher->setFuture(future);
+    Q_EMIT q->loadingChanged();
+}
+
+void FilterCriteriaModelPrivate::cancelUniqueEntriesQuery()
+{
+    mRefreshTimer.stop();
+    if (mRefreshWatcher) {
+        mRefreshWatcher->disconnect();
+        mRefreshWatcher->cancel();
+        mRefreshWatcher.reset();
+    }
+    if (!mUniqueEntriesWatcher) {
+        return;
+    }
+    qCDebug(KJOURNALDLIB_GENERAL) << "Cancel superseded unique entries query";
+    // the worker only holds its own journal, thus it can finish detached from this model
+    mUniqueEntriesWatcher->disconnect();
+    mUniqueEntriesWatcher->cancel();
+    mUniqueEntriesWatcher.reset();
+    Q_EMIT q->loadingChanged();
+}
+
+void FilterCriteriaModelPrivate::applyUniqueEntries(const QString &bootId, const UniqueEntries &uniqueEntries)
+{
+    mUniqueEntriesCache.insert(bootId, uniqueEntries.mValues);
+    mUniqueEntryCountsCache.insert(bootId, uniqueEntries.mCounts);
+    if (uniqueEntries.mCursor.isEmpty()) {
+        mUniqueEntriesCursorCache.remove(bootId);
     } else {
-        mIndexMap[FilterCriteriaModel::Category::SYSTEMD_USER_UNIT] = -1;
+        mUniqueEntriesCursorCache.insert(bootId, uniqueEntries.mCursor);
     }
-    if (mLogViewMode == FilterCriteriaModel::LogViewMode::ALL_LOGS || mLogViewMode == FilterCriteriaModel::LogViewMode::ONLY_SYSTEM) {
-        auto parent = std::make_shared<SelectionEntry>(i18nc("Section title for systemd sytem unit", "System Unit"),
-                                                       QVariant(),
-                                                       FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT,
-                                                       false,
-                                                       mRootItem);
-        mRootItem->appendChild(parent);
-        if (mJournal) {
-            QStringList units = uniqueEntries.value(JournaldHelper::Field::_SYSTEMD_UNIT);
-            mUniqueServiceUnitCache.append(units);
-
-            if (mGroupTemplatedSystemdUnits) {
-                // systemd templates use '@' as delimiter between service name and the argument
-                for (auto it = units.begin(); it != units.end(); it++) {
-                    static const QRegularExpression templateArgumentExpr(QLatin1String("@.+\\.service"));
-                    it->replace(templateArgumentExpr, FilterCriteriaModelPrivate::GROUPED_SERVICE_SUFFIX);
-                }
+    if (mBootFilter.value_or(QString()) != bootId) {
+        return;
+    }
+    invalidateUnitFilterCache();
+    for (const auto category : {FilterCriteriaModel::Category::SYSTEMD_USER_UNIT, FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT, FilterCriteriaModel::Category::EXE}) {
+        if (mIndexMap[category] < 0) {
+            continue;
+        }
+        const QStringList values = categoryValues(category, uniqueEntries.mValues);
+        if (values.isEmpty()) {
+            continue;
+        }
+        const QModelIndex parentIndex = q->index(mIndexMap[category], 0);
+        const int firstRow = mTree.entry(categoryEntry(category)).childCount();
+        q->beginInsertRows(parentIndex, firstRow, firstRow + values.size() - 1);
+        appendCategoryEntries(category, values);
+        applyEntryCounts(category, uniqueEntries.mCounts, false);
+        q->endInsertRows();
+    }
+    // entries of these categories exist before the query finished
+    applyEntryCounts(FilterCriteriaModel::Category::TRANSPORT, uniqueEntries.mCounts, true);
+    applyEntryCounts(FilterCriteriaModel::Category::PRIORITY, uniqueEntries.mCounts, true);
+}
+
+void FilterCriteriaModelPrivate::startUniqueEntriesRefresh()
+{
+    // indexed journals do not change and boots without unique entries are not shown yet
+    if (!mJournalProvider || mJournalProvider->journalIndex() || !mBootFilter.has_value() || !mUniqueEntriesCache.contains(mBootFilter.value())) {
+        return;
+    }
+    if (mUniqueEntriesWatcher || mRefreshWatcher) {
+        mRefreshTimer.start();
+        return;
+    }
+    const QString bootId = mBootFilter.value();
+    const QString cursor = mUniqueEntriesCursorCache.value(bootId);
+    std::shared_ptr<SdJournal> journal = mJournalProvider->openJournal();
+
+    QFuture<UniqueEntries> future = QtConcurrent::run([journal, bootId, cursor]() {
+        if (!journal || !journal->isValid()) {
+            return UniqueEntries();
+        }
+        QString lastCursor;
+        UniqueEntries uniqueEntries = uniqueEntriesFromCounts(JournaldHelper::queryUniqueCounts(journal->get(), bootId, COUNTED_FIELDS, cursor, &lastCursor));
+        uniqueEntries.mCursor = lastCursor;
+        return uniqueEntries;
+    });
+
+    mRefreshWatcher = std::make_unique<QFutureWatcher<UniqueEntries>>();
+    QObject::connect(mRefreshWatcher.get(), &QFutureWatcherBase::finished, q, [this, bootId, replace = cursor.isEmpty()]() {
+        // watcher must not be deleted while emitting the signal
+        QFutureWatcher<UniqueEntries> *watcher = mRefreshWatcher.release();
+        watcher->deleteLater();
+        if (watcher->future().resultCount() > 0) {
+            mergeUniqueEntries(bootId, watcher->future().result(), replace);
+        }
+    });
+    mRefreshWatcher->setFuture(future);
+}
+
+void FilterCriteriaModelPrivate::mergeUniqueEntries(const QString &bootId, const UniqueEntries &uniqueEntries, bool replace)
+{
+    if (uniqueEntries.mCursor.isEmpty()) {
+        // no entries were counted
+        return;
+    }
+    mUniqueEntriesCursorCache.insert(bootId, uniqueEntries.mCursor);
+    UniqueValuesCache::ValueCounts &counts = mUniqueEntryCountsCache[bootId];
+    UniqueValuesCache::UniqueValues &values = mUniqueEntriesCache[bootId];
+    if (replace) {
+        counts.clear();
+    }
+    for (auto fieldIter = uniqueEntries.mCounts.cbegin(); fieldIter != uniqueEntries.mCounts.cend(); ++fieldIter) {
+        QHash<QString, quint64> &fieldCounts = counts[fieldIter.key()];
+        QStringList &fieldValues = values[fieldIter.key()];
+        // lookup set avoids quadratic list searches when large boots are refreshed
+        QSet<QString> knownValues(fieldValues.cbegin(), fieldValues.cend());
+        for (auto iter = fieldIter.value().cbegin(); iter != fieldIter.value().cend(); ++iter) {
+            if (!knownValues.contains(iter.key())) {
+                knownValues.insert(iter.key());
+                fieldValues.append(iter.key());
             }
+            fieldCounts[iter.key()] += iter.value();
+        }
+    }
+    if (mBootFilter.value_or(QString()) != bootId) {
+        return;
+    }
+    invalidateUnitFilterCache();
+    for (const auto category : {FilterCriteriaModel::Category::SYSTEMD_USER_UNIT, FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT, FilterCriteriaModel::Category::EXE}) {
+        if (mIndexMap[category] >= 0) {
+            insertCategoryEntries(category, categoryValues(category, uniqueEntries.mValues));
+        }
+    }
+    for (const auto category : {FilterCriteriaModel::Category::TRANSPORT,
+                                FilterCriteriaModel::Category::PRIORITY,
+                                FilterCriteriaModel::Category::SYSTEMD_USER_UNIT,
+                                FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT,
+                                FilterCriteriaModel::Category::EXE}) {
+        applyEntryCounts(category, counts, true);
+    }
+}
 
-            units.erase(std::remove_if(std::begin(units),
-                                       std::end(units),
-                                       [](QStringView unit) {
-                                           return unit.startsWith(QLatin1String("systemd-coredump@"))
-                                               || unit.startsWith(QLatin1String("drkonqi-coredump-processor@"))
-                                               || unit.startsWith(QLatin1String("drkonqi-coredump-launcher@"));
-                                       }),
-                        std::end(units));
-            std::sort(std::begin(units), std::end(units), [](const QString &a, const QString &b) {
-                return QString::compare(a, b, Qt::CaseInsensitive) <= 0;
-            });
-            // duplicates might come from template grouping
-            units.erase(std::unique(std::begin(units), std::end(units)), std::end(units));
+QStringList FilterCriteriaModelPrivate::categoryValues(FilterCriteriaModel::Category category, const UniqueValuesCache::UniqueValues &uniqueEntries)
+{
+    if (category == FilterCriteriaModel::Category::EXE) {
+        QStringList exes = uniqueEntries.value(JournaldHelper::Field::_EXE);
+        std::sort(std::begin(exes), std::end(exes), [](const QString &a, const QString &b) {
+            return QString::compare(a, b, Qt::CaseInsensitive) <= 0;
+        });
+        return exes;
+    }
+
+    QStringList units = uniqueEntries.value(category == FilterCriteriaModel::Category::SYSTEMD_USER_UNIT ? JournaldHelper::Field::_SYSTEMD_USER_UNIT
+                                                                                                         : JournaldHelper::Field::_SYSTEMD_UNIT);
 
-            for (const auto &unit : std::as_const(units)) {
-                // skip any non-service units, because we expect users only be interested in filtering those
-                if (!unit.endsWith(QLatin1String(".service"))) {
-                    continue;
+    if (mGroupTemplatedSystemdUnits) {
+        // systemd templates use '@' as delimiter between service name and the argument
+        QHash<QString, QStringList> &groupInstances = mTemplateGroupInstances[category];
+        for (auto it = units.begin(); it != units.end(); it++) {
+            const JournaldHelper::UnitName unitName = mUnitNameCache.normalize(*it);
+            if (unitName.isTemplateInstance()) {
+                const QString group = unitName.mTemplate.left(unitName.mTemplate.indexOf(QLatin1Char('@'))) + GROUPED_SERVICE_SUFFIX;
+                // instances are already known if values are merged for new journal entries
+                if (!groupInstances[group].contains(*it)) {
+                    groupInstances[group].append(*it);
                 }
-                mRootItem->child(rootIndex)->appendChild(std::move(std::make_unique<SelectionEntry>(JournaldHelper::cleanupString(unit),
-                                                                                                    unit,
-                                                                                                    FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT,
-                                                                                                    false,
-                                                                                                    parent)));
+                *it = group;
             }
         }
-        mIndexMap[FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT] = rootIndex;
-        ++rootIndex;
-    } else {
-        mIndexMap[FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT] = -1;
     }
-    {
-        auto parent = std::make_shared<SelectionEntry>(i18nc("Section title for process list", "Process"),
-                                                       QVariant(),
-                                                       FilterCriteriaModel::Category::EXE,
-                                                       false,
-                                                       mRootItem);
-        mRootItem->appendChild(parent);
-        if (mJournal) {
-            QStringList exes = uniqueEntries.value(JournaldHelper::Field::_EXE);
-            std::sort(std::begin(exes), std::end(exes), [](const QString &a, const QString &b) {
-                return QString::compare(a, b, Qt::CaseInsensitive) <= 0;
-            });
-            for (const auto &exe : std::as_const(exes)) {
-                mRootItem->child(rootIndex)->appendChild(
-                    std::move(std::make_unique<SelectionEntry>(JournaldHelper::cleanupString(exe), exe, FilterCriteriaModel::Category::EXE, false, parent)));
+
+    units.erase(std::remove_if(std::begin(units),
+                               std::end(units),
+                               [](QStringView unit) {
+                                   // skip any non-service units, because we expect users only be interested in filtering those
+                                   return !unit.endsWith(QLatin1String(".service")) || unit.startsWith(QLatin1String("systemd-coredump@"))
+                                       || unit.startsWith(QLatin1String("drkonqi-coredump-processor@"))
+                                       || unit.startsWith(QLatin1String("drkonqi-coredump-launcher@"));
+                               }),
+                std::end(units));
+    std::sort(std::begin(units), std::end(units), [](const QString &a, const QString &b) {
+        return QString::compare(a, b, Qt::CaseInsensitive) <= 0;
+    });
+    // duplicates might come from template grouping
+    units.erase(std::unique(std::begin(units), std::end(units)), std::end(units));
+    return units;
+}
+
+void FilterCriteriaModelPrivate::appendCategoryEntries(FilterCriteriaModel::Category category, const QStringList &values)
+{
+    const int parent = categoryEntry(category);
+    mTree.reserve(mTree.size() + values.size());
+    for (const auto &value : values) {
+        mTree.appendChild(parent, JournaldHelper::cleanupString(value), value, category);
+    }
+}
+
+void FilterCriteriaModelPrivate::insertCategoryEntries(FilterCriteriaModel::Category category, const QStringList &values)
+{
+    const int parent = categoryEntry(category);
+    const QModelIndex parentIndex = q->index(mIndexMap[category], 0);
+    auto entryValue = [this](int child) {
+        return mTree.entry(child).data(FilterCriteriaModel::Roles::DATA).toString();
+    };
+    for (const QString &value : values) {
+        const std::vector<int> &children = mTree.entry(parent).children();
+        // children are sorted case insensitively, thus equal values are within the range of case insensitive matches
+        auto position = std::lower_bound(children.cbegin(), children.cend(), value, [&entryValue](int child, const QString &value) {
+            return QString::compare(entryValue(child), value, Qt::CaseInsensitive) < 0;
+        });
+        const int row = std::distance(children.cbegin(), position);
+        bool exists{false};
+        for (; position != children.cend() && QString::compare(entryValue(*position), value, Qt::CaseInsensitive) == 0; ++position) {
+            exists = exists || entryValue(*position) == value;
+        }
+        if (exists) {
+            continue;
+        }
+        q->beginInsertRows(parentIndex, row, row);
+        mTree.insertChild(parent, row, JournaldHelper::cleanupString(value), value, category);
+        q->endInsertRows();
+    }
+}
+
+JournaldHelper::Field FilterCriteriaModelPrivate::categoryField(FilterCriteriaModel::Category category)
+{
+    switch (category) {
+    case FilterCriteriaModel::Category::TRANSPORT:
+        return JournaldHelper::Field::_TRANSPORT;
+    case FilterCriteriaModel::Category::PRIORITY:
+        return JournaldHelper::Field::PRIORITY;
+    case FilterCriteriaModel::Category::SYSTEMD_USER_UNIT:
+        return JournaldHelper::Field::_SYSTEMD_USER_UNIT;
+    case FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT:
+        return JournaldHelper::Field::_SYSTEMD_UNIT;
+    case FilterCriteriaModel::Category::EXE:
+        return JournaldHelper::Field::_EXE;
+    }
+    return JournaldHelper::Field::_EXE;
+}
+
+void FilterCriteriaModelPrivate::applyEntryCounts(FilterCriteriaModel::Category category, const UniqueValuesCache::ValueCounts &counts, bool notify)
+{
+    const int parent = categoryEntry(category);
+    if (parent < 0 || !counts.contains(categoryField(category))) {
+        return;
+    }
+    const QHash<QString, quint64> fieldCounts = counts.value(categoryField(category));
+    const QHash<QString, QStringList> groupInstances = mTemplateGroupInstances.value(category);
+    const std::vector<int> &children = mTree.entry(parent).children();
+    for (const int child : children) {
+        SelectionEntry &entry = mTree.entry(child);
+        const QString value = entry.data(FilterCriteriaModel::Roles::DATA).toString();
+        qint64 count{0};
+        if (category == FilterCriteriaModel::Category::PRIORITY && value == QLatin1String("-1")) {
+            for (const quint64 priorityCount : fieldCounts) {
+                count += priorityCount;
             }
+        } else if (auto groupIter = groupInstances.constFind(value); groupIter != groupInstances.cend()) {
+            for (const QString &instance : groupIter.value()) {
+                count += fieldCounts.value(instance);
+            }
+        } else {
+            count = fieldCounts.value(value);
         }
-        mIndexMap[FilterCriteriaModel::Category::EXE] = rootIndex;
-        ++rootIndex;
+        entry.setCount(count);
+    }
+    if (notify && !children.empty()) {
+        const QModelIndex parentIndex = q->index(mIndexMap[category], 0);
+        Q_EMIT q->dataChanged(q->index(0, 0, parentIndex),
+                              q->index(static_cast<int>(children.size()) - 1, 0, parentIndex),
+                              {FilterCriteriaModel::Roles::COUNT});
+    }
+}
+
+int FilterCriteriaModelPrivate::applySelection(FilterCriteriaModel::Category category, const std::function<bool(const SelectionEntry &)> &selector)
+{
+    if (category == FilterCriteriaModel::Category::PRIORITY) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Bulk selection not supported for exclusive priority selection";
+        return 0;
+    }
+    const int parent = categoryEntry(category);
+    if (parent < 0) {
+        return 0;
+    }
+
+    int changed{0};
+    int firstRow{-1};
+    int lastRow{-1};
+    const std::vector<int> &children = mTree.entry(parent).children();
+    for (int row = 0; row < static_cast<int>(children.size()); ++row) {
+        const SelectionEntry &entry = mTree.entry(children.at(row));
+        const bool selected = selector(entry);
+        if (selected == entry.data(FilterCriteriaModel::SELECTED).toBool()) {
+            continue;
+        }
+        mTree.setData(children.at(row), selected, FilterCriteriaModel::SELECTED);
+        firstRow = firstRow < 0 ? row : firstRow;
+        lastRow = row;
+        ++changed;
+    }
+    if (changed == 0) {
+        return 0;
+    }
+
+    const QModelIndex parentIndex = q->index(mTree.entry(parent).row(), 0);
+    Q_EMIT q->dataChanged(q->index(firstRow, 0, parentIndex), q->index(lastRow, 0, parentIndex), {FilterCriteriaModel::SELECTED});
+    const bool parentSelected = mTree.entry(parent).selectedChildCount() > 0;
+    if (parentSelected != mTree.entry(parent).data(FilterCriteriaModel::SELECTED).toBool()) {
+        mTree.setData(parent, parentSelected, FilterCriteriaModel::SELECTED);
+        Q_EMIT q->dataChanged(parentIndex, parentIndex, {FilterCriteriaModel::SELECTED});
+    }
+    notifyFilterChanged(category);
+    return changed;
+}
+
+QStringList FilterCriteriaModelPrivate::unitFilter(FilterCriteriaModel::Category category) const
+{
+    auto cachedFilter = mUnitFilterCache.constFind(category);
+    if (cachedFilter != mUnitFilterCache.cend()) {
+        return cachedFilter.value();
+    }
+
+    const int parent = categoryEntry(category);
+    if (parent < 0) {
+        return {};
+    }
+    const QHash<QString, QStringList> groupInstances = mTemplateGroupInstances.value(category);
+    QStringList entries;
+    for (const int child : mTree.entry(parent).children()) {
+        const SelectionEntry &entry = mTree.entry(child);
+        if (entry.data(FilterCriteriaModel::SELECTED).toBool()) {
+            const QString identifier = entry.data(FilterCriteriaModel::DATA).toString();
+            auto instances = groupInstances.constFind(identifier);
+            if (mGroupTemplatedSystemdUnits && instances != groupInstances.cend()) {
+                entries.append(instances.value());
+            } else {
+                entries.append(identifier);
+            }
+        }
+    }
+    mUnitFilterCache.insert(category, entries);
+    return entries;
+}
+
+void FilterCriteriaModelPrivate::invalidateUnitFilterCache()
+{
+    mUnitFilterCache.clear();
+}
+
+void FilterCriteriaModelPrivate::notifyFilterChanged(FilterCriteriaModel::Category category)
+{
+    if (category == FilterCriteriaModel::Category::SYSTEMD_USER_UNIT || category == FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT) {
+        mUnitFilterCache.remove(category);
+    }
+    switch (category) {
+    case FilterCriteriaModel::Category::SYSTEMD_USER_UNIT:
+        Q_EMIT q->systemdUserUnitFilterChanged();
+        break;
+    case FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT:
+        Q_EMIT q->systemdSystemUnitFilterChanged();
+        break;
+    case FilterCriteriaModel::Category::EXE:
+        Q_EMIT q->exeFilterChanged();
+        break;
+    case FilterCriteriaModel::Category::TRANSPORT:
+        Q_EMIT q->kernelFilterChanged();
+        break;
+    case FilterCriteriaModel::Category::PRIORITY:
+        Q_EMIT q->priorityFilterChanged(static_cast<qint8>(mPriorityLevel.value_or(-1)));
+        break;
     }
 }
 
+int FilterCriteriaModelPrivate::categoryEntry(FilterCriteriaModel::Category category) const
+{
+    if (mIndexMap.empty() || mIndexMap[category] < 0) {
+        return -1;
+    }
+    return mTree.child(SelectionTree::ROOT, mIndexMap[category]);
+}
+
 FilterCriteriaModel::FilterCriteriaModel(QObject *parent)
     : QAbstractItemModel(parent)
-    , d(new FilterCriteriaModelPrivate)
+    , d(new FilterCriteriaModelPrivate(this))
 {
 }
 
 void FilterCriteriaModel::setJournalProvider(IJournalProvider *provider)
 {
     d->mJournalProvider = provider;
+    d->mRefreshTimer.stop();
+    // cursors are only meaningful for the journal they were obtained from
+    d->mUniqueEntriesCursorCache.clear();
     if (provider) {
         d->mJournal = provider->openJournal();
+        d->mJournalIdentity = UniqueValuesCache::journalIdentity(provider->journalFiles());
+        if (d->mJournal) {
+            connect(d->mJournal.get(), &SdJournal::journalUpdated, this, [this]() {
+                if (!d->mRefreshTimer.isActive()) {
+                    d->mRefreshTimer.start();
+                }
+            });
+        }
     } else {
         d->mJournal.reset();
+        d->mJournalIdentity.clear();
     }
     Q_EMIT journalProviderChanged();
     // do not clear unique entry cache here, because boot-ids are unique across journald DBs
@@ -361,6 +860,7 @@ QHash<int, QByteArray> FilterCriteriaModel::roleNames() const
     roles[FilterCriteriaModel::LONGTEXT] = "longtext";
     roles[FilterCriteriaModel::CATEGORY] = "category";
     roles[FilterCriteriaModel::SELECTED] = "selected";
+    roles[FilterCriteriaModel::COUNT] = "count";
     return roles;
 }
 
@@ -428,54 +928,12 @@ FilterCriteriaModel::LogViewMode FilterCriteriaModel::logViewMode() const
 
 QStringList FilterCriteriaModel::systemdUserUnitFilter() const
 {
-    if (d->mIndexMap.empty() || d->mIndexMap[FilterCriteriaModel::Category::SYSTEMD_USER_UNIT] < 0) {
-        return {};
-    }
-    std::shared_ptr<SelectionEntry> parent = d->mRootItem->child(d->mIndexMap[FilterCriteriaModel::Category::SYSTEMD_USER_UNIT]);
-    QStringList entries;
-    for (int i = 0; i < parent->childCount(); ++i) {
-        if (parent->child(i)->data(FilterCriteriaModel::SELECTED).toBool()) {
-            const QString identifier = parent->child(i)->data(FilterCriteriaModel::DATA).toString();
-            if (d->mGroupTemplatedSystemdUnits && identifier.endsWith(FilterCriteriaModelPrivate::GROUPED_SERVICE_SUFFIX)) {
-                constexpr qsizetype suffixLength = FilterCriteriaModelPrivate::GROUPED_SERVICE_SUFFIX.size();
-                const QString identifierBase = identifier.left(identifier.length() - suffixLength);
-                for (const auto &unit : std::as_const(d->mUniqueServiceUnitCache)) {
-                    if (unit.startsWith(identifierBase)) {
-                        entries.append(unit);
-                    }
-                }
-            } else {
-                entries.append(identifier);
-            }
-        }
-    }
-    return entries;
+    return d->unitFilter(FilterCriteriaModel::Category::SYSTEMD_USER_UNIT);
 }
 
 QStringList FilterCriteriaModel::systemdSystemUnitFilter() const
 {
-    if (d->mIndexMap.empty() || d->mIndexMap[FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT] < 0) {
-        return {};
-    }
-    std::shared_ptr<SelectionEntry> parent = d->mRootItem->child(d->mIndexMap[FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT]);
-    QStringList entries;
-    for (int i = 0; i < parent->childCount(); ++i) {
-        if (parent->child(i)->data(FilterCriteriaModel::SELECTED).toBool()) {
-            const QString identifier = parent->child(i)->data(FilterCriteriaModel::DATA).toString();
-            if (d->mGroupTemplatedSystemdUnits && identifier.endsWith(FilterCriteriaModelPrivate::GROUPED_SERVICE_SUFFIX)) {
-                constexpr qsizetype suffixLength = FilterCriteriaModelPrivate::GROUPED_SERVICE_SUFFIX.size();
-                const QString identifierBase = identifier.left(identifier.length() - suffixLength);
-                for (const auto &unit : std::as_const(d->mUniqueServiceUnitCache)) {
-                    if (unit.startsWith(identifierBase)) {
-                        entries.append(unit);
-                    }
-                }
-            } else {
-                entries.append(identifier);
-            }
-        }
-    }
-    return entries;
+    return d->unitFilter(FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT);
 }
 
 bool FilterCriteriaModel::groupTemplatedSystemdUnits() const
@@ -499,14 +957,15 @@ void FilterCriteriaModel::setGroupTemplatedSystemdUnits(bool enabled)
 
 QStringList FilterCriteriaModel::exeFilter() const
 {
-    if (d->mIndexMap.empty()) {
+    const int parent = d->categoryEntry(FilterCriteriaModel::Category::EXE);
+    if (parent < 0) {
         return {};
     }
-    std::shared_ptr<SelectionEntry> parent = d->mRootItem->child(d->mIndexMap[FilterCriteriaModel::Category::EXE]);
     QStringList entries;
-    for (int i = 0; i < parent->childCount(); ++i) {
-        if (parent->child(i)->data(FilterCriteriaModel::SELECTED).toBool()) {
-            entries.append(parent->child(i)->data(FilterCriteriaModel::DATA).toString());
+    for (const int child : d->mTree.entry(parent).children()) {
+        const SelectionEntry &entry = d->mTree.entry(child);
+        if (entry.data(FilterCriteriaModel::SELECTED).toBool()) {
+            entries.append(entry.data(FilterCriteriaModel::DATA).toString());
         }
     }
     return entries;
@@ -514,12 +973,13 @@ QStringList FilterCriteriaModel::exeFilter() const
 
 bool FilterCriteriaModel::isKernelFilterEnabled() const
 {
-    if (d->mIndexMap.empty()) {
+    const int parent = d->categoryEntry(FilterCriteriaModel::Category::TRANSPORT);
+    if (parent < 0) {
         return {};
     }
-    std::shared_ptr<SelectionEntry> parent = d->mRootItem->child(d->mIndexMap[FilterCriteriaModel::Category::TRANSPORT]);
-    for (int i = 0; i < parent->childCount(); ++i) {
-        if (parent->child(i)->data(FilterCriteriaModel::DATA) == QLatin1String("kernel") && parent->child(i)->data(FilterCriteriaModel::SELECTED).toBool()) {
+    for (const int child : d->mTree.entry(parent).children()) {
+        const SelectionEntry &entry = d->mTree.entry(child);
+        if (entry.data(FilterCriteriaModel::DATA) == QLatin1String("kernel") && entry.data(FilterCriteriaModel::SELECTED).toBool()) {
             return true;
         }
     }
@@ -532,17 +992,10 @@ QModelIndex FilterCriteriaModel::index(int row, int column, const QModelIndex &p
         return QModelIndex();
     }
 
-    SelectionEntry *parentItem;
-
-    if (!parent.isValid()) {
-        parentItem = d->mRootItem.get();
-    } else {
-        parentItem = static_cast<SelectionEntry *>(parent.internalPointer());
-    }
-
-    std::shared_ptr<SelectionEntry> childItem = parentItem->child(row);
-    if (childItem) {
-        return createIndex(row, column, childItem.get());
+    const int parentItem = parent.isValid() ? static_cast<int>(parent.internalId()) : SelectionTree::ROOT;
+    const int childItem = d->mTree.child(parentItem, row);
+    if (childItem >= 0) {
+        return createIndex(row, column, static_cast<quintptr>(childItem));
     }
     return QModelIndex();
 }
@@ -553,27 +1006,20 @@ QModelIndex FilterCriteriaModel::parent(const QModelIndex &index) const
         return QModelIndex();
     }
 
-    SelectionEntry *childItem = static_cast<SelectionEntry *>(index.internalPointer());
-    std::shared_ptr<SelectionEntry> parentItem = childItem->parentItem();
-
-    if (parentItem.get() == d->mRootItem.get()) {
+    const int parentItem = d->mTree.entry(static_cast<int>(index.internalId())).parent();
+    if (parentItem <= SelectionTree::ROOT) {
         return QModelIndex();
     }
 
-    return createIndex(parentItem->row(), 0, parentItem.get());
+    return createIndex(d->mTree.entry(parentItem).row(), 0, static_cast<quintptr>(parentItem));
 }
 
 int FilterCriteriaModel::rowCount(const QModelIndex &parent) const
 {
-    if (!d->mRootItem) {
-        return 0;
-    } else if (!parent.isValid()) {
-        return d->mRootItem->childCount();
-    } else {
-        auto parentItem = static_cast<SelectionEntry *>(parent.internalPointer());
-        return parentItem->childCount();
+    if (!parent.isValid()) {
+        return d->mTree.entry(SelectionTree::ROOT).childCount();
     }
-    return 0;
+    return d->mTree.entry(static_cast<int>(parent.internalId())).childCount();
 }
 
 int FilterCriteriaModel::columnCount(const QModelIndex &parent) const
@@ -583,117 +1029,113 @@ int FilterCriteriaModel::columnCount(const QModelIndex &parent) const
 
 QVariant FilterCriteriaModel::data(const QModelIndex &index, int role) const
 {
-    if (!index.parent().isValid()) {
-        if (index.row() < 0 || index.row() >= d->mRootItem->childCount()) {
-            qCCritical(KJOURNALDLIB_GENERAL) << "Index out of range" << index;
-            return QVariant();
-        }
-        return d->mRootItem->child(index.row())->data(static_cast<FilterCriteriaModel::Roles>(role));
-    } else {
-        auto entry = static_cast<SelectionEntry *>(index.internalPointer());
-        if (nullptr != entry) {
-            return entry->data(static_cast<FilterCriteriaModel::Roles>(role));
-        }
+    if (!index.isValid() || index.internalId() >= d->mTree.size()) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "Index out of range" << index;
+        return QVariant();
     }
-    return QVariant();
+    return d->mTree.entry(static_cast<int>(index.internalId())).data(static_cast<FilterCriteriaModel::Roles>(role));
 }
 
 bool FilterCriteriaModel::setData(const QModelIndex &index, const QVariant &value, int role)
 {
-    auto entry = static_cast<SelectionEntry *>(index.internalPointer());
-    if (nullptr == entry) {
+    if (!index.isValid()) {
         return QAbstractItemModel::setData(index, value, role);
     }
-    if (value == entry->data(static_cast<FilterCriteriaModel::Roles>(role))) {
+    const int node = static_cast<int>(index.internalId());
+    if (value == d->mTree.entry(node).data(static_cast<FilterCriteriaModel::Roles>(role))) {
         return false; // nothing to do
     }
 
     // clear operations for top-level categories
-    const bool result = entry->setData(value, static_cast<FilterCriteriaModel::Roles>(role));
-    const auto category = entry->data(FilterCriteriaModel::Roles::CATEGORY).value<FilterCriteriaModel::Category>();
+    const bool result = d->mTree.setData(node, value, static_cast<FilterCriteriaModel::Roles>(role));
+    const auto category = d->mTree.entry(node).data(FilterCriteriaModel::Roles::CATEGORY).value<FilterCriteriaModel::Category>();
     Q_EMIT dataChanged(index, index, {role});
 
     if (result && category == FilterCriteriaModel::Category::PRIORITY && static_cast<FilterCriteriaModel::Roles>(role) == SELECTED) {
         // only listen on changes that set entry data to true, because this is considered a selector in the list
-        std::shared_ptr<SelectionEntry> parent = d->mRootItem->child(d->mIndexMap[FilterCriteriaModel::Category::PRIORITY]);
-        for (int i = 0; i < parent->childCount(); ++i) {
+        const SelectionEntry &parent = d->mTree.entry(d->categoryEntry(FilterCriteriaModel::Category::PRIORITY));
+        for (int i = 0; i < parent.childCount(); ++i) {
             const bool selectedValue = (i == index.row());
-            parent->child(i)->setData(selectedValue, FilterCriteriaModel::SELECTED);
-            static_cast<SelectionEntry *>(FilterCriteriaModel::index(i, 0, index.parent()).internalPointer())
-                ->setData(selectedValue, static_cast<FilterCriteriaModel::Roles>(role));
+            d->mTree.setData(parent.child(i), selectedValue, FilterCriteriaModel::SELECTED);
         }
-        Q_EMIT dataChanged(FilterCriteriaModel::index(0, 0, index.parent()), FilterCriteriaModel::index(parent->childCount() - 1, 0, index.parent()), {role});
+        Q_EMIT dataChanged(FilterCriteriaModel::index(0, 0, index.parent()), FilterCriteriaModel::index(parent.childCount() - 1, 0, index.parent()), {role});
         Q_ASSERT(index.row() >= 0);
-        if (parent->child(index.row())->data(FilterCriteriaModel::DATA).toInt() >= 0) {
-            d->mPriorityLevel = parent->child(index.row())->data(FilterCriteriaModel::DATA).toInt();
+        if (d->mTree.entry(parent.child(index.row())).data(FilterCriteriaModel::DATA).toInt() >= 0) {
+            d->mPriorityLevel = d->mTree.entry(parent.child(index.row())).data(FilterCriteriaModel::DATA).toInt();
         } else {
             d->mPriorityLevel = std::nullopt;
         }
         qCDebug(KJOURNALDLIB_GENERAL) << "set priority level to:" << static_cast<qint8>(d->mPriorityLevel.value_or(-1));
         Q_EMIT priorityFilterChanged(index.row());
         Q_EMIT priorityFilterUserChanged(index.row());
-    } else if (result && category == FilterCriteriaModel::Category::SYSTEMD_USER_UNIT) {
-        // for checkable entries update parent's selected state
-        if (value.toBool() == true) {
-            setData(index.parent(), true, FilterCriteriaModel::Roles::SELECTED);
-        } else {
-            const auto parent = static_cast<SelectionEntry *>(index.parent().internalPointer());
-            if (parent) {
-                bool hasSelectedSibling{false};
-                for (int i = 0; i < parent->childCount(); ++i) {
-                    hasSelectedSibling = hasSelectedSibling || parent->child(i)->data(SELECTED).toBool();
-                }
-                setData(index.parent(), hasSelectedSibling, FilterCriteriaModel::Roles::SELECTED);
-            }
-        }
-        Q_EMIT systemdUserUnitFilterChanged();
-    } else if (result && category == FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT) {
+    } else if (result
+               && (category == FilterCriteriaModel::Category::SYSTEMD_USER_UNIT || category == FilterCriteriaModel::Category::SYSTEMD_SYSTEM_UNIT
+                   || category == FilterCriteriaModel::Category::EXE)) {
         // for checkable entries update parent's selected state
-        if (value.toBool() == true) {
-            setData(index.parent(), true, FilterCriteriaModel::Roles::SELECTED);
-        } else {
-            const auto parent = static_cast<SelectionEntry *>(index.parent().internalPointer());
-            if (parent) {
-                bool hasSelectedSibling{false};
-                for (int i = 0; i < parent->childCount(); ++i) {
-                    hasSelectedSibling = hasSelectedSibling || parent->child(i)->data(SELECTED).toBool();
-                }
-                setData(index.parent(), hasSelectedSibling, FilterCriteriaModel::Roles::SELECTED);
-            }
+        if (index.parent().isValid()) {
+            const SelectionEntry &parent = d->mTree.entry(static_cast<int>(index.parent().internalId()));
+            setData(index.parent(), parent.selectedChildCount() > 0, FilterCriteriaModel::Roles::SELECTED);
         }
-        Q_EMIT systemdSystemUnitFilterChanged();
-    } else if (result && category == FilterCriteriaModel::Category::EXE) {
-        // for checkable entries update parent's selected state
-        if (value.toBool() == true) {
-            setData(index.parent(), true, FilterCriteriaModel::Roles::SELECTED);
-        } else {
-            const auto parent = static_cast<SelectionEntry *>(index.parent().internalPointer());
-            if (parent) {
-                bool hasSelectedSibling{false};
-                for (int i = 0; i < parent->childCount(); ++i) {
-                    hasSelectedSibling = hasSelectedSibling || parent->child(i)->data(SELECTED).toBool();
-                }
-                setData(index.parent(), hasSelectedSibling, FilterCriteriaModel::Roles::SELECTED);
-            }
-        }
-        Q_EMIT exeFilterChanged();
+        d->notifyFilterChanged(category);
     } else if (result && category == FilterCriteriaModel::Category::TRANSPORT) {
         Q_EMIT kernelFilterChanged();
     }
     return result;
 }
 
+void FilterCriteriaModel::selectAll(FilterCriteriaModel::Category category)
+{
+    d->applySelection(category, [](const SelectionEntry &) {
+        return true;
+    });
+}
+
+void FilterCriteriaModel::selectNone(FilterCriteriaModel::Category category)
+{
+    d->applySelection(category, [](const SelectionEntry &) {
+        return false;
+    });
+}
+
+int FilterCriteriaModel::selectMatching(FilterCriteriaModel::Category category, const QString &pattern)
+{
+    const QRegularExpression expression(QRegularExpression::wildcardToRegularExpression(pattern, QRegularExpression::NonPathWildcardConversion),
+                                        QRegularExpression::CaseInsensitiveOption);
+    if (!expression.isValid()) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Invalid selection pattern" << pattern;
+        return 0;
+    }
+    return d->applySelection(category, [&expression](const SelectionEntry &entry) {
+        return entry.data(FilterCriteriaModel::SELECTED).toBool() || expression.match(entry.data(FilterCriteriaModel::DATA).toString()).hasMatch();
+    });
+}
+
+void FilterCriteriaModel::invertSelection(FilterCriteriaModel::Category category)
+{
+    d->applySelection(category, [](const SelectionEntry &entry) {
+        return !entry.data(FilterCriteriaModel::SELECTED).toBool();
+    });
+}
+
 QVector<std::pair<QString, bool>> FilterCriteriaModel::entries(FilterCriteriaModel::Category category) const
 {
     QVector<std::pair<QString, bool>> values;
 
-    for (int i = 0; i < d->mRootItem->child(static_cast<int>(category))->childCount(); ++i) {
-        values.append(
-            std::make_pair<QString, bool>(d->mRootItem->child(static_cast<int>(category))->child(i)->data(FilterCriteriaModel::DATA).toString(), false));
+    const int parent = d->categoryEntry(category);
+    if (parent < 0) {
+        return values;
+    }
+    for (const int child : d->mTree.entry(parent).children()) {
+        values.append(std::make_pair<QString, bool>(d->mTree.entry(child).data(FilterCriteriaModel::DATA).toString(), false));
     }
     return values;
 }
 
+bool FilterCriteriaModel::isLoading() const
+{
+    return d->mUniqueEntriesWatcher != nullptr;
+}
+
 void FilterCriteriaModel::classBegin()
 {
     d->mQmlEngineIncubationActive = true;
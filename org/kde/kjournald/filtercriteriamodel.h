@@ -65,6 +65,11 @@ class KJOURNALD_EXPORT FilterCriteriaModel : public QAbstractItemModel, public Q
 
     Q_PROPERTY(LogViewMode logViewMode READ logViewMode WRITE setLogViewMode NOTIFY logViewModeChanged FINAL)
 
+    /**
+     * is true while unit and process entries of the current boot are queried in the background
+     **/
+    Q_PROPERTY(bool loading READ isLoading NOTIFY loadingChanged FINAL)
+
     QML_ELEMENT
 
 public:
@@ -84,6 +89,7 @@ public:
         CATEGORY = Qt::UserRole + 1,
         DATA = Qt::UserRole + 2,
         HAS_CHILDREN = Qt::UserRole + 3,
+        COUNT = Qt::UserRole + 4, //!< number of entries of the selected boot matching the entry, invalid until counted
     };
     Q_ENUM(Roles)
 
@@ -207,6 +213,41 @@ public:
      */
     QVector<std::pair<QString, bool>> entries(FilterCriteriaModel::Category category) const;
 
+    /**
+     * @brief Select all entries of checkable @p category
+     *
+     * This and the other bulk selection methods emit a single dataChanged range and a single
+     * filter changed signal, independent of the number of changed entries.
+     */
+    Q_INVOKABLE void selectAll(FilterCriteriaModel::Category category);
+
+    /**
+     * @brief Unselect all entries of checkable @p category
+     */
+    Q_INVOKABLE void selectNone(FilterCriteriaModel::Category category);
+
+    /**
+     * @brief Additionally select all entries of checkable @p category that match wildcard @p pattern
+     *
+     * The pattern is matched case insensitive against the verbatim entry value, e.g. "kube*".
+     *
+     * @return number of newly selected entries
+     */
+    Q_INVOKABLE int selectMatching(FilterCriteriaModel::Category category, const QString &pattern);
+
+    /**
+     * @brief Invert selected state of all entries of checkable @p category
+     */
+    Q_INVOKABLE void invertSelection(FilterCriteriaModel::Category category);
+
+    /**
+     * @return true if unit and process entries are currently queried from the journal
+     *
+     * Transport and priority entries are always available, the other categories are filled by row
+     * insertions once the query finished.
+     */
+    bool isLoading() const;
+
     void classBegin() override;
     void componentComplete() override;
 
@@ -221,8 +262,10 @@ Q_SIGNALS:
     void journalProviderChanged();
     void groupTemplatedSystemdUnitsChanged();
     void logViewModeChanged();
+    void loadingChanged();
 
 private:
+    friend class FilterCriteriaModelPrivate;
     std::unique_ptr<FilterCriteriaModelPrivate> d;
 };
 
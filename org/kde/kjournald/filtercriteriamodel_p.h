@@ -9,50 +9,176 @@
 #include "filtercriteriamodel.h"
 #include "ijournalprovider.h"
 #include "journaldhelper.h"
+#include "uniquevaluescache.h"
+#include <QFutureWatcher>
+#include <QHash>
 #include <QMap>
 #include <QString>
+#include <QTimer>
 #include <QVector>
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <optional>
+#include <vector>
 
 class SelectionEntry
 {
 public:
     explicit SelectionEntry() = default;
-    explicit SelectionEntry(const QString &text,
-                            const QVariant &data,
-                            FilterCriteriaModel::Category category,
-                            bool selected = false,
-                            std::shared_ptr<SelectionEntry> parentItem = nullptr);
+    explicit SelectionEntry(const QString &text, const QVariant &data, FilterCriteriaModel::Category category, bool selected, int parent, int row);
 
-    void appendChild(std::shared_ptr<SelectionEntry> child);
-
-    std::shared_ptr<SelectionEntry> child(int row);
+    /**
+     * @return arena index of child at @p row or -1 if no such child exists
+     */
+    int child(int row) const;
+    const std::vector<int> &children() const;
     int childCount() const;
+    int selectedChildCount() const;
+    /**
+     * @return number of matching journal entries or -1 if not counted yet
+     */
+    qint64 count() const;
+    void setCount(qint64 count);
     int columnCount() const;
     QVariant data(FilterCriteriaModel::Roles role) const;
     bool setData(const QVariant &value, FilterCriteriaModel::Roles role);
     int row() const;
-    std::shared_ptr<SelectionEntry> parentItem();
+    /**
+     * @return arena index of parent or -1 for the root entry
+     */
+    int parent() const;
 
 private:
-    std::vector<std::shared_ptr<SelectionEntry>> mChildItems;
-    std::weak_ptr<SelectionEntry> mParentItem;
+    friend class SelectionTree;
+    std::vector<int> mChildren; //!< arena indices of children
+    int mSelectedChildren{0}; //!< number of selected children
+    qint64 mCount{-1}; //!< number of matching journal entries, -1 if unknown
+    int mParent{-1};
+    int mRow{0};
     QString mText; //!< user formatted string
     QVariant mData; //!< verbatim string as needed for journald filtering
     bool mSelected{true};
     FilterCriteriaModel::Category mCategory{FilterCriteriaModel::Category::TRANSPORT};
 };
 
+/**
+ * @brief Contiguous storage of all selection entries
+ *
+ * Entries are addressed by their index in the arena, which is stable until the tree is cleared
+ * and is used as internal id of model indices. Every entry knows its parent and row, such that
+ * all tree navigation is O(1). The entry at index ROOT is the invisible root entry.
+ */
+class SelectionTree
+{
+public:
+    SelectionTree();
+
+    /**
+     * @brief remove all entries except of the root entry
+     */
+    void clear();
+    /**
+     * @brief append new entry as last child of @p parent
+     * @return arena index of new entry
+     */
+    int appendChild(int parent, const QString &text, const QVariant &data, FilterCriteriaModel::Category category, bool selected = false);
+    /**
+     * @brief insert new entry as child of @p parent at @p row, rows of following siblings are shifted
+     * @return arena index of new entry
+     */
+    int insertChild(int parent, int row, const QString &text, const QVariant &data, FilterCriteriaModel::Category category, bool selected = false);
+    /**
+     * @return arena index of child at @p row of @p parent or -1 if no such child exists
+     */
+    int child(int parent, int row) const;
+    /**
+     * @brief set data of entry @p index, keeps the selected children count of its parent up to date
+     * @return true if data was changed
+     */
+    bool setData(int index, const QVariant &value, FilterCriteriaModel::Roles role);
+    SelectionEntry &entry(int index);
+    const SelectionEntry &entry(int index) const;
+    void reserve(std::size_t size);
+    std::size_t size() const;
+
+    static constexpr int ROOT{0};
+
+private:
+    std::vector<SelectionEntry> mEntries;
+};
+
+/**
+ * @brief Result of the background query for the filter criteria of one boot
+ */
+struct UniqueEntries {
+    UniqueValuesCache::UniqueValues mValues;
+    UniqueValuesCache::ValueCounts mCounts;
+    QString mCursor; //!< cursor of the last counted entry, empty if counts do not originate from the journal
+};
+
 class FilterCriteriaModelPrivate
 {
 public:
-    FilterCriteriaModelPrivate();
+    explicit FilterCriteriaModelPrivate(FilterCriteriaModel *q);
     ~FilterCriteriaModelPrivate();
     /**
      * @brief clear all model data and read units, processes... from currently set journal
+     *
+     * Transport and priority categories are created immediately. Units and processes are filled
+     * from the cache if available, otherwise they are queried in the background and inserted via
+     * applyUniqueEntries() once available. Any running query is cancelled.
      */
     void rebuildModel();
+    /**
+     * @brief start background query of unique values for @p bootId
+     */
+    void startUniqueEntriesQuery(const QString &bootId);
+    /**
+     * @brief cancel running background query, if any
+     */
+    void cancelUniqueEntriesQuery();
+    /**
+     * @brief insert units and processes of @p uniqueEntries for @p bootId into the model with row insertions
+     */
+    void applyUniqueEntries(const QString &bootId, const UniqueEntries &uniqueEntries);
+    /**
+     * @brief count the entries of the selected boot that were added to the journal since the last query
+     *
+     * Only entries after the cursor of the last query are counted. If the counts for the boot do not
+     * originate from the journal (e.g. from the persistent cache), all entries are counted again.
+     */
+    void startUniqueEntriesRefresh();
+    /**
+     * @brief add @p uniqueEntries of new journal entries for @p bootId to the cached values and counts
+     *
+     * New units and processes are inserted at their sorted position and counts are updated, the model
+     * is not reset. If @p replace is true, @p uniqueEntries replace the cached counts.
+     */
+    void mergeUniqueEntries(const QString &bootId, const UniqueEntries &uniqueEntries, bool replace);
+    /**
+     * @brief compute the sorted, user visible values of @p category from @p uniqueEntries
+     */
+    QStringList categoryValues(FilterCriteriaModel::Category category, const UniqueValuesCache::UniqueValues &uniqueEntries);
+    /**
+     * @brief append @p values as child entries of @p category without notifying views
+     */
+    void appendCategoryEntries(FilterCriteriaModel::Category category, const QStringList &values);
+    /**
+     * @brief insert those of the sorted @p values that are not yet listed in @p category at their sorted position
+     */
+    void insertCategoryEntries(FilterCriteriaModel::Category category, const QStringList &values);
+    /**
+     * @brief set entry counts of all children of @p category from @p counts
+     *
+     * Grouped template entries get the sum of their instances, the "no filter" priority entry the total.
+     * Views are only notified if @p notify is true.
+     */
+    void applyEntryCounts(FilterCriteriaModel::Category category, const UniqueValuesCache::ValueCounts &counts, bool notify);
+    /**
+     * @return journal field whose values are listed in @p category
+     */
+    static JournaldHelper::Field categoryField(FilterCriteriaModel::Category category);
     /**
      * @brief check if already filter criteria is populated for boot-id / journal combination
      * @return true if model needs to be populated
@@ -61,18 +187,54 @@ public:
 
     static QString mapPriorityToString(qint32 priority);
 
+    FilterCriteriaModel *const q;
     bool mQmlEngineIncubationActive{false}; // set via QML parser status
     IJournalProvider *mJournalProvider{nullptr};
     std::unique_ptr<SdJournal> mJournal;
+    QByteArray mJournalIdentity; //!< identity of journal files for the persistent unique values cache
     using BootId = QString;
     QMap<BootId, QMap<JournaldHelper::Field, QStringList>> mUniqueEntriesCache;
-    QStringList mUniqueServiceUnitCache; //!< this is used to deduplicate grouped services
-    std::shared_ptr<SelectionEntry> mRootItem;
+    QMap<BootId, UniqueValuesCache::ValueCounts> mUniqueEntryCountsCache; //!< entry counts per field value, filled with mUniqueEntriesCache
+    QMap<BootId, QString> mUniqueEntriesCursorCache; //!< cursor of last counted entry, only for counts from the journal
+    UnitNameCache mUnitNameCache;
+    QMap<FilterCriteriaModel::Category, QHash<QString, QStringList>> mTemplateGroupInstances; //!< maps grouped template entry to its instances
+    mutable QMap<FilterCriteriaModel::Category, QStringList> mUnitFilterCache; //!< expanded unit filters, valid until selection changes
+    /**
+     * @return arena index of the top level entry for @p category or -1 if category is not shown
+     */
+    int categoryEntry(FilterCriteriaModel::Category category) const;
+    /**
+     * @brief set selected state of all entries of @p category to the value returned by @p selector
+     *
+     * Emits a single dataChanged range for the changed entries and a single filter changed signal.
+     *
+     * @return number of changed entries
+     */
+    int applySelection(FilterCriteriaModel::Category category, const std::function<bool(const SelectionEntry &)> &selector);
+    /**
+     * @brief compute list of selected units of @p category with grouped template entries expanded to their instances
+     */
+    QStringList unitFilter(FilterCriteriaModel::Category category) const;
+    /**
+     * @brief drop all cached unit filter lists
+     */
+    void invalidateUnitFilterCache();
+    /**
+     * @brief emit the filter changed signal that corresponds to @p category and drop its cached filter
+     */
+    void notifyFilterChanged(FilterCriteriaModel::Category category);
+
+    SelectionTree mTree;
     std::vector<int> mIndexMap; // maps: FilterCriteriaModel::Category -> index in root child
     std::optional<quint8> mPriorityLevel{5}; //!< init priority level with Info
     std::optional<QString> mBootFilter;
     FilterCriteriaModel::LogViewMode mLogViewMode{FilterCriteriaModel::LogViewMode::ALL_LOGS};
     bool mGroupTemplatedSystemdUnits{true};
+    std::unique_ptr<QFutureWatcher<UniqueEntries>> mUniqueEntriesWatcher; //!< set while background query is running
+    std::unique_ptr<QFutureWatcher<UniqueEntries>> mRefreshWatcher; //!< set while background refresh is running
+    QTimer mRefreshTimer; //!< coalesces journal updates into refreshs of the selected boot
+
+    static constexpr std::chrono::milliseconds REFRESH_INTERVAL{2000};
 
     /**
      * Suffix that is used for grouped template services to replace the argument
@@ -8,6 +8,7 @@
 #include "filtercriteriamodel.h"
 #include "kjournaldlib_log_general.h"
 #include <QDebug>
+#include <utility>
 
 QHash<int, QByteArray> FlattenedFilterCriteriaProxyModel::roleNames() const
 {
@@ -20,15 +21,14 @@ QHash<int, QByteArray> FlattenedFilterCriteriaProxyModel::roleNames() const
     roles[FlattenedFilterCriteriaProxyModel::EXPANDABLE] = "expandable";
     roles[FlattenedFilterCriteriaProxyModel::TYPE] = "type";
     roles[FlattenedFilterCriteriaProxyModel::COLOR] = "color";
+    roles[FlattenedFilterCriteriaProxyModel::COUNT] = "count";
     return roles;
 }
 
 void FlattenedFilterCriteriaProxyModel::setSourceModel(QAbstractItemModel *model)
 {
     if (mSourceModel) {
-        disconnect(mSourceModel, &QAbstractItemModel::dataChanged, this, &FlattenedFilterCriteriaProxyModel::handleSourceModelDataChanged);
-        disconnect(mSourceModel, &QAbstractItemModel::modelAboutToBeReset, this, &FlattenedFilterCriteriaProxyModel::handleSourceModelOnModelAboutToBeReset);
-        disconnect(mSourceModel, &QAbstractItemModel::modelReset, this, &FlattenedFilterCriteriaProxyModel::handleSourceModelOnModelReset);
+        disconnect(mSourceModel, nullptr, this, nullptr);
     }
 
     // TODO add assert that this model only handles two level hierarchies
@@ -37,6 +37,16 @@ void FlattenedFilterCriteriaProxyModel::setSourceModel(QAbstractItemModel *model
     connect(mSourceModel, &QAbstractItemModel::dataChanged, this, &FlattenedFilterCriteriaProxyModel::handleSourceModelDataChanged);
     connect(mSourceModel, &QAbstractItemModel::modelAboutToBeReset, this, &FlattenedFilterCriteriaProxyModel::handleSourceModelOnModelAboutToBeReset);
     connect(mSourceModel, &QAbstractItemModel::modelReset, this, &FlattenedFilterCriteriaProxyModel::handleSourceModelOnModelReset);
+    connect(mSourceModel,
+            &QAbstractItemModel::rowsAboutToBeInserted,
+            this,
+            &FlattenedFilterCriteriaProxyModel::handleSourceModelRowsAboutToBeInserted);
+    connect(mSourceModel, &QAbstractItemModel::rowsInserted, this, &FlattenedFilterCriteriaProxyModel::handleSourceModelRowsInserted);
+    connect(mSourceModel,
+            &QAbstractItemModel::rowsAboutToBeRemoved,
+            this,
+            &FlattenedFilterCriteriaProxyModel::handleSourceModelRowsAboutToBeRemoved);
+    connect(mSourceModel, &QAbstractItemModel::rowsRemoved, this, &FlattenedFilterCriteriaProxyModel::handleSourceModelRowsRemoved);
 
     handleSourceModelOnModelReset();
 }
@@ -44,18 +54,135 @@ void FlattenedFilterCriteriaProxyModel::setSourceModel(QAbstractItemModel *model
 void FlattenedFilterCriteriaProxyModel::handleSourceModelOnModelAboutToBeReset()
 {
     beginResetModel();
-    mMapToSourceIndex.clear();
+    mCategories.clear();
 }
 
 void FlattenedFilterCriteriaProxyModel::handleSourceModelOnModelReset()
 {
     // generate top level items
     for (int i = 0; i < mSourceModel->rowCount(); ++i) {
-        mMapToSourceIndex.append({mSourceModel->index(i, 0), false});
+        mCategories.append({QPersistentModelIndex(mSourceModel->index(i, 0)), false});
     }
     endResetModel();
 }
 
+int FlattenedFilterCriteriaProxyModel::categoryRowSpan(int category) const
+{
+    const CategoryEntry &entry = mCategories.at(category);
+    return entry.mIsExpanded ? 1 + mSourceModel->rowCount(entry.mSourceIndex) : 1;
+}
+
+int FlattenedFilterCriteriaProxyModel::categoryProxyRow(int category) const
+{
+    int row{0};
+    for (int i = 0; i < category; ++i) {
+        row += categoryRowSpan(i);
+    }
+    return row;
+}
+
+QModelIndex FlattenedFilterCriteriaProxyModel::mapToSource(int row) const
+{
+    if (row < 0) {
+        return QModelIndex();
+    }
+    for (int i = 0; i < mCategories.size(); ++i) {
+        if (row == 0) {
+            return mCategories.at(i).mSourceIndex;
+        }
+        const int span = categoryRowSpan(i);
+        if (row < span) {
+            return mSourceModel->index(row - 1, 0, mCategories.at(i).mSourceIndex);
+        }
+        row -= span;
+    }
+    return QModelIndex();
+}
+
+int FlattenedFilterCriteriaProxyModel::mapFromSource(const QModelIndex &sourceIndex) const
+{
+    if (!sourceIndex.isValid()) {
+        return -1;
+    }
+    const QModelIndex sourceParent = sourceIndex.parent();
+    if (!sourceParent.isValid()) {
+        return sourceIndex.row() < mCategories.size() ? categoryProxyRow(sourceIndex.row()) : -1;
+    }
+    if (sourceParent.row() >= mCategories.size() || !mCategories.at(sourceParent.row()).mIsExpanded) {
+        return -1;
+    }
+    return categoryProxyRow(sourceParent.row()) + 1 + sourceIndex.row();
+}
+
+bool FlattenedFilterCriteriaProxyModel::beginChildRowsChange(const QModelIndex &parent, int first, int last, bool insert)
+{
+    if (!parent.isValid()) {
+        // top level categories are only created on reset, rebuild mapping in this unexpected case
+        handleSourceModelOnModelAboutToBeReset();
+        mPendingChange = PendingChange::RESET;
+        return true;
+    }
+    if (parent.row() >= mCategories.size() || !mCategories.at(parent.row()).mIsExpanded) {
+        return false;
+    }
+    const int proxyParentRow = categoryProxyRow(parent.row());
+    if (insert) {
+        beginInsertRows(QModelIndex(), proxyParentRow + 1 + first, proxyParentRow + 1 + last);
+        mPendingChange = PendingChange::INSERT;
+    } else {
+        beginRemoveRows(QModelIndex(), proxyParentRow + 1 + first, proxyParentRow + 1 + last);
+        mPendingChange = PendingChange::REMOVE;
+    }
+    return true;
+}
+
+void FlattenedFilterCriteriaProxyModel::handleSourceModelRowsAboutToBeInserted(const QModelIndex &parent, int first, int last)
+{
+    beginChildRowsChange(parent, first, last, true);
+}
+
+void FlattenedFilterCriteriaProxyModel::handleSourceModelRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    Q_UNUSED(first)
+    Q_UNUSED(last)
+    const PendingChange change = std::exchange(mPendingChange, PendingChange::NONE);
+    if (change == PendingChange::RESET) {
+        handleSourceModelOnModelReset();
+        return;
+    }
+    if (change == PendingChange::INSERT) {
+        endInsertRows();
+    }
+    // expandable state of parent might have changed
+    const int proxyParentRow = mapFromSource(parent);
+    if (proxyParentRow >= 0) {
+        Q_EMIT dataChanged(index(proxyParentRow, 0), index(proxyParentRow, 0));
+    }
+}
+
+void FlattenedFilterCriteriaProxyModel::handleSourceModelRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+    beginChildRowsChange(parent, first, last, false);
+}
+
+void FlattenedFilterCriteriaProxyModel::handleSourceModelRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+    Q_UNUSED(first)
+    Q_UNUSED(last)
+    const PendingChange change = std::exchange(mPendingChange, PendingChange::NONE);
+    if (change == PendingChange::RESET) {
+        handleSourceModelOnModelReset();
+        return;
+    }
+    if (change == PendingChange::REMOVE) {
+        endRemoveRows();
+    }
+    const int proxyParentRow = mapFromSource(parent);
+    if (proxyParentRow >= 0) {
+        Q_EMIT dataChanged(index(proxyParentRow, 0), index(proxyParentRow, 0));
+    }
+}
+
 QAbstractItemModel *FlattenedFilterCriteriaProxyModel::sourceModel() const
 {
     return mSourceModel;
@@ -72,24 +199,27 @@ void FlattenedFilterCriteriaProxyModel::handleSourceModelDataChanged(const QMode
         return;
     }
 
-    int proxyTopLeft{-1};
-    int proxyBottomRight{-1};
-    for (int i = 0; i < mMapToSourceIndex.size(); ++i) {
-        if (mMapToSourceIndex.at(i).mSourceIndex == sourceTopLeft) {
-            proxyTopLeft = i;
-        }
-        if (mMapToSourceIndex.at(i).mSourceIndex == sourceBottomRight) {
-            proxyBottomRight = i;
+    // siblings are mapped to a contiguous proxy range, children of collapsed entries are not mapped at all
+    if (!sourceTopLeft.parent().isValid()) {
+        for (int i = sourceTopLeft.row(); i <= sourceBottomRight.row() && i < mCategories.size(); ++i) {
+            const int proxyRow = categoryProxyRow(i);
+            Q_EMIT dataChanged(index(proxyRow, 0), index(proxyRow, 0));
         }
+        return;
+    }
+    const int proxyTopLeft = mapFromSource(sourceTopLeft);
+    if (proxyTopLeft < 0) {
+        return;
     }
-    Q_ASSERT(proxyTopLeft != -1);
-    Q_ASSERT(proxyBottomRight != -1);
-    Q_EMIT dataChanged(index(proxyTopLeft, 0), index(proxyBottomRight, 0));
+    Q_EMIT dataChanged(index(proxyTopLeft, 0), index(proxyTopLeft + sourceBottomRight.row() - sourceTopLeft.row(), 0));
 }
 
 int FlattenedFilterCriteriaProxyModel::rowCount(const QModelIndex &parent) const
 {
-    return mMapToSourceIndex.size();
+    if (parent.isValid()) {
+        return 0;
+    }
+    return categoryProxyRow(mCategories.size());
 }
 
 int FlattenedFilterCriteriaProxyModel::columnCount(const QModelIndex &parent) const
@@ -110,27 +240,31 @@ QModelIndex FlattenedFilterCriteriaProxyModel::parent(const QModelIndex &index)
 
 QVariant FlattenedFilterCriteriaProxyModel::data(const QModelIndex &index, int role) const
 {
-    if (index.row() < 0 || index.row() >= rowCount()) {
+    const QModelIndex sourceIndex = mapToSource(index.row());
+    if (!sourceIndex.isValid()) {
         return QVariant();
     }
+    const bool isFirstLevel = !sourceIndex.parent().isValid();
     switch (role) {
     case FlattenedFilterCriteriaProxyModel::Roles::TEXT:
-        return mSourceModel->data(mMapToSourceIndex.at(index.row()).mSourceIndex, FilterCriteriaModel::Roles::TEXT);
+        return mSourceModel->data(sourceIndex, FilterCriteriaModel::Roles::TEXT);
     case FlattenedFilterCriteriaProxyModel::Roles::LONGTEXT:
-        return mSourceModel->data(mMapToSourceIndex.at(index.row()).mSourceIndex, FilterCriteriaModel::Roles::LONGTEXT);
+        return mSourceModel->data(sourceIndex, FilterCriteriaModel::Roles::LONGTEXT);
     case FlattenedFilterCriteriaProxyModel::Roles::EXPANDED:
-        return mMapToSourceIndex.at(index.row()).mIsExpanded;
+        return isFirstLevel && mCategories.at(sourceIndex.row()).mIsExpanded;
     case FlattenedFilterCriteriaProxyModel::Roles::EXPANDABLE:
-        return mSourceModel->data(mMapToSourceIndex.at(index.row()).mSourceIndex, FilterCriteriaModel::Roles::HAS_CHILDREN);
+        return mSourceModel->data(sourceIndex, FilterCriteriaModel::Roles::HAS_CHILDREN);
     case FlattenedFilterCriteriaProxyModel::Roles::SELECTED:
-        return mSourceModel->data(mMapToSourceIndex.at(index.row()).mSourceIndex, FilterCriteriaModel::Roles::SELECTED);
+        return mSourceModel->data(sourceIndex, FilterCriteriaModel::Roles::SELECTED);
+    case FlattenedFilterCriteriaProxyModel::Roles::COUNT:
+        return mSourceModel->data(sourceIndex, FilterCriteriaModel::Roles::COUNT);
     case FlattenedFilterCriteriaProxyModel::Roles::INDENTATION:
-        return mMapToSourceIndex.at(index.row()).mIndentation;
+        return isFirstLevel ? 0 : 1;
     case FlattenedFilterCriteriaProxyModel::Roles::TYPE: {
-        if (mMapToSourceIndex.at(index.row()).mIndentation == 0) {
+        if (isFirstLevel) {
             return FlattenedFilterCriteriaProxyModel::DelgateType::FIRST_LEVEL;
         }
-        switch (mSourceModel->data(mMapToSourceIndex.at(index.row()).mSourceIndex, FilterCriteriaModel::Roles::CATEGORY).toInt()) {
+        switch (mSourceModel->data(sourceIndex, FilterCriteriaModel::Roles::CATEGORY).toInt()) {
         case FilterCriteriaModel::Category::PRIORITY:
             return FlattenedFilterCriteriaProxyModel::DelgateType::RADIOBUTTON;
         case FilterCriteriaModel::Category::SYSTEMD_USER_UNIT:
@@ -145,12 +279,10 @@ QVariant FlattenedFilterCriteriaProxyModel::data(const QModelIndex &index, int r
         return QVariant::fromValue(FlattenedFilterCriteriaProxyModel::DelgateType::SECTION);
     }
     case FlattenedFilterCriteriaProxyModel::COLOR: {
-        if (mSourceModel->data(mMapToSourceIndex.at(index.row()).mSourceIndex, FilterCriteriaModel::Roles::CATEGORY)
-            == FilterCriteriaModel::Category::TRANSPORT) {
+        if (mSourceModel->data(sourceIndex, FilterCriteriaModel::Roles::CATEGORY) == FilterCriteriaModel::Category::TRANSPORT) {
             return QColor(Qt::black);
         }
-        return Colorizer::color(mSourceModel->data(mMapToSourceIndex.at(index.row()).mSourceIndex, FilterCriteriaModel::Roles::DATA).toString(),
-                                Colorizer::COLOR_TYPE::FOREGROUND);
+        return Colorizer::color(mSourceModel->data(sourceIndex, FilterCriteriaModel::Roles::DATA).toString(), Colorizer::COLOR_TYPE::FOREGROUND);
     }
     }
 
@@ -159,44 +291,47 @@ QVariant FlattenedFilterCriteriaProxyModel::data(const QModelIndex &index, int r
 
 bool FlattenedFilterCriteriaProxyModel::setData(const QModelIndex &index, const QVariant &value, int role)
 {
-    if (index.row() >= mMapToSourceIndex.count()) {
-        qCWarning(KJOURNALDLIB_GENERAL) << "access setData for line out of range with index:" << index.row() << " / total rows" << mMapToSourceIndex.count();
+    const QModelIndex sourceIndex = mapToSource(index.row());
+    if (!sourceIndex.isValid()) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "access setData for line out of range with index:" << index.row() << " / total rows" << rowCount();
         return false;
     }
     if (role == FlattenedFilterCriteriaProxyModel::Roles::EXPANDED) {
-        const int childrenCount = mSourceModel->rowCount(mMapToSourceIndex.at(index.row()).mSourceIndex);
-        const QModelIndex parent = mMapToSourceIndex.at(index.row()).mSourceIndex;
+        if (sourceIndex.parent().isValid()) {
+            return false;
+        }
+        const int childrenCount = mSourceModel->rowCount(sourceIndex);
         if (childrenCount == 0) {
             return false;
         }
-        if (mMapToSourceIndex.at(index.row()).mIsExpanded == false) {
-            mMapToSourceIndex[index.row()].mIsExpanded = true;
-            Q_EMIT dataChanged(index, index);
+        CategoryEntry &category = mCategories[sourceIndex.row()];
+        // only the children of this category change, following rows are shifted by the views
+        if (category.mIsExpanded == false) {
             beginInsertRows(QModelIndex(), index.row() + 1, index.row() + childrenCount);
-            for (int i = 0; i < childrenCount; ++i) {
-                mMapToSourceIndex.insert(index.row() + 1 + i, {mSourceModel->index(i, 0, parent), false, 1});
-            }
+            category.mIsExpanded = true;
             endInsertRows();
         } else {
-            mMapToSourceIndex[index.row()].mIsExpanded = false;
-            Q_EMIT dataChanged(index, index);
             beginRemoveRows(QModelIndex(), index.row() + 1, index.row() + childrenCount);
-            mMapToSourceIndex.remove(index.row() + 1, childrenCount);
+            category.mIsExpanded = false;
             endRemoveRows();
         }
+        Q_EMIT dataChanged(index, index);
         return true;
     }
 
     if (role == FlattenedFilterCriteriaProxyModel::Roles::SELECTED) {
-        const QModelIndex sourceIndex = mMapToSourceIndex.at(index.row()).mSourceIndex;
         const int childrenCount = mSourceModel->rowCount(sourceIndex);
         const auto category = mSourceModel->data(sourceIndex, FilterCriteriaModel::Roles::CATEGORY).value<FilterCriteriaModel::Category>();
         // detect first level elements and clear selelection if they are unselected
         if (childrenCount > 0 && value == false
             && (category == FilterCriteriaModel::SYSTEMD_USER_UNIT || category == FilterCriteriaModel::SYSTEMD_SYSTEM_UNIT
                 || category == FilterCriteriaModel::EXE)) {
-            for (int i = 0; i < childrenCount; ++i) {
-                mSourceModel->setData(mSourceModel->index(i, 0, sourceIndex), false, FilterCriteriaModel::Roles::SELECTED);
+            if (auto filterCriteriaModel = qobject_cast<FilterCriteriaModel *>(mSourceModel)) {
+                filterCriteriaModel->selectNone(category);
+            } else {
+                for (int i = 0; i < childrenCount; ++i) {
+                    mSourceModel->setData(mSourceModel->index(i, 0, sourceIndex), false, FilterCriteriaModel::Roles::SELECTED);
+                }
             }
         }
         mSourceModel->setData(sourceIndex, value, FilterCriteriaModel::Roles::SELECTED);
@@ -8,6 +8,7 @@
 
 #include <QAbstractListModel>
 #include <QHash>
+#include <QPersistentModelIndex>
 #include <QQmlEngine>
 
 /**
@@ -44,6 +45,7 @@ public:
         EXPANDABLE = Qt::UserRole + 3, //!< indicates if node has children
         TYPE = Qt::UserRole + 4, //!< provides data type for nodes
         COLOR = Qt::UserRole + 5, //!< provides color state for node, if present
+        COUNT = Qt::UserRole + 6, //!< number of journal entries matching the node, if already counted
     };
     Q_ENUM(Roles)
 
@@ -105,6 +107,10 @@ private Q_SLOTS:
     void handleSourceModelDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
     void handleSourceModelOnModelReset();
     void handleSourceModelOnModelAboutToBeReset();
+    void handleSourceModelRowsAboutToBeInserted(const QModelIndex &parent, int first, int last);
+    void handleSourceModelRowsInserted(const QModelIndex &parent, int first, int last);
+    void handleSourceModelRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+    void handleSourceModelRowsRemoved(const QModelIndex &parent, int first, int last);
 
 Q_SIGNALS:
     /**
@@ -114,15 +120,47 @@ Q_SIGNALS:
 
 private:
     /**
-     * @brief Proxy data objects that store references to source model objects
+     * @brief Proxy state of a first level source entry
+     *
+     * Children of a category are never stored in the proxy. Their proxy rows directly follow the category row
+     * when the category is expanded, which makes mapping in both directions independent of the number of children.
      */
-    struct SourceIndex {
-        QModelIndex mSourceIndex;
+    struct CategoryEntry {
+        QPersistentModelIndex mSourceIndex;
         bool mIsExpanded{false};
-        int mIndentation{0};
     };
+
+    /**
+     * @return source index for proxy row @p row, invalid index if out of range
+     */
+    QModelIndex mapToSource(int row) const;
+
+    /**
+     * @return proxy row of @p sourceIndex or -1 if the index is not visible in the proxy
+     */
+    int mapFromSource(const QModelIndex &sourceIndex) const;
+
+    /**
+     * @return proxy row of first level entry with source row @p category
+     */
+    int categoryProxyRow(int category) const;
+
+    /**
+     * @return number of proxy rows occupied by category @p category including its visible children
+     */
+    int categoryRowSpan(int category) const;
+
+    /**
+     * @brief begin an insert or remove operation of source children that are visible in the proxy
+     * @return true if the proxy has to forward the operation
+     */
+    bool beginChildRowsChange(const QModelIndex &parent, int first, int last, bool insert);
+
     QAbstractItemModel *mSourceModel{nullptr};
-    QList<SourceIndex> mMapToSourceIndex;
+    QList<CategoryEntry> mCategories;
+    // rows operation started in the about-to-be signal handler that must be finished afterwards
+    enum class PendingChange { NONE, INSERT, REMOVE, RESET };
+    PendingChange mPendingChange{PendingChange::NONE};
 };
 
 #endif
@@ -8,10 +8,13 @@
 
 #include "kjournald_export.h"
 #include "sdjournal.h"
+#include <QFileInfoList>
 #include <QString>
 #include <QtQmlIntegration/qqmlintegration.h>
+#include <memory>
 
 class sd_journal;
+class JournalIndex;
 
 /**
  * @brief Interface class for all journal types
@@ -52,6 +55,43 @@ public:
      * @return ID for the current boot (b0) of the system, empty string if none is current
      */
     virtual QString currentBootId() const = 0;
+
+    /**
+     * @brief Journal files that back this provider
+     *
+     * The list is used to identify a journal, e.g. as key for caches. Size and modification time
+     * of the files can be used to detect changes of the journal.
+     *
+     * @return list of journal files or empty list if the files are unknown
+     */
+    virtual QFileInfoList journalFiles() const
+    {
+        return {};
+    }
+
+    /**
+     * @brief Whether entries of this journal may originate from several machines
+     *
+     * Only then readers need to look up the source of every entry.
+     *
+     * @return true if journals of different machines are merged, false by default
+     */
+    virtual bool hasMultipleSources() const
+    {
+        return false;
+    }
+
+    /**
+     * @brief In-memory index for journals that are not backed by a journald database
+     *
+     * Consumers shall prefer the index over openJournal() when it is available.
+     *
+     * @return index or nullptr if the journal is accessed via openJournal()
+     */
+    virtual std::shared_ptr<const JournalIndex> journalIndex() const
+    {
+        return nullptr;
+    }
 };
 
 #endif // IJOURNAL_H
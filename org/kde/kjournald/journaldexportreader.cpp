@@ -5,11 +5,14 @@
 
 #include "journaldexportreader.h"
 #include "kjournaldlib_log_general.h"
-#include <endian.h>
+#include <KCompressionDevice>
 #include <QDebug>
-#include <QVector>
+#include <QFile>
+#include <QFileDevice>
 #include <QIODevice>
-#include <climits>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
 
 JournaldExportReader::JournaldExportReader(QIODevice *device)
     : mDevice(device)
@@ -18,11 +21,25 @@ JournaldExportReader::JournaldExportReader(QIODevice *device)
         qCCritical(KJOURNALDLIB_GENERAL) << "Could not open device for reading";
         return;
     }
+    // decompressed data are neither mappable nor shall they be stored completely
+    if (mDevice->isSequential() || dynamic_cast<KCompressionDevice *>(mDevice)) {
+        mStreaming = true;
+        return;
+    }
+    if (auto file = qobject_cast<QFileDevice *>(mDevice); file && file->size() > 0) {
+        if (const uchar *mapped = file->map(0, file->size())) {
+            mData = QByteArrayView(mapped, file->size());
+            return;
+        }
+        qCDebug(KJOURNALDLIB_GENERAL) << "Could not memory map export file, reading it instead" << file->errorString();
+    }
+    mBuffer = mDevice->readAll();
+    mData = mBuffer;
 }
 
 bool JournaldExportReader::atEnd() const
 {
-    return mDevice->atEnd();
+    return mPosition >= mData.size() && (!mStreaming || mDeviceExhausted);
 }
 
 // Format description: <https://www.freedesktop.org/wiki/Software/systemd/export/>
@@ -47,46 +64,325 @@ bool JournaldExportReader::atEnd() const
 // - The order in which fields appear in an entry is undefined and might be different for each entry
 //   that is serialized.
 
-bool JournaldExportReader::readNext()
+namespace
+{
+// number of entries that must follow a candidate entry boundary with valid structure
+constexpr int BOUNDARY_VALIDATION_ENTRIES{2};
+
+bool isValidFieldName(QByteArrayView name)
 {
-    if (mDevice->atEnd()) {
+    // journald field names consist of uppercase letters, digits and underscores and do not begin with a digit
+    if (name.isEmpty() || name.size() > 64 || (name.front() >= '0' && name.front() <= '9')) {
         return false;
     }
+    return std::all_of(name.cbegin(), name.cend(), [](char c) {
+        return (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    });
+}
 
-    mCurrentEntry.clear();
-    while (!mDevice->atEnd()) {
-        QString line = QString::fromLocal8Bit(mDevice->readLine().trimmed());
+/**
+ * parse entry that begins at @p position of @p data into @p fields, field names are views into @p data
+ *
+ * In strict mode, any deviation from the export format is reported by returning -1, otherwise the
+ * parser recovers and warns.
+ *
+ * If @p truncated is set, @p data is a window of a stream and @p truncated is set to true if the entry
+ * (including its separating empty lines) may continue after the end of @p data. In that case, the
+ * entry must be parsed again once more data is available.
+ *
+ * @return position after the entry and its separating empty lines
+ */
+qsizetype parseEntry(QByteArrayView data, qsizetype position, QList<JournaldExportReader::Field> &fields, bool strict, bool *truncated = nullptr)
+{
+    fields.clear();
+    if (truncated) {
+        *truncated = false;
+    }
+    const char *const dataEnd = data.data() + data.size();
+    while (position < data.size()) {
+        const char *lineBegin = data.data() + position;
+        const auto lineEnd = static_cast<const char *>(std::memchr(lineBegin, '\n', dataEnd - lineBegin));
+        const QByteArrayView line(lineBegin, lineEnd ? lineEnd : dataEnd);
+        position = std::min(position + line.size() + 1, data.size());
         // empty line = beginning of new log entry
         if (line.isEmpty()) {
             break; // found break in log entry
         }
 
         // if line does not contain "=" then switch to binary reading mode
-        int separatorIndex = line.indexOf(QLatin1Char('='));
-        if (separatorIndex > 0) {
-            mCurrentEntry[line.left(separatorIndex)] = line.right(line.length() - separatorIndex - 1).trimmed();
+        const auto separator = static_cast<const char *>(std::memchr(line.data(), '=', line.size()));
+        if (separator && separator != line.data()) {
+            const qsizetype separatorIndex = separator - line.data();
+            if (strict && !isValidFieldName(line.first(separatorIndex))) {
+                return -1;
+            }
+            fields.append({line.first(separatorIndex), line.sliced(separatorIndex + 1)});
         } else {
-            QString fieldId = line;
-            union {
-                uint64_t uint64;
-                char chars[4];
-            } size;
-            qint64 bytes = mDevice->read(size.chars, 8);
-            if (bytes != 8) {
-                qCWarning(KJOURNALDLIB_GENERAL) << "Journal entry read that has unexpected number of bytes (8 bytes expected)" << bytes;
+            if (strict && !isValidFieldName(line)) {
+                return -1;
+            }
+            if (data.size() - position < 8) {
+                if (strict) {
+                    return -1;
+                }
+                if (truncated) {
+                    *truncated = true;
+                    return data.size();
+                }
+                qCWarning(KJOURNALDLIB_GENERAL) << "Journal entry read that has unexpected number of bytes (8 bytes expected)" << data.size() - position;
+                position = data.size();
+                break;
+            }
+            quint64 size = qFromLittleEndian<quint64>(data.data() + position);
+            position += 8;
+            if (size > quint64(data.size() - position)) {
+                if (strict) {
+                    return -1;
+                }
+                if (truncated) {
+                    *truncated = true;
+                    return data.size();
+                }
+                qCWarning(KJOURNALDLIB_GENERAL) << "Binary field exceeds end of export data, truncating" << line;
+                size = data.size() - position;
+            }
+            fields.append({line, data.sliced(position, qsizetype(size))});
+            position += qsizetype(size);
+            // skip line break after binary content, such that parser points to next line
+            if (position < data.size()) {
+                if (strict && data.at(position) != '\n') {
+                    return -1;
+                }
+                ++position;
             }
-            mCurrentEntry[fieldId] = QString::fromLocal8Bit(mDevice->read(le64toh(size.uint64)));
-            // read line break after binary content, such that reader points to next line
-            mDevice->read(1);
         }
     }
+    // skip additional empty lines, such that end of data is reached after last entry
+    while (position < data.size() && data.at(position) == '\n') {
+        ++position;
+    }
+    // entries that end at the end of a stream window may continue in the next window
+    if (truncated && position >= data.size()) {
+        *truncated = true;
+    }
+    return position;
+}
+
+KCompressionDevice::CompressionType compressionType(const QString &path)
+{
+    if (path.endsWith(QLatin1String(".gz"), Qt::CaseInsensitive)) {
+        return KCompressionDevice::GZip;
+    } else if (path.endsWith(QLatin1String(".bz2"), Qt::CaseInsensitive)) {
+        return KCompressionDevice::BZip2;
+    } else if (path.endsWith(QLatin1String(".xz"), Qt::CaseInsensitive)) {
+        return KCompressionDevice::Xz;
+    } else if (path.endsWith(QLatin1String(".zst"), Qt::CaseInsensitive)) {
+        return KCompressionDevice::Zstd;
+    }
+    return KCompressionDevice::None;
+}
 
+/**
+ * @return true if the data at @p position has the structure of export format entries
+ */
+bool isEntryBoundary(QByteArrayView data, qsizetype position)
+{
+    QList<JournaldExportReader::Field> fields;
+    for (int i = 0; i < BOUNDARY_VALIDATION_ENTRIES && position < data.size(); ++i) {
+        position = parseEntry(data, position, fields, true);
+        if (position < 0 || fields.isEmpty()) {
+            return false;
+        }
+    }
     return true;
 }
+}
+
+std::unique_ptr<QIODevice> JournaldExportReader::createDevice(const QString &path)
+{
+    const KCompressionDevice::CompressionType type = compressionType(path);
+    if (type != KCompressionDevice::None) {
+        return std::make_unique<KCompressionDevice>(path, type);
+    }
+    return std::make_unique<QFile>(path);
+}
+
+std::unique_ptr<QIODevice> JournaldExportReader::createDecompressionDevice(QFile *file)
+{
+    const KCompressionDevice::CompressionType type = compressionType(file->fileName());
+    if (type == KCompressionDevice::None) {
+        return nullptr;
+    }
+    return std::make_unique<KCompressionDevice>(file, false, type);
+}
+
+bool JournaldExportReader::isCompressed(const QString &path)
+{
+    return compressionType(path) != KCompressionDevice::None;
+}
+
+bool JournaldExportReader::isStreaming() const
+{
+    return mStreaming;
+}
+
+bool JournaldExportReader::readChunk()
+{
+    // drop parsed data, views into the window become invalid
+    mBuffer.remove(0, mPosition);
+    mWindowOffset += mPosition;
+    mPosition = 0;
+
+    const qsizetype size = mBuffer.size();
+    mBuffer.resize(size + STREAMING_CHUNK_SIZE);
+    qint64 bytesRead = mDevice->read(mBuffer.data() + size, STREAMING_CHUNK_SIZE);
+    if (bytesRead == 0 && mDevice->isSequential() && mDevice->waitForReadyRead(STREAMING_READ_TIMEOUT)) {
+        bytesRead = mDevice->read(mBuffer.data() + size, STREAMING_CHUNK_SIZE);
+    }
+    if (bytesRead < 0) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Could not read export data:" << mDevice->errorString();
+    }
+    mBuffer.resize(size + std::max<qint64>(bytesRead, 0));
+    mData = mBuffer;
+    mDeviceExhausted = bytesRead <= 0;
+    return !mDeviceExhausted;
+}
+
+QByteArrayView JournaldExportReader::internFieldName(QByteArrayView name)
+{
+    auto it = mFieldNames.constFind(QByteArray::fromRawData(name.data(), name.size()));
+    if (it == mFieldNames.cend()) {
+        it = mFieldNames.insert(name.toByteArray(), QString::fromUtf8(name));
+    }
+    // data of the key is heap allocated and hence stable also when the hash is rehashed
+    return it.key();
+}
+
+bool JournaldExportReader::readNext()
+{
+    if (atEnd()) {
+        return false;
+    }
+
+    if (mStreaming) {
+        // parse again with more data whenever the entry reaches the end of the window
+        bool truncated{true};
+        qsizetype next{mPosition};
+        while (truncated) {
+            next = parseEntry(mData, mPosition, mFields, false, mDeviceExhausted ? nullptr : &truncated);
+            if (mDeviceExhausted) {
+                truncated = false;
+            } else if (truncated) {
+                readChunk();
+            }
+        }
+        mPosition = next;
+        if (mFields.isEmpty() && atEnd()) {
+            return false;
+        }
+    } else {
+        mPosition = parseEntry(mData, mPosition, mFields, false);
+    }
+    for (Field &field : mFields) {
+        field.name = internFieldName(field.name);
+    }
+    return true;
+}
+
+QList<JournaldExportReader::Partition> JournaldExportReader::partitions(int count) const
+{
+    if (mStreaming) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Partitioning is not supported for streamed export data";
+        return {};
+    }
+    QList<Partition> result;
+    qsizetype begin{0};
+    for (int i = 1; i < count; ++i) {
+        // search first validated entry boundary after the evenly distributed split position
+        qsizetype candidate = mData.size() / count * i;
+        qsizetype boundary{mData.size()};
+        while (candidate < mData.size()) {
+            const qsizetype separator = mData.indexOf("\n\n", candidate);
+            if (separator < 0) {
+                break;
+            }
+            qsizetype position = separator + 2;
+            while (position < mData.size() && mData.at(position) == '\n') {
+                ++position;
+            }
+            if (position < mData.size() && isEntryBoundary(mData, position)) {
+                boundary = position;
+                break;
+            }
+            candidate = separator + 1;
+        }
+        if (boundary <= begin || boundary >= mData.size()) {
+            continue;
+        }
+        result.append({begin, boundary});
+        begin = boundary;
+    }
+    result.append({begin, mData.size()});
+    return result;
+}
+
+qsizetype JournaldExportReader::parsePartition(const Partition &partition, const std::function<void(qsizetype offset, const QList<Field> &fields)> &handler) const
+{
+    QList<Field> fields;
+    qsizetype position = partition.begin;
+    while (position < partition.end) {
+        const qsizetype offset = position;
+        position = parseEntry(mData, position, fields, false);
+        if (!fields.isEmpty()) {
+            handler(offset, fields);
+        }
+    }
+    return position;
+}
+
+qsizetype JournaldExportReader::position() const
+{
+    return mWindowOffset + mPosition;
+}
+
+bool JournaldExportReader::seek(qsizetype position)
+{
+    if (mStreaming) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Seeking is not supported for streamed export data";
+        return false;
+    }
+    if (position < 0 || position > mData.size()) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Cannot seek to position outside of export data" << position;
+        return false;
+    }
+    mPosition = position;
+    mFields.clear();
+    return true;
+}
+
+const QList<JournaldExportReader::Field> &JournaldExportReader::fields() const
+{
+    return mFields;
+}
+
+QByteArrayView JournaldExportReader::value(QByteArrayView name) const
+{
+    for (const Field &field : mFields) {
+        if (field.name == name) {
+            return field.value;
+        }
+    }
+    return {};
+}
 
 JournaldExportReader::LogEntry JournaldExportReader::entry() const
 {
-    return mCurrentEntry;
+    LogEntry entry;
+    entry.reserve(mFields.size());
+    for (const Field &field : mFields) {
+        entry.insert(mFieldNames.value(QByteArray::fromRawData(field.name.data(), field.name.size())), QString::fromUtf8(field.value));
+    }
+    return entry;
 }
 
 #include "moc_journaldexportreader.cpp"
@@ -7,25 +7,160 @@
 #define JOURNALDEXPORTREADER_H
 
 #include "kjournald_export.h"
-#include <QObject>
-#include <QTextStream>
+#include <QByteArray>
+#include <QByteArrayView>
 #include <QHash>
+#include <QList>
+#include <QObject>
+#include <functional>
+#include <memory>
 
+class QFile;
 class QIODevice;
 
+/**
+ * @brief Parser for the journald export format
+ *
+ * File devices are memory mapped, all other random access devices are read completely into memory on
+ * construction. Parsed fields reference the mapped data directly, such that no per field allocations are
+ * needed.
+ *
+ * Sequential devices and decompressing devices (see createDevice()) are read in streaming mode: only
+ * a window of the decompressed data around the current entry is kept in memory and field views of an
+ * entry are only valid until the next call of readNext(). Seeking and partitioning are not supported
+ * in streaming mode.
+ *
+ * For parallel parsing, the data can be split into partitions that begin at entry boundaries. Since
+ * binary fields may contain empty lines, boundaries are found by validating the field structure of the
+ * following entries. Consumers must still check that the parse of a partition ends exactly at the begin
+ * of the next partition and otherwise parse the next partition again from where the previous one ended.
+ */
 class KJOURNALD_EXPORT JournaldExportReader : public QObject
 {
     Q_OBJECT
 public:
     using LogEntry = QHash<QString, QString>;
 
+    /**
+     * @brief Field of the current entry
+     *
+     * Both views are only valid until the reader is destroyed or the device is closed. The name
+     * view points to an interned copy of the field name, i.e. views for the same field name of
+     * different entries reference the same data.
+     */
+    struct Field {
+        QByteArrayView name;
+        QByteArrayView value;
+    };
+
+    /**
+     * @brief Byte range of the export data, the begin is an entry boundary
+     */
+    struct Partition {
+        qsizetype begin{0};
+        qsizetype end{0}; //!< begin of next partition or end of data
+    };
+
     explicit JournaldExportReader(QIODevice *device);
+
+    /**
+     * @brief Create a device for the export file at @p path
+     *
+     * Files with suffix ".gz", ".bz2", ".xz" or ".zst" are decompressed while being read.
+     *
+     * @return device that is not yet opened
+     */
+    static std::unique_ptr<QIODevice> createDevice(const QString &path);
+
+    /**
+     * @brief Create a device that decompresses the data read from @p file
+     *
+     * The compression type is derived from the file name of @p file. Since the compressed data is read
+     * through @p file, its position tells how much of the input is consumed. The returned device does not
+     * take ownership of @p file, which must outlive the device.
+     *
+     * @return device that is not yet opened, or nullptr if the file is not compressed and shall be read directly
+     */
+    static std::unique_ptr<QIODevice> createDecompressionDevice(QFile *file);
+
+    /**
+     * @return true if the file at @p path is decompressed by the device of createDevice()
+     */
+    static bool isCompressed(const QString &path);
+
+    /**
+     * @return true if the device is read in streaming mode
+     */
+    bool isStreaming() const;
+
     bool atEnd() const;
     bool readNext();
+
+    /**
+     * @return byte offset in the (decompressed) export data at which the next call of readNext() starts parsing
+     */
+    qsizetype position() const;
+
+    /**
+     * @brief Continue parsing at byte offset @p position, which must be the begin of an entry
+     * @return true if position is within the export data, always false in streaming mode
+     */
+    bool seek(qsizetype position);
+
+    /**
+     * @return fields of the current entry in the order of the export data
+     */
+    const QList<Field> &fields() const;
+
+    /**
+     * @return value of field @p name of the current entry or null view if it does not exist
+     */
+    QByteArrayView value(QByteArrayView name) const;
+
+    /**
+     * @brief Split export data into at most @p count partitions of similar size
+     * @return ordered partitions that cover the whole export data, empty list in streaming mode
+     */
+    QList<Partition> partitions(int count) const;
+
+    /**
+     * @brief Parse all entries that begin within @p partition
+     *
+     * This method does not change the reader state and can be called concurrently for different
+     * partitions. In contrast to fields(), the field names are not interned but point into the export data.
+     *
+     * @param handler called with byte offset and fields of every entry in file order
+     * @return position after the last parsed entry, which equals partition end if the next partition begins at a real entry boundary
+     */
+    qsizetype parsePartition(const Partition &partition, const std::function<void(qsizetype offset, const QList<Field> &fields)> &handler) const;
+
+    /**
+     * @brief Convenience method that converts all fields of the current entry
+     *
+     * This allocates strings for all fields, prefer fields() for performance critical code.
+     */
     LogEntry entry() const;
 
 private:
+    QByteArrayView internFieldName(QByteArrayView name);
+
+    /**
+     * @brief streaming mode: drop parsed data from window and append next chunk of device data
+     * @return false if device does not provide more data
+     */
+    bool readChunk();
+
+    static constexpr qsizetype STREAMING_CHUNK_SIZE{1024 * 1024};
+    static constexpr int STREAMING_READ_TIMEOUT{30'000}; //!< msecs to wait for data of sequential devices
+
     QIODevice *mDevice{};
-    LogEntry mCurrentEntry;
+    QByteArray mBuffer; //!< data of devices that cannot be memory mapped or window of streamed data
+    QByteArrayView mData;
+    qsizetype mPosition{0};
+    bool mStreaming{false};
+    bool mDeviceExhausted{false}; //!< streaming mode: all data of device are in the window
+    qsizetype mWindowOffset{0}; //!< streaming mode: offset of the window begin in the export data
+    QList<Field> mFields;
+    QHash<QByteArray, QString> mFieldNames; //!< interned field names and their string representation
 };
 #endif
@@ -4,10 +4,16 @@
 */
 
 #include "journaldhelper.h"
+#include "journalindex.h"
 #include "kjournaldlib_log_general.h"
+#include "sdjournal.h"
+#include <QCryptographicHash>
 #include <QDebug>
 #include <QMetaEnum>
+#include <QMutex>
 #include <QString>
+#include <QThread>
+#include <QtConcurrentMap>
 #include <systemd/sd-journal.h>
 
 namespace
@@ -26,6 +32,18 @@ constexpr int hexValue(const QChar &c)
     }
     return -1;
 }
+
+void sortBoots(QList<JournaldHelper::BootInfo> &boots)
+{
+    std::sort(boots.begin(), boots.end(), [](const JournaldHelper::BootInfo &lhs, const JournaldHelper::BootInfo &rhs) {
+        return lhs.mSince < rhs.mSince;
+    });
+}
+
+// cache for boot information, key is the fingerprint of the journal files
+QMutex sBootInfoCacheMutex;
+QHash<QByteArray, QList<JournaldHelper::BootInfo>> sBootInfoCache;
+constexpr qsizetype BOOT_INFO_CACHE_SIZE{16};
 }
 
 QList<QString> JournaldHelper::queryUnique(sd_journal *journal, Field field)
@@ -56,6 +74,66 @@ QList<QString> JournaldHelper::queryUnique(sd_journal *journal, Field field)
     return dataList;
 }
 
+std::optional<JournaldHelper::BootInfo> JournaldHelper::queryBootInfo(sd_journal *journal, const QString &id)
+{
+    if (!journal) {
+        qCritical() << "Failed query boot info, sd_journal is null";
+        return std::nullopt;
+    }
+
+    int result{0};
+    uint64_t time{0};
+
+    sd_journal_flush_matches(journal);
+    QString filterExpression = QLatin1String("_BOOT_ID=") + id;
+    result = sd_journal_add_match(journal, filterExpression.toStdString().c_str(), filterExpression.length());
+    if (result < 0) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "Failed add filter:" << strerror(-result);
+        return std::nullopt;
+    }
+
+    QDateTime since;
+    result = sd_journal_seek_head(journal);
+    if (result < 0) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "Failed to seek head:" << strerror(-result);
+        return std::nullopt;
+    }
+    result = sd_journal_next(journal);
+    if (result < 0) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "Failed to obtain first entry:" << strerror(-result);
+        return std::nullopt;
+    }
+    result = sd_journal_get_realtime_usec(journal, &time);
+    if (result == 0) {
+        since.setMSecsSinceEpoch(time / 1000);
+    } else {
+        qCCritical(KJOURNALDLIB_GENERAL) << "Failed to obtain time:" << strerror(-result);
+    }
+
+    QDateTime until;
+    result = sd_journal_seek_tail(journal);
+    if (result < 0) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "Failed to seek tail:" << strerror(-result);
+        return std::nullopt;
+    }
+    result = sd_journal_previous(journal);
+    if (result < 0) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "Failed to obtain first entry:" << strerror(-result);
+    }
+    result = sd_journal_get_realtime_usec(journal, &time);
+    if (result == 0) {
+        until.setMSecsSinceEpoch(time / 1000);
+    } else {
+        qCCritical(KJOURNALDLIB_GENERAL) << "Failed to obtain time:" << strerror(-result);
+    }
+
+    if (!since.isValid() || !until.isValid()) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "Could not correctly parse start/end time for boot" << id << "skipping from list";
+        return std::nullopt;
+    }
+    return BootInfo{id, since, until};
+}
+
 QList<JournaldHelper::BootInfo> JournaldHelper::queryOrderedBootIds(sd_journal *journal)
 {
     if (!journal) {
@@ -65,72 +143,155 @@ QList<JournaldHelper::BootInfo> JournaldHelper::queryOrderedBootIds(sd_journal *
     QList<JournaldHelper::BootInfo> boots;
     const QList<QString> bootIds = JournaldHelper::queryUnique(journal, Field::_BOOT_ID);
     for (const QString &id : bootIds) {
-        int result{0};
-        uint64_t time{0};
-
-        sd_journal_flush_matches(journal);
-        QString filterExpression = QLatin1String("_BOOT_ID=") + id;
-        result = sd_journal_add_match(journal, filterExpression.toStdString().c_str(), filterExpression.length());
-        if (result < 0) {
-            qCCritical(KJOURNALDLIB_GENERAL) << "Failed add filter:" << strerror(-result);
-            continue;
+        if (auto bootInfo = queryBootInfo(journal, id)) {
+            boots << bootInfo.value();
         }
+    }
+    sortBoots(boots);
+    return boots;
+}
 
-        QDateTime since;
-        result = sd_journal_seek_head(journal);
-        if (result < 0) {
-            qCCritical(KJOURNALDLIB_GENERAL) << "Failed to seek head:" << strerror(-result);
-            continue;
-        }
-        result = sd_journal_next(journal);
-        if (result < 0) {
-            qCCritical(KJOURNALDLIB_GENERAL) << "Failed to obtain first entry:" << strerror(-result);
-            continue;
-        }
-        result = sd_journal_get_realtime_usec(journal, &time);
-        if (result == 0) {
-            since.setMSecsSinceEpoch(time / 1000);
-        } else {
-            qCCritical(KJOURNALDLIB_GENERAL) << "Failed to obtain time:" << strerror(-result);
-        }
+QList<JournaldHelper::BootInfo> JournaldHelper::queryOrderedBootIds(const IJournalProvider *provider)
+{
+    if (!provider) {
+        qCritical() << "Failed query ordered boot ids, provider is null";
+        return {};
+    }
+    if (const std::shared_ptr<const JournalIndex> index = provider->journalIndex()) {
+        return index->bootInfo();
+    }
 
-        QDateTime until;
-        result = sd_journal_seek_tail(journal);
-        if (result < 0) {
-            qCCritical(KJOURNALDLIB_GENERAL) << "Failed to seek tail:" << strerror(-result);
-            continue;
-        }
-        result = sd_journal_previous(journal);
-        if (result < 0) {
-            qCCritical(KJOURNALDLIB_GENERAL) << "Failed to obtain first entry:" << strerror(-result);
-        }
-        result = sd_journal_get_realtime_usec(journal, &time);
-        if (result == 0) {
-            until.setMSecsSinceEpoch(time / 1000);
-        } else {
-            qCCritical(KJOURNALDLIB_GENERAL) << "Failed to obtain time:" << strerror(-result);
+    const QByteArray fingerprint = journalFilesFingerprint(provider->journalFiles());
+    if (!fingerprint.isEmpty()) {
+        QMutexLocker locker(&sBootInfoCacheMutex);
+        auto iter = sBootInfoCache.constFind(fingerprint);
+        if (iter != sBootInfoCache.cend()) {
+            qCDebug(KJOURNALDLIB_GENERAL) << "Use cached boot information for journal files" << fingerprint.toHex();
+            return iter.value();
         }
+    }
 
-        if (since.isValid() && until.isValid()) {
-            boots << BootInfo{id, since, until};
-        } else {
-            qCCritical(KJOURNALDLIB_GENERAL) << "Could not correctly parse start/end time for boot" << id << "skipping from list";
-        }
+    std::unique_ptr<SdJournal> journal = provider->openJournal();
+    if (!journal || !journal->isValid()) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Failed query ordered boot ids, journal is invalid";
+        return {};
+    }
+    const QList<QString> bootIds = JournaldHelper::queryUnique(journal->get(), Field::_BOOT_ID);
+    if (bootIds.isEmpty()) {
+        return {};
     }
 
-    std::sort(boots.begin(), boots.end(), [](const JournaldHelper::BootInfo &lhs, const JournaldHelper::BootInfo &rhs) {
-        return lhs.mSince < rhs.mSince;
-    });
+    // distribute boots over workers, every worker uses its own sd_journal object
+    // because those must not be shared between threads
+    const qsizetype workerCount = std::min<qsizetype>(std::max(1, QThread::idealThreadCount()), bootIds.size());
+    QList<QList<QString>> partitions(workerCount);
+    for (qsizetype i = 0; i < bootIds.size(); ++i) {
+        partitions[i % workerCount].append(bootIds.at(i));
+    }
+    const QList<QList<BootInfo>> partialBoots =
+        QtConcurrent::blockingMapped<QList<QList<BootInfo>>>(partitions, [provider](const QList<QString> &ids) -> QList<BootInfo> {
+            std::unique_ptr<SdJournal> workerJournal = provider->openJournal();
+            if (!workerJournal || !workerJournal->isValid()) {
+                qCWarning(KJOURNALDLIB_GENERAL) << "Could not open journal for boot enumeration worker";
+                return {};
+            }
+            QList<BootInfo> infos;
+            for (const QString &id : ids) {
+                if (auto bootInfo = queryBootInfo(workerJournal->get(), id)) {
+                    infos << bootInfo.value();
+                }
+            }
+            return infos;
+        });
 
+    QList<BootInfo> boots;
+    boots.reserve(bootIds.size());
+    for (const auto &partition : partialBoots) {
+        boots << partition;
+    }
+    sortBoots(boots);
+
+    if (!fingerprint.isEmpty()) {
+        QMutexLocker locker(&sBootInfoCacheMutex);
+        if (sBootInfoCache.size() >= BOOT_INFO_CACHE_SIZE) {
+            sBootInfoCache.clear();
+        }
+        sBootInfoCache.insert(fingerprint, boots);
+    }
     return boots;
 }
 
+QByteArray JournaldHelper::journalFilesFingerprint(const QFileInfoList &files)
+{
+    if (files.isEmpty()) {
+        return {};
+    }
+    QStringList identities;
+    identities.reserve(files.size());
+    for (const QFileInfo &file : files) {
+        identities << QStringLiteral("%1:%2:%3").arg(file.absoluteFilePath()).arg(file.size()).arg(file.lastModified().toMSecsSinceEpoch());
+    }
+    identities.sort();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const QString &identity : std::as_const(identities)) {
+        hash.addData(identity.toUtf8());
+    }
+    return hash.result();
+}
+
 QList<QString> JournaldHelper::queryUnique(sd_journal *journal, QAnyStringView bootId, Field field)
 {
     return queryUnique(journal, bootId, QList({field})).value(field);
 }
 
 QMap<JournaldHelper::Field, QStringList> JournaldHelper::queryUnique(sd_journal *journal, QAnyStringView bootId, QList<Field> fields)
+{
+    if (!journal) {
+        qCritical() << "Failed query unique, sd_journal is null";
+        return {};
+    }
+
+    const QByteArray bootMatch = QString(QStringLiteral("%1=%2")).arg(mapField(Field::_BOOT_ID), bootId).toUtf8();
+    QMap<Field, QStringList> entryMap;
+    for (const Field field : std::as_const(fields)) {
+        const QLatin1StringView fieldId = mapField(field);
+
+        // collect candidates first, data pointers are invalidated by following journal accesses
+        QList<QByteArray> candidates;
+        const void *data{nullptr};
+        size_t length{0};
+        int result = sd_journal_query_unique(journal, fieldId.data());
+        if (result < 0) {
+            qCCritical(KJOURNALDLIB_GENERAL) << "Failed to query journal:" << strerror(-result);
+            continue;
+        }
+        SD_JOURNAL_FOREACH_UNIQUE(journal, data, length)
+        {
+            candidates.append(QByteArray(static_cast<const char *>(data), length));
+        }
+
+        // value is part of the boot if at least one entry matches both value and boot id
+        QStringList values;
+        for (const QByteArray &candidate : std::as_const(candidates)) {
+            sd_journal_flush_matches(journal);
+            if (sd_journal_add_match(journal, candidate.constData(), candidate.size()) < 0
+                || sd_journal_add_match(journal, bootMatch.constData(), bootMatch.size()) < 0) {
+                qCCritical(KJOURNALDLIB_GENERAL) << "Failed add filter for" << candidate;
+                continue;
+            }
+            sd_journal_seek_head(journal);
+            if (sd_journal_next(journal) > 0) {
+                // entry starts with "_ID=", remove that part
+                values.append(QString::fromUtf8(candidate.constData() + fieldId.size() + 1, candidate.size() - fieldId.size() - 1));
+            }
+        }
+        entryMap.insert(field, values);
+    }
+    sd_journal_flush_matches(journal);
+    return entryMap;
+}
+
+QMap<JournaldHelper::Field, QStringList> JournaldHelper::queryUniqueByScan(sd_journal *journal, QAnyStringView bootId, QList<Field> fields)
 {
     auto generateIds = [](const auto &fields) {
         QVarLengthArray<QLatin1StringView, 1> ids(fields.size());
@@ -172,6 +333,149 @@ QMap<JournaldHelper::Field, QStringList> JournaldHelper::queryUnique(sd_journal
     return entryMap;
 }
 
+QMap<JournaldHelper::Field, QHash<QString, quint64>>
+JournaldHelper::queryUniqueCounts(sd_journal *journal, QAnyStringView bootId, QList<Field> fields, const QString &afterCursor, QString *lastCursor)
+{
+    QVarLengthArray<QLatin1StringView, 8> fieldIds(fields.size());
+    for (int i = 0; i < fields.size(); ++i) {
+        fieldIds[i] = mapField(fields[i]);
+    }
+    // count on raw data to convert every distinct value only once
+    QVarLengthArray<QHash<QByteArray, quint64>, 8> rawCounts(fields.size());
+
+    const char *data{nullptr};
+    size_t length{0};
+    int result{0};
+
+    sd_journal_flush_matches(journal);
+    sd_journal_seek_head(journal);
+
+    QString filterExpression = QString(QStringLiteral("%1=%2")).arg(mapField(Field::_BOOT_ID), bootId);
+    result = sd_journal_add_match(journal, filterExpression.toLocal8Bit().constData(), filterExpression.length());
+    if (result < 0) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "Failed add filter:" << strerror(-result);
+        return {};
+    }
+    const QByteArray afterCursorData = afterCursor.toUtf8();
+    bool skipCursorEntry{false};
+    if (!afterCursor.isEmpty()) {
+        result = sd_journal_seek_cursor(journal, afterCursorData.constData());
+        if (result < 0) {
+            qCCritical(KJOURNALDLIB_GENERAL) << "Failed to seek cursor:" << strerror(-result);
+            return {};
+        }
+        skipCursorEntry = true;
+    }
+    bool anyEntryCounted{false};
+    while (sd_journal_next(journal) > 0) {
+        if (skipCursorEntry) {
+            // seeking places the read pointer onto the cursor entry, if it still exists
+            skipCursorEntry = false;
+            if (sd_journal_test_cursor(journal, afterCursorData.constData()) > 0) {
+                continue;
+            }
+        }
+        anyEntryCounted = true;
+        for (int i = 0; i < fields.size(); ++i) {
+            result = sd_journal_get_data(journal, fieldIds[i].data(), (const void **)&data, &length);
+            if (result == 0) {
+                // entry starts with "_ID=", remove that part
+                const qsizetype offset = fieldIds[i].size() + 1;
+                ++rawCounts[i][QByteArray(data + offset, static_cast<qsizetype>(length) - offset)];
+            }
+        }
+    }
+    if (lastCursor) {
+        *lastCursor = afterCursor;
+        char *cursor{nullptr};
+        // at the end of the journal, the read pointer stays at the last entry
+        if (anyEntryCounted && sd_journal_get_cursor(journal, &cursor) == 0) {
+            *lastCursor = QString::fromUtf8(cursor);
+            free(cursor);
+        }
+    }
+
+    QMap<Field, QHash<QString, quint64>> counts;
+    for (int i = 0; i < fields.size(); ++i) {
+        QHash<QString, quint64> &fieldCounts = counts[fields.at(i)];
+        fieldCounts.reserve(rawCounts.at(i).size());
+        for (auto iter = rawCounts.at(i).cbegin(); iter != rawCounts.at(i).cend(); ++iter) {
+            fieldCounts.insert(QString::fromUtf8(iter.key()), iter.value());
+        }
+    }
+    return counts;
+}
+
+std::optional<JournaldHelper::Cursor> JournaldHelper::parseCursor(QStringView cursor)
+{
+    Cursor result;
+    bool anyFieldFound{false};
+    for (const QStringView token : cursor.tokenize(QLatin1Char(';'))) {
+        if (token.size() < 2 || token.at(1) != QLatin1Char('=')) {
+            continue;
+        }
+        const QStringView value = token.mid(2);
+        bool ok{false};
+        switch (token.at(0).unicode()) {
+        case 's':
+            result.mSeqnumId = value.toLatin1();
+            anyFieldFound = true;
+            break;
+        case 'i':
+            result.mSeqnum = value.toULongLong(&ok, 16);
+            result.mHasSeqnum = ok;
+            anyFieldFound |= ok;
+            break;
+        case 'b':
+            result.mBootId = value.toLatin1();
+            anyFieldFound = true;
+            break;
+        case 'm':
+            result.mMonotonicUsec = value.toULongLong(&ok, 16);
+            result.mHasMonotonic = ok;
+            anyFieldFound |= ok;
+            break;
+        case 't':
+            result.mRealtimeUsec = value.toULongLong(&ok, 16);
+            result.mHasRealtime = ok;
+            anyFieldFound |= ok;
+            break;
+        case 'x':
+            result.mXorHash = value.toULongLong(&ok, 16);
+            result.mHasXorHash = ok;
+            anyFieldFound |= ok;
+            break;
+        default:
+            // ignore unknown fields, e.g. file name "p"
+            break;
+        }
+    }
+    if (!anyFieldFound) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+bool JournaldHelper::Cursor::isSameEntry(const Cursor &other) const
+{
+    if (!mSeqnumId.isEmpty() && mSeqnumId == other.mSeqnumId && mHasSeqnum && other.mHasSeqnum && mSeqnum != other.mSeqnum) {
+        return false;
+    }
+    if (!mBootId.isEmpty() && !other.mBootId.isEmpty() && mBootId != other.mBootId) {
+        return false;
+    }
+    if (mHasMonotonic && other.mHasMonotonic && mMonotonicUsec != other.mMonotonicUsec) {
+        return false;
+    }
+    if (mHasRealtime && other.mHasRealtime && mRealtimeUsec != other.mRealtimeUsec) {
+        return false;
+    }
+    if (mHasXorHash && other.mHasXorHash && mXorHash != other.mXorHash) {
+        return false;
+    }
+    return true;
+}
+
 QLatin1StringView JournaldHelper::mapField(JournaldHelper::Field field)
 {
     switch (field) {
@@ -277,6 +581,44 @@ QString JournaldHelper::cleanupString(QStringView string)
     return cleaned;
 }
 
+JournaldHelper::UnitName JournaldHelper::normalizeUnit(QStringView unit)
+{
+    UnitName result;
+    result.mName = cleanupString(unit);
+    const qsizetype at = result.mName.indexOf(QLatin1Char('@'));
+    const qsizetype suffix = result.mName.lastIndexOf(QLatin1String(".service"));
+    if (at >= 0 && suffix > at + 1) {
+        result.mInstance = result.mName.mid(at + 1, suffix - at - 1);
+        result.mTemplate = QStringView(result.mName).left(at + 1) + QStringView(result.mName).mid(suffix);
+    } else {
+        result.mTemplate = result.mName;
+    }
+    return result;
+}
+
+JournaldHelper::UnitName UnitNameCache::normalize(QByteArrayView unit)
+{
+    // lookup without copying the key
+    const QByteArray key = QByteArray::fromRawData(unit.data(), unit.size());
+    auto iter = mCache.constFind(key);
+    if (iter != mCache.cend()) {
+        return iter.value();
+    }
+    const JournaldHelper::UnitName name = JournaldHelper::normalizeUnit(QString::fromUtf8(unit));
+    mCache.insert(QByteArray(unit.data(), unit.size()), name);
+    return name;
+}
+
+JournaldHelper::UnitName UnitNameCache::normalize(const QString &unit)
+{
+    return normalize(QByteArrayView(unit.toUtf8()));
+}
+
+void UnitNameCache::clear()
+{
+    mCache.clear();
+}
+
 QDebug operator<<(QDebug debug, const JournaldHelper::BootInfo &bootInfo)
 {
     QDebugStateSaver saver(debug);
@@ -9,9 +9,11 @@
 #include "kjournald_export.h"
 #include <QDateTime>
 #include <QDebugStateSaver>
+#include <QHash>
 #include <QObject>
 #include <QVector>
 #include <ijournalprovider.h>
+#include <optional>
 
 class KJOURNALD_EXPORT JournaldHelper
 {
@@ -26,6 +28,51 @@ public:
         QDateTime mUntil; //!< time of newest log entry for the specific boot
     };
 
+    /**
+     * @brief Normalized systemd unit name
+     *
+     * For template instances like "foo@bar.service" the template is "foo@.service" and the instance
+     * is "bar". For all other units the template equals the name and the instance is empty.
+     */
+    struct UnitName {
+        QString mName; //!< cleaned unit name
+        QString mTemplate; //!< cleaned template name, or unit name for non-template units
+        QString mInstance; //!< cleaned template argument, empty for non-template units
+
+        bool isTemplateInstance() const
+        {
+            return !mInstance.isEmpty();
+        }
+    };
+
+    /**
+     * @brief Decomposed journald cursor
+     *
+     * A journald cursor is an opaque string, which in practice is a semicolon separated list of
+     * "key=value" pairs. The most relevant ones are the seqnum (i), boot id (b), monotonic (m) and
+     * realtime (t) timestamps, which allow to position the journal close to the entry.
+     */
+    struct Cursor {
+        QByteArray mSeqnumId; //!< ID of the seqnum domain, field "s"
+        quint64 mSeqnum{0}; //!< sequence number of the entry, field "i"
+        QByteArray mBootId; //!< boot ID of the entry, field "b"
+        quint64 mMonotonicUsec{0}; //!< monotonic timestamp in usec, field "m"
+        quint64 mRealtimeUsec{0}; //!< realtime timestamp in usec, field "t"
+        quint64 mXorHash{0}; //!< XOR hash over all entry fields, field "x"
+        bool mHasSeqnum{false};
+        bool mHasMonotonic{false};
+        bool mHasRealtime{false};
+        bool mHasXorHash{false};
+
+        /**
+         * @return true if @p other points to the same journal entry as this cursor
+         *
+         * Seqnums are only compared when both cursors belong to the same seqnum domain, because
+         * the same entry might be found in different journal files.
+         */
+        bool isSameEntry(const Cursor &other) const;
+    };
+
     /**
      * @brief Enumeration of most prominent field contents
      *
@@ -77,8 +124,8 @@ public:
      * @brief Collect unique field entries for specified boot
      *
      * This method collects all distinct field values for the given boot. Note that the computational
-     * complexity is O(N) with N number of entries in the journal. Also beware, that read pointer and
-     * filter options change of the used sd_journal object.
+     * complexity is O(V log N) with V number of distinct field values and N number of entries in the
+     * journal. Also beware, that read pointer and filter options change of the used sd_journal object.
      *
      * @param journal the openend journal
      * @param bootId the boot ID
@@ -90,19 +137,63 @@ public:
     /**
      * @brief Collect multiple unique field entries for specified boot
      *
-     * This method collects all distinct field values for the given boot of multiple fields simultaneously
-     * Note that the computational complexity is O(N) with N number of entries in the journal. Also beware,
-     * that read pointer and filter options change of the used sd_journal object.
-     *
-     * Prefer this method over requesting every field seperately.
+     * This method enumerates all distinct values of each field in the journal and keeps those for which
+     * at least one entry of the given boot exists. The computational complexity hence is O(V log N) with
+     * V number of distinct field values and N number of entries in the journal. Beware that read pointer
+     * and filter options change of the used sd_journal object.
      *
      * @param journal the openend journal
      * @param bootId the boot ID
-     * @param field the field identifier
-     * @return list of distinct values for field
+     * @param fields the field identifiers
+     * @return map from each requested field to the list of its distinct values, fields that could not be
+     *         queried are missing
      */
     static QMap<Field, QStringList> queryUnique(sd_journal *journal, QAnyStringView bootId, QList<Field> fields);
 
+    /**
+     * @brief Collect multiple unique field entries for specified boot by reading every entry of the boot
+     *
+     * Reference implementation for queryUnique(), computational complexity is O(N) with N number of
+     * entries in the journal. Also beware, that read pointer and filter options change of the used
+     * sd_journal object.
+     *
+     * @param journal the openend journal
+     * @param bootId the boot ID
+     * @param fields the field identifiers
+     * @return map from each requested field to the list of its distinct values, empty if the boot filter
+     *         cannot be applied
+     */
+    static QMap<Field, QStringList> queryUniqueByScan(sd_journal *journal, QAnyStringView bootId, QList<Field> fields);
+
+    /**
+     * @brief Count the entries of a boot per distinct value of multiple fields
+     *
+     * All entries of the boot are read exactly once, similar to "journalctl -b | sort | uniq -c" for each
+     * field. The keys of the returned counts are the unique field values of the boot. Computational
+     * complexity is O(N) with N number of entries of the boot. Read pointer and filter options of the
+     * used sd_journal object change.
+     *
+     * For growing journals, the counting can be continued incrementally: only entries after @p afterCursor
+     * are counted and the cursor of the last counted entry is written to @p lastCursor.
+     *
+     * @param journal the openend journal
+     * @param bootId the boot ID
+     * @param fields the field identifiers
+     * @param afterCursor cursor of the last entry that was already counted, empty to count all entries
+     * @param lastCursor if set, receives the cursor of the last counted entry or @p afterCursor if no entry was counted
+     * @return number of entries per field value for every field
+     */
+    static QMap<Field, QHash<QString, quint64>>
+    queryUniqueCounts(sd_journal *journal, QAnyStringView bootId, QList<Field> fields, const QString &afterCursor = QString(), QString *lastCursor = nullptr);
+
+    /**
+     * @brief Query first and last entry time of boot @p bootId in @p journal
+     *
+     * @note this resets all matches of @p journal
+     * @return boot information or std::nullopt if the boot has no entries in @p journal
+     */
+    static std::optional<BootInfo> queryBootInfo(sd_journal *journal, const QString &bootId);
+
     /**
      * @brief Query boot information for @p journal
      *
@@ -110,6 +201,31 @@ public:
      */
     static QList<BootInfo> queryOrderedBootIds(sd_journal *journal);
 
+    /**
+     * @brief Query boot information for all journal files of @p provider
+     *
+     * Boots are queried in parallel, each worker operating on its own journal object opened
+     * from @p provider. Results are cached per fingerprint of the journal files (path, size and
+     * modification time), such that repeated queries on unchanged journals return immediately.
+     *
+     * @return ordered list of boots (first is earliest boot in time)
+     */
+    static QList<BootInfo> queryOrderedBootIds(const IJournalProvider *provider);
+
+    /**
+     * @brief Compute an identity hash for @p files from their paths, sizes and modification times
+     *
+     * @return fingerprint or empty byte array if @p files is empty
+     */
+    static QByteArray journalFilesFingerprint(const QFileInfoList &files);
+
+    /**
+     * @brief Parse the fields of journald cursor @p cursor
+     *
+     * @return parsed cursor or std::nullopt if string does not contain any known cursor field
+     */
+    static std::optional<Cursor> parseCursor(QStringView cursor);
+
     /**
      * @brief Mapper method that maps from field enum to textual representation
      *
@@ -125,6 +241,17 @@ public:
      */
     static QString cleanupString(QStringView string);
 
+    /**
+     * @brief Clean up unit name @p unit and split it into template and instance
+     *
+     * Only service units are considered as template instances, the template argument reaches
+     * from the first '@' to the last ".service" of the cleaned name.
+     *
+     * @param unit the unit name as stored in the journal
+     * @return normalized unit name
+     */
+    static UnitName normalizeUnit(QStringView unit);
+
     static constexpr QLatin1String ID_MESSAGE{"MESSAGE"};
     static constexpr QLatin1String ID_MESSAGE_ID{"MESSAGE_ID"};
     static constexpr QLatin1String ID_PRIORITY{"PRIORITY"};
@@ -145,4 +272,24 @@ public:
 
 QDebug operator<<(QDebug debug, const JournaldHelper::BootInfo &bootInfo);
 
+/**
+ * @brief Cache for JournaldHelper::normalizeUnit() results keyed by the raw unit value
+ *
+ * The number of distinct units in a journal is small compared to the number of entries, thus
+ * every distinct unit is normalized only once. The cache is not thread safe.
+ */
+class KJOURNALD_EXPORT UnitNameCache
+{
+public:
+    /**
+     * @brief normalize UTF-8 encoded unit name @p unit as stored in the journal
+     */
+    JournaldHelper::UnitName normalize(QByteArrayView unit);
+    JournaldHelper::UnitName normalize(const QString &unit);
+    void clear();
+
+private:
+    QHash<QByteArray, JournaldHelper::UnitName> mCache;
+};
+
 #endif // JOURNALDHELPER_H
@@ -7,30 +7,52 @@
 #include "colorizer.h"
 #include "journaldhelper.h"
 #include "journaldviewmodel_p.h"
+#include "journalwriter.h"
 #include "kjournaldlib_log_filtertrace.h"
 #include "kjournaldlib_log_general.h"
 #include "logentry.h"
+#include "logentryhandle.h"
+#include <KLocalizedString>
 #include <QColor>
 #include <QDebug>
 #include <QDir>
 #include <QMutex>
 #include <QRandomGenerator>
 #include <QRegularExpression>
+#include <QSaveFile>
 #include <QThread>
+#include <QtConcurrentRun>
 #include <algorithm>
+#include <charconv>
 #include <iterator>
+#include <limits>
 
 void JournaldViewModelPrivate::resetJournal()
 {
+    if (mJournalIndex) {
+        mIndexEntries = mJournalIndex->filter(mFilter);
+        qCDebug(KJOURNALDLIB_FILTERTRACE) << "Filter matches" << mIndexEntries.size() << "of" << mJournalIndex->size() << "indexed entries";
+        mTailCursorReached = false;
+        seekHeadAndMakeCurrent();
+        clearLog();
+        return;
+    }
     if (!mJournal || !mJournal->isValid()) {
         qCWarning(KJOURNALDLIB_GENERAL) << "Skipping reset, no valid journal open";
         return;
     }
 
-    int result{0};
+    applyFilter(mJournal->get(), mFilter);
+    mTailCursorReached = false;
+    seekHeadAndMakeCurrent();
+    // clear all data which are in limbo with new head
+    clearLog();
+}
 
+void JournaldViewModelPrivate::applyFilter(sd_journal *journal, const Filter &filter)
+{
     // reset all filters
-    sd_journal_flush_matches(mJournal->get());
+    sd_journal_flush_matches(journal);
 
     qCDebug(KJOURNALDLIB_FILTERTRACE) << "flush_matches()";
 
@@ -157,59 +179,84 @@ void JournaldViewModelPrivate::resetJournal()
     // kernel filter is special in the sense that thouse message only shall be added
     // and in the absense of different category filters, a filtering of the correct
     // transport layer must be applied
-    if (mFilter.areKernelMessagesEnabled()) {
+    if (filter.areKernelMessagesEnabled()) {
         clauseAdded = true;
-        addMatchesBootFilter(mJournal->get(), mFilter.bootFilter());
-        addMatchesPriorityFilter(mJournal->get(), mFilter.priorityFilter());
+        addMatchesBootFilter(journal, filter.bootFilter());
+        addMatchesPriorityFilter(journal, filter.priorityFilter());
         QStringList transportFilter = kernelTransports;
-        if (mFilter.systemdUserUnitFilter().empty() && mFilter.systemdSystemUnitFilter().empty() && mFilter.exeFilter().empty()) {
+        if (filter.systemdUserUnitFilter().empty() && filter.systemdSystemUnitFilter().empty() && filter.exeFilter().empty()) {
             transportFilter.append(nonKernelTransports);
         }
-        addMatchesTransportFilter(mJournal->get(), transportFilter);
-    } else if (mFilter.systemdUserUnitFilter().empty() && mFilter.systemdSystemUnitFilter().empty() && mFilter.exeFilter().empty()) {
+        addMatchesTransportFilter(journal, transportFilter);
+    } else if (filter.systemdUserUnitFilter().empty() && filter.systemdSystemUnitFilter().empty() && filter.exeFilter().empty()) {
         clauseAdded = true;
-        addMatchesBootFilter(mJournal->get(), mFilter.bootFilter());
-        addMatchesPriorityFilter(mJournal->get(), mFilter.priorityFilter());
-        addMatchesTransportFilter(mJournal->get(), nonKernelTransports);
+        addMatchesBootFilter(journal, filter.bootFilter());
+        addMatchesPriorityFilter(journal, filter.priorityFilter());
+        addMatchesTransportFilter(journal, nonKernelTransports);
     }
-    if (clauseAdded && !mFilter.systemdUserUnitFilter().empty()) {
-        addDisjunction(mJournal->get());
+    if (clauseAdded && !filter.systemdUserUnitFilter().empty()) {
+        addDisjunction(journal);
         clauseAdded = false;
     }
-    if (!mFilter.systemdUserUnitFilter().empty()) {
+    if (!filter.systemdUserUnitFilter().empty()) {
         clauseAdded = true;
-        addMatchesBootFilter(mJournal->get(), mFilter.bootFilter());
-        addMatchesPriorityFilter(mJournal->get(), mFilter.priorityFilter());
-        addMatchesUserUnitFilter(mJournal->get(), mFilter.systemdUserUnitFilter());
+        addMatchesBootFilter(journal, filter.bootFilter());
+        addMatchesPriorityFilter(journal, filter.priorityFilter());
+        addMatchesUserUnitFilter(journal, filter.systemdUserUnitFilter());
     }
-    if (clauseAdded && !mFilter.systemdSystemUnitFilter().empty()) {
-        addDisjunction(mJournal->get());
+    if (clauseAdded && !filter.systemdSystemUnitFilter().empty()) {
+        addDisjunction(journal);
         clauseAdded = false;
     }
-    if (!mFilter.systemdSystemUnitFilter().empty()) {
+    if (!filter.systemdSystemUnitFilter().empty()) {
         clauseAdded = true;
-        addMatchesBootFilter(mJournal->get(), mFilter.bootFilter());
-        addMatchesPriorityFilter(mJournal->get(), mFilter.priorityFilter());
-        addMatchesSystemUnitFilter(mJournal->get(), mFilter.systemdSystemUnitFilter());
+        addMatchesBootFilter(journal, filter.bootFilter());
+        addMatchesPriorityFilter(journal, filter.priorityFilter());
+        addMatchesSystemUnitFilter(journal, filter.systemdSystemUnitFilter());
     }
-    if (clauseAdded && !mFilter.exeFilter().empty()) {
-        addDisjunction(mJournal->get());
+    if (clauseAdded && !filter.exeFilter().empty()) {
+        addDisjunction(journal);
     }
-    if (!mFilter.exeFilter().empty()) {
-        addMatchesBootFilter(mJournal->get(), mFilter.bootFilter());
-        addMatchesPriorityFilter(mJournal->get(), mFilter.priorityFilter());
-        addMatchesExeFilter(mJournal->get(), mFilter.exeFilter());
+    if (!filter.exeFilter().empty()) {
+        addMatchesBootFilter(journal, filter.bootFilter());
+        addMatchesPriorityFilter(journal, filter.priorityFilter());
+        addMatchesExeFilter(journal, filter.exeFilter());
     }
 
     qCDebug(KJOURNALDLIB_FILTERTRACE).nospace() << "Filter DONE";
-    mTailCursorReached = false;
-    seekHeadAndMakeCurrent();
-    // clear all data which are in limbo with new head
+}
+
+void JournaldViewModelPrivate::clearLog()
+{
     mLog.clear();
+    mPrependedRows = 0;
+    ++mLogGeneration;
+}
+
+const LogEntry *JournaldViewModelPrivate::entryAt(quint64 generation, qsizetype position) const
+{
+    if (generation != mLogGeneration) {
+        return nullptr;
+    }
+    const qsizetype row = position + mPrependedRows;
+    if (row < 0 || row >= mLog.size()) {
+        return nullptr;
+    }
+    return &mLog.at(row);
+}
+
+void JournaldViewModelPrivate::updateContinuity(qsizetype first, qsizetype last)
+{
+    for (qsizetype row = std::max<qsizetype>(first, 0); row <= last && row < mLog.size(); ++row) {
+        mLog[row].updateContinuity(row > 0 ? &mLog.at(row - 1) : nullptr);
+    }
 }
 
 QList<LogEntry> JournaldViewModelPrivate::readEntries(Direction direction)
 {
+    if (mJournalIndex) {
+        return readIndexEntries(direction);
+    }
     if (!mJournal || !mJournal->isValid()) {
         qCWarning(KJOURNALDLIB_GENERAL) << "Skipping read entries, no valid journal open";
         return {};
@@ -225,7 +272,7 @@ QList<LogEntry> JournaldViewModelPrivate::readEntries(Direction direction)
     if (!mLog.isEmpty()) {
         QStringView cursor = (direction == Direction::TOWARDS_TAIL) ? mLog.last().cursor() : mLog.first().cursor();
 
-        switch (seekCursor(cursor)) {
+        switch (seekCursor(mJournal->get(), cursor)) {
         case SeekCursorResult::CURSOR_MADE_CURRENT:
             if ((direction == Direction::TOWARDS_TAIL && sd_journal_next(mJournal->get()) == 0)
                 || (direction == Direction::TOWARDS_HEAD && sd_journal_previous(mJournal->get()) == 0)) {
@@ -249,7 +296,19 @@ QList<LogEntry> JournaldViewModelPrivate::readEntries(Direction direction)
     }
 
     for (int i = 0; i < mChunkSize; ++i) {
-        LogEntry entry;
+        // fast extraction of VALUE from "KEY=VALUE"
+        const void *data;
+        size_t length;
+        LogEntry entry = createEntry([&](const char *name) -> QByteArrayView {
+            if (sd_journal_get_data(mJournal->get(), name, &data, &length) == 0) {
+                const char *ptr = static_cast<const char *>(data);
+                const char *eq = static_cast<const char *>(memchr(ptr, '=', length));
+                if (eq) {
+                    return QByteArrayView(eq + 1, ptr + length - (eq + 1));
+                }
+            }
+            return {};
+        });
 
         // read timestamps
         uint64_t time;
@@ -262,51 +321,6 @@ QList<LogEntry> JournaldViewModelPrivate::readEntries(Direction direction)
             entry.setMonotonicTimestamp(time);
         }
 
-        // helpers for fast extraction of VALUE from "KEY=VALUE"
-        auto extractValue = [](const void *data, size_t length) -> QString {
-            const char *ptr = static_cast<const char *>(data);
-            const char *eq = static_cast<const char *>(memchr(ptr, '=', length));
-            if (!eq) {
-                return QString();
-            }
-            return QString::fromUtf8(eq + 1, ptr + length - (eq + 1));
-        };
-        const void *data;
-        size_t length;
-        auto getField = [&](const char *name) -> QString {
-            if (sd_journal_get_data(mJournal->get(), name, &data, &length) == 0) {
-                return extractValue(data, length);
-            }
-            return {};
-        };
-
-        entry.setMessage(getField("MESSAGE"));
-        entry.setId(getField("MESSAGE_ID"));
-        entry.setBootId(getField("_BOOT_ID"));
-        entry.setExe(getField("_EXE"));
-
-        const QString priority = getField("PRIORITY");
-        if (!priority.isEmpty()) {
-            entry.setPriority(priority.toInt());
-        }
-
-        QString unit = getField("_SYSTEMD_USER_UNIT");
-        if (unit.isEmpty()) {
-            unit = getField("_SYSTEMD_UNIT");
-        }
-
-        if (!unit.isEmpty()) {
-            unit = JournaldHelper::cleanupString(unit);
-            entry.setUnit(unit);
-
-            qsizetype at = unit.indexOf(QLatin1Char('@'));
-            qsizetype dot = unit.lastIndexOf(QLatin1String(".service"));
-            if (at != -1 && dot > at) {
-                unit.replace(at, dot - at, QLatin1String("@"));
-            }
-            entry.setUnitTemplateGroup(unit);
-        }
-
         // cursor
         char *cursor = nullptr;
         if (sd_journal_get_cursor(mJournal->get(), &cursor) == 0) {
@@ -336,11 +350,219 @@ QList<LogEntry> JournaldViewModelPrivate::readEntries(Direction direction)
     return chunk;
 }
 
-JournaldViewModelPrivate::SeekCursorResult JournaldViewModelPrivate::seekCursor(QStringView cursor)
+LogEntry JournaldViewModelPrivate::createEntry(const RawFieldAccessor &rawField)
+{
+    LogEntry entry;
+    entry.setMessage(QString::fromUtf8(rawField("MESSAGE")));
+    entry.setId(QString::fromUtf8(rawField("MESSAGE_ID")));
+    entry.setBootId(QString::fromUtf8(rawField("_BOOT_ID")));
+
+    const QByteArrayView priority = rawField("PRIORITY");
+    if (!priority.isEmpty()) {
+        entry.setPriority(priority.toInt());
+    }
+
+    // units repeat a lot, thus normalize them from the raw value via cache
+    QByteArrayView unit = rawField("_SYSTEMD_USER_UNIT");
+    if (unit.isEmpty()) {
+        unit = rawField("_SYSTEMD_UNIT");
+    }
+    if (!unit.isEmpty()) {
+        auto unitIter = mUnitCache.constFind(QByteArray::fromRawData(unit.data(), unit.size()));
+        if (unitIter == mUnitCache.cend()) {
+            const JournaldHelper::UnitName unitName = JournaldHelper::normalizeUnit(QString::fromUtf8(unit));
+            const quint8 nameColorIndex = Colorizer::colorIndex(QStringView(unitName.mName));
+            const quint8 templateColorIndex = unitName.isTemplateInstance() ? Colorizer::colorIndex(QStringView(unitName.mTemplate)) : nameColorIndex;
+            unitIter = mUnitCache.insert(unit.toByteArray(), {unitName.mName, unitName.mTemplate, nameColorIndex, templateColorIndex});
+        }
+        entry.setUnit(unitIter->mName, unitIter->mNameColorIndex);
+        entry.setUnitTemplateGroup(unitIter->mTemplate, unitIter->mTemplateColorIndex);
+    }
+
+    // processes repeat as well, palette indices are computed once per distinct process
+    const QByteArrayView exe = rawField("_EXE");
+    if (!exe.isEmpty()) {
+        auto exeIter = mExeCache.constFind(QByteArray::fromRawData(exe.data(), exe.size()));
+        if (exeIter == mExeCache.cend()) {
+            exeIter = mExeCache.insert(exe.toByteArray(), {QString::fromUtf8(exe), Colorizer::colorIndex(exe)});
+        }
+        entry.setExe(exeIter->mExe, exeIter->mColorIndex);
+    }
+
+    if (!mReadSource) {
+        // every field lookup scans the entry data, skip it for journals of a single machine
+        return entry;
+    }
+    // entries of a merged journal come from few machines, thus sources are interned as well
+    QByteArrayView source = rawField("_HOSTNAME");
+    if (source.isEmpty()) {
+        source = rawField("_MACHINE_ID");
+    }
+    if (!source.isEmpty()) {
+        auto sourceIter = mSourceCache.constFind(QByteArray::fromRawData(source.data(), source.size()));
+        if (sourceIter == mSourceCache.cend()) {
+            sourceIter = mSourceCache.insert(source.toByteArray(), QString::fromUtf8(source));
+        }
+        entry.setSource(sourceIter.value());
+    }
+    return entry;
+}
+
+QList<LogEntry> JournaldViewModelPrivate::readIndexEntries(Direction direction)
+{
+    if (mLog.isEmpty()) {
+        if ((direction == Direction::TOWARDS_TAIL && !seekHeadAndMakeCurrent()) || (direction == Direction::TOWARDS_HEAD && !seekTailAndMakeCurrent())) {
+            return {};
+        }
+    }
+
+    // extend window of filtered index positions that is contained in the log
+    qsizetype first{0};
+    qsizetype last{0};
+    if (direction == Direction::TOWARDS_TAIL) {
+        first = mIndexWindowEnd;
+        last = std::min<qsizetype>(first + mChunkSize, mIndexEntries.size());
+        mIndexWindowEnd = last;
+        mTailCursorReached = last == mIndexEntries.size();
+    } else {
+        last = mIndexWindowBegin;
+        first = std::max<qsizetype>(last - mChunkSize, 0);
+        mIndexWindowBegin = first;
+        mHeadCursorReached = first == 0;
+    }
+
+    QList<LogEntry> chunk;
+    chunk.reserve(last - first);
+    for (qsizetype i = first; i < last; ++i) {
+        const qsizetype position = mIndexEntries.at(i);
+        const QList<JournaldExportReader::Field> fields = mJournalIndex->fields(position);
+        auto rawField = [&fields](const char *name) -> QByteArrayView {
+            const QByteArrayView fieldName(name);
+            for (const JournaldExportReader::Field &field : fields) {
+                if (field.name == fieldName) {
+                    return field.value;
+                }
+            }
+            return {};
+        };
+        LogEntry entry = createEntry(rawField);
+        entry.setDate(QDateTime::fromMSecsSinceEpoch(mJournalIndex->realtime(position) / 1000, QTimeZone::UTC));
+        entry.setMonotonicTimestamp(mJournalIndex->monotonic(position));
+        entry.setCursor(QString::fromUtf8(rawField("__CURSOR")));
+        chunk.append(std::move(entry));
+    }
+    return chunk;
+}
+
+bool JournaldViewModelPrivate::isReadable() const
+{
+    return (mJournalIndex && mJournalIndex->isValid()) || (mJournal && mJournal->isValid());
+}
+
+std::unique_ptr<SdJournal> JournaldViewModelPrivate::openExportJournal(const IJournalProvider *provider)
+{
+    // separate journal object, because the model journal is positioned at the model window
+    std::unique_ptr<SdJournal> journal = provider ? provider->openJournal() : nullptr;
+    if (!journal || !journal->isValid()) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Skipping export, no valid journal open";
+        return nullptr;
+    }
+    // export complete field data, not only the default threshold of 64 KiB
+    sd_journal_set_data_threshold(journal->get(), 0);
+    return journal;
+}
+
+qsizetype JournaldViewModelPrivate::writeJournalEntries(sd_journal *journal,
+                                                        const Filter &filter,
+                                                        JournalWriter &writer,
+                                                        QStringView cursor,
+                                                        qsizetype count,
+                                                        const ExportProgressCallback &progress)
+{
+    applyFilter(journal, filter);
+
+    if (cursor.isEmpty()) {
+        if (sd_journal_seek_head(journal) < 0 || sd_journal_next(journal) <= 0) {
+            return 0;
+        }
+    } else if (seekCursor(journal, cursor) != SeekCursorResult::CURSOR_MADE_CURRENT) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Could not seek first entry of export" << cursor;
+        return -1;
+    }
+
+    auto appendNumberField = [&writer](QByteArrayView name, uint64_t value) {
+        char digits[24];
+        const auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+        writer.addField(name, QByteArrayView(digits, result.ptr));
+    };
+
+    qsizetype written{0};
+    do {
+        writer.beginEntry();
+        char *entryCursor{nullptr};
+        if (sd_journal_get_cursor(journal, &entryCursor) == 0) {
+            writer.addField("__CURSOR", entryCursor);
+            free(entryCursor);
+        }
+        uint64_t time;
+        if (sd_journal_get_realtime_usec(journal, &time) == 0) {
+            appendNumberField("__REALTIME_TIMESTAMP", time);
+        }
+        sd_id128_t bootId;
+        if (sd_journal_get_monotonic_usec(journal, &time, &bootId) == 0) {
+            appendNumberField("__MONOTONIC_TIMESTAMP", time);
+        }
+        const void *data;
+        size_t length;
+        SD_JOURNAL_FOREACH_DATA(journal, data, length)
+        {
+            const QByteArrayView field(static_cast<const char *>(data), static_cast<qsizetype>(length));
+            const qsizetype separator = field.indexOf('=');
+            if (separator > 0) {
+                writer.addField(field.first(separator), field.sliced(separator + 1));
+            }
+        }
+        if (!writer.endEntry()) {
+            return -1;
+        }
+        if (!progress(++written)) {
+            qCDebug(KJOURNALDLIB_GENERAL) << "Export aborted after" << written << "entries";
+            return -1;
+        }
+    } while ((count < 0 || written < count) && sd_journal_next(journal) > 0);
+    return written;
+}
+
+qsizetype JournaldViewModelPrivate::writeIndexEntries(const JournalIndex &index,
+                                                      const QList<qsizetype> &entries,
+                                                      JournalWriter &writer,
+                                                      qsizetype first,
+                                                      qsizetype last,
+                                                      const ExportProgressCallback &progress)
+{
+    qsizetype written{0};
+    for (qsizetype i = first; i < last; ++i) {
+        writer.beginEntry();
+        const QList<JournaldExportReader::Field> fields = index.fields(entries.at(i));
+        for (const JournaldExportReader::Field &field : fields) {
+            writer.addField(field.name, field.value);
+        }
+        if (!writer.endEntry()) {
+            return -1;
+        }
+        if (!progress(++written)) {
+            qCDebug(KJOURNALDLIB_GENERAL) << "Export aborted after" << written << "entries";
+            return -1;
+        }
+    }
+    return written;
+}
+
+JournaldViewModelPrivate::SeekCursorResult JournaldViewModelPrivate::seekCursor(sd_journal *journal, QStringView cursor)
 {
     int result{0};
     // note: seek cursor does not make it current, but a subsequent sd_journal_next is required
-    result = sd_journal_seek_cursor(mJournal->get(), cursor.toUtf8().constData());
+    result = sd_journal_seek_cursor(journal, cursor.toUtf8().constData());
     if (result < 0) {
         qCWarning(KJOURNALDLIB_GENERAL) << "seeking cursor but could not be found" << strerror(-result);
         return SeekCursorResult::ERROR;
@@ -348,37 +570,82 @@ JournaldViewModelPrivate::SeekCursorResult JournaldViewModelPrivate::seekCursor(
 
     // make entry current
     // every result other than 1 is an error, because the cursor is expected to exist
-    result = sd_journal_next(mJournal->get());
+    result = sd_journal_next(journal);
     if (result != 1) {
         qCCritical(KJOURNALDLIB_GENERAL) << "seeked entry for cursor could not be made current";
         return JournaldViewModelPrivate::SeekCursorResult::ERROR;
     }
 
     // fallback search logic for problematic versions of systemd: https://github.com/systemd/systemd/issues/31516
-    // note the linear search is very expensive and should be the exception
-    result = sd_journal_test_cursor(mJournal->get(), cursor.toUtf8().constData());
+    result = sd_journal_test_cursor(journal, cursor.toUtf8().constData());
     if (result > 0) {
         return SeekCursorResult::CURSOR_MADE_CURRENT;
-    } else {
-        qCWarning(KJOURNALDLIB_GENERAL) << "current position does not match expected cursor, entering expensive linear search";
-        //(requested, actual):" << cursor << actualCursor;
-        sd_journal_seek_head(mJournal->get());
-        while (sd_journal_next(mJournal->get()) > 0) {
-            char *actualCursor{nullptr};
-            const int actualCursorResult = sd_journal_get_cursor(mJournal->get(), &actualCursor);
+    }
+    qCWarning(KJOURNALDLIB_GENERAL) << "current position does not match expected cursor, entering local search";
+    return recoverCursor(journal, cursor);
+}
+
+JournaldViewModelPrivate::SeekCursorResult JournaldViewModelPrivate::recoverCursor(sd_journal *journal, QStringView cursor)
+{
+    const std::optional<JournaldHelper::Cursor> expected = JournaldHelper::parseCursor(cursor);
+    if (!expected.has_value() || !(expected->mHasRealtime || expected->mHasMonotonic)) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "cursor does not contain any timestamp, cannot recover position" << cursor;
+        return SeekCursorResult::ERROR;
+    }
+
+    // position the journal right before the expected entry; monotonic time is preferred because it
+    // is not affected by wall clock jumps within a boot
+    int result{-1};
+    sd_id128_t bootId;
+    if (expected->mHasMonotonic && sd_id128_from_string(expected->mBootId.constData(), &bootId) >= 0) {
+        result = sd_journal_seek_monotonic_usec(journal, bootId, expected->mMonotonicUsec);
+    }
+    if (result < 0 && expected->mHasRealtime) {
+        result = sd_journal_seek_realtime_usec(journal, expected->mRealtimeUsec);
+    }
+    if (result < 0) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "could not seek timestamp of cursor:" << strerror(-result);
+        return SeekCursorResult::ERROR;
+    }
+    if (sd_journal_next(journal) <= 0 && sd_journal_previous(journal) <= 0) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "no entry found close to cursor timestamp";
+        return SeekCursorResult::ERROR;
+    }
+
+    // several entries may share the same timestamp, thus step back a bounded number of entries
+    // and check every entry within the window around the seeked position
+    result = sd_journal_previous_skip(journal, CURSOR_RECOVERY_WINDOW);
+    if (result < 0) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "could not move to begin of cursor search window:" << strerror(-result);
+        return SeekCursorResult::ERROR;
+    }
+    for (uint32_t i = 0; i < 2 * CURSOR_RECOVERY_WINDOW + 1; ++i) {
+        char *actualCursor{nullptr};
+        if (sd_journal_get_cursor(journal, &actualCursor) >= 0) {
+            const std::optional<JournaldHelper::Cursor> actual = JournaldHelper::parseCursor(QString::fromUtf8(actualCursor));
             free(actualCursor);
-            if (actualCursorResult >= 0) {
+            if (actual.has_value() && expected->isSameEntry(actual.value())) {
                 return SeekCursorResult::CURSOR_MADE_CURRENT;
             }
         }
-        qCCritical(KJOURNALDLIB_GENERAL) << "even with linear search, the cursor could not be found, giving up";
+        if (sd_journal_next(journal) <= 0) {
+            break;
+        }
     }
+    qCCritical(KJOURNALDLIB_GENERAL) << "even with local search, the cursor could not be found, giving up";
     return SeekCursorResult::ERROR;
 }
 
 bool JournaldViewModelPrivate::seekHeadAndMakeCurrent()
 {
     qCDebug(KJOURNALDLIB_GENERAL) << "seek head and make current";
+    if (mJournalIndex) {
+        mIndexWindowBegin = 0;
+        mIndexWindowEnd = 0;
+        mHeadCursorReached = true;
+        mTailCursorReached = mIndexEntries.isEmpty();
+        return !mIndexEntries.isEmpty();
+    }
     int result = sd_journal_seek_head(mJournal->get());
     if (result < 0) {
         qCCritical(KJOURNALDLIB_GENERAL) << "Failed to seek head:" << strerror(-result);
@@ -395,6 +662,13 @@ bool JournaldViewModelPrivate::seekHeadAndMakeCurrent()
 bool JournaldViewModelPrivate::seekTailAndMakeCurrent()
 {
     qCDebug(KJOURNALDLIB_GENERAL) << "seek tail and make current";
+    if (mJournalIndex) {
+        mIndexWindowBegin = mIndexEntries.size();
+        mIndexWindowEnd = mIndexEntries.size();
+        mHeadCursorReached = mIndexEntries.isEmpty();
+        mTailCursorReached = true;
+        return !mIndexEntries.isEmpty();
+    }
     int result = sd_journal_seek_tail(mJournal->get());
     if (result < 0) {
         qCCritical(KJOURNALDLIB_GENERAL) << "Failed to seek head:" << strerror(-result);
@@ -412,9 +686,17 @@ JournaldViewModel::JournaldViewModel(QObject *parent)
     : QAbstractItemModel(parent)
     , d(new JournaldViewModelPrivate)
 {
+    d->q = this;
 }
 
-JournaldViewModel::~JournaldViewModel() = default;
+JournaldViewModel::~JournaldViewModel()
+{
+    if (d->mExportWatcher) {
+        // the worker only holds its own journal and index references and discards the partially written file
+        d->mExportWatcher->disconnect();
+        d->mExportWatcher->cancel();
+    }
+}
 
 void JournaldViewModel::guardedBeginResetModel()
 {
@@ -433,20 +715,26 @@ void JournaldViewModel::guardedEndResetModel()
 void JournaldViewModel::setJournalProvider(IJournalProvider *provider)
 {
     d->mJournalProvider = provider;
+    d->mReadSource = provider && provider->hasMultipleSources();
     Q_EMIT journalProviderChanged();
 
     guardedBeginResetModel();
-    d->mLog.clear();
-    if (provider) {
+    d->clearLog();
+    d->mJournalIndex = provider ? provider->journalIndex() : nullptr;
+    if (provider && !d->mJournalIndex) {
         d->mJournal = provider->openJournal();
+    } else {
+        d->mJournal.reset();
     }
-    d->mJournalAvailable = provider && d->mJournal && d->mJournal->isValid();
+    d->mJournalAvailable = provider && d->isReadable();
     if (d->mJournalAvailable) {
         d->resetJournal();
     }
     guardedEndResetModel();
     if (d->mJournalAvailable) {
         fetchMoreLogEntries();
+    }
+    if (d->mJournal && d->mJournalAvailable) {
         connect(d->mJournal.get(), &SdJournal::journalUpdated, this, [=]() {
             if (d->mTailCursorReached) {
                 d->mTailCursorReached = false;
@@ -487,6 +775,7 @@ QHash<int, QByteArray> JournaldViewModel::roleNames() const
     roles[JournaldViewModel::EXE_COLOR_BACKGROUND] = "execolor_background";
     roles[JournaldViewModel::EXE_COLOR_FOREGROUND] = "execolor_foreground";
     roles[JournaldViewModel::CURSOR] = "cursor";
+    roles[JournaldViewModel::SOURCE] = "source";
     return roles;
 }
 
@@ -521,79 +810,99 @@ int JournaldViewModel::columnCount(const QModelIndex &parent) const
     return 1;
 }
 
-QVariant JournaldViewModel::data(const QModelIndex &index, int role) const
+QVariant JournaldViewModelPrivate::invalidRoleData(int role)
 {
-    if (index.row() < 0 || d->mLog.count() <= index.row()) {
-        switch (role) {
-        case JournaldViewModel::Roles::SYSTEMD_UNIT_COLOR_BACKGROUND:
-        case JournaldViewModel::Roles::SYSTEMD_UNIT_COLOR_FOREGROUND:
-        case JournaldViewModel::Roles::EXE_COLOR_BACKGROUND:
-        case JournaldViewModel::Roles::EXE_COLOR_FOREGROUND:
-            return QColor();
-        default:
-            return QVariant();
-        }
+    switch (role) {
+    case JournaldViewModel::Roles::SYSTEMD_UNIT_COLOR_BACKGROUND:
+    case JournaldViewModel::Roles::SYSTEMD_UNIT_COLOR_FOREGROUND:
+    case JournaldViewModel::Roles::EXE_COLOR_BACKGROUND:
+    case JournaldViewModel::Roles::EXE_COLOR_FOREGROUND:
+        return QColor();
+    default:
+        return QVariant();
     }
+}
+
+QVariant JournaldViewModelPrivate::roleData(const LogEntry &entry, qsizetype row, int role) const
+{
     switch (role) {
     case JournaldViewModel::Roles::ENTRY:
-        return QVariant::fromValue(d->mLog.at(index.row()));
+        return QVariant::fromValue(LogEntryHandle(q, mLogGeneration, row - mPrependedRows));
     case JournaldViewModel::Roles::MESSAGE:
-        return QString(d->mLog.at(index.row()).message());
+        return QString(entry.message());
     case JournaldViewModel::Roles::MESSAGE_ID:
-        return QString(d->mLog.at(index.row()).id());
+        return QString(entry.id());
     case JournaldViewModel::Roles::DATE:
-        return d->mLog.at(index.row()).date().date();
+        return entry.date().date();
     case JournaldViewModel::Roles::DATETIME:
-        return d->mLog.at(index.row()).date();
+        return entry.date();
     case JournaldViewModel::Roles::MONOTONIC_TIMESTAMP:
-        return d->mLog.at(index.row()).monotonicTimestamp();
+        return entry.monotonicTimestamp();
     case JournaldViewModel::Roles::BOOT_ID:
-        return d->mLog.at(index.row()).bootId();
+        return entry.bootId();
     case JournaldViewModel::Roles::SYSTEMD_UNIT:
-        return d->mLog.at(index.row()).unit();
-    case JournaldViewModel::Roles::SYSTEMD_UNIT_CHANGED_SUBSTRING: {
-        QString unit = d->mLog.at(index.row()).unit();
-        if (index.row() != 0) {
-            unit.remove(d->mLog.at(index.row() - 1).unit());
-        }
-        return unit;
-    }
+        return entry.unit();
+    case JournaldViewModel::Roles::SYSTEMD_UNIT_CHANGED_SUBSTRING:
+        return entry.unitChangedSubstring();
     case JournaldViewModel::Roles::PRIORITY:
-        return d->mLog.at(index.row()).priority();
+        return entry.priority();
     case JournaldViewModel::Roles::EXE:
-        return d->mLog.at(index.row()).exe();
-    case JournaldViewModel::Roles::EXE_CHANGED_SUBSTRING: {
-        QString exe = d->mLog.at(index.row()).exe();
-        if (index.row() != 0) {
-            exe.remove(d->mLog.at(index.row() - 1).exe());
-        }
-        return exe;
-    }
+        return entry.exe();
+    case JournaldViewModel::Roles::EXE_CHANGED_SUBSTRING:
+        return entry.exeChangedSubstring();
     case JournaldViewModel::Roles::SYSTEMD_UNIT_COLOR_BACKGROUND:
-        if (d->mEnableServiceTemplateGrouping) {
-            return Colorizer::color(d->mLog.at(index.row()).unitTemplateGroup(), Colorizer::COLOR_TYPE::BACKGROUND);
+        if (mEnableServiceTemplateGrouping) {
+            return Colorizer::color(entry.unitTemplateGroupColorIndex(), Colorizer::COLOR_TYPE::BACKGROUND);
         } else {
-            return Colorizer::color(d->mLog.at(index.row()).unit(), Colorizer::COLOR_TYPE::BACKGROUND);
+            return Colorizer::color(entry.unitColorIndex(), Colorizer::COLOR_TYPE::BACKGROUND);
         }
     case JournaldViewModel::Roles::SYSTEMD_UNIT_COLOR_FOREGROUND:
-        if (d->mEnableServiceTemplateGrouping) {
-            return Colorizer::color(d->mLog.at(index.row()).unitTemplateGroup(), Colorizer::COLOR_TYPE::FOREGROUND);
+        if (mEnableServiceTemplateGrouping) {
+            return Colorizer::color(entry.unitTemplateGroupColorIndex(), Colorizer::COLOR_TYPE::FOREGROUND);
         } else {
-            return Colorizer::color(d->mLog.at(index.row()).unit(), Colorizer::COLOR_TYPE::FOREGROUND);
+            return Colorizer::color(entry.unitColorIndex(), Colorizer::COLOR_TYPE::FOREGROUND);
         }
     case JournaldViewModel::Roles::EXE_COLOR_BACKGROUND:
-        return Colorizer::color(d->mLog.at(index.row()).exe(), Colorizer::COLOR_TYPE::BACKGROUND);
+        return Colorizer::color(entry.exeColorIndex(), Colorizer::COLOR_TYPE::BACKGROUND);
     case JournaldViewModel::Roles::EXE_COLOR_FOREGROUND:
-        return Colorizer::color(d->mLog.at(index.row()).exe(), Colorizer::COLOR_TYPE::FOREGROUND);
+        return Colorizer::color(entry.exeColorIndex(), Colorizer::COLOR_TYPE::FOREGROUND);
     case JournaldViewModel::Roles::CURSOR:
-        return d->mLog.at(index.row()).cursor();
+        return entry.cursor();
+    case JournaldViewModel::Roles::SOURCE:
+        return entry.source();
     }
     return QVariant();
 }
 
+QVariant JournaldViewModel::data(const QModelIndex &index, int role) const
+{
+    if (index.row() < 0 || d->mLog.count() <= index.row()) {
+        return JournaldViewModelPrivate::invalidRoleData(role);
+    }
+    return d->roleData(d->mLog.at(index.row()), index.row(), role);
+}
+
+void JournaldViewModel::multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const
+{
+    // bounds check and row lookup once for all roles of a delegate
+    if (index.row() < 0 || d->mLog.count() <= index.row()) {
+        for (QModelRoleData &roleData : roleDataSpan) {
+            roleData.setData(JournaldViewModelPrivate::invalidRoleData(roleData.role()));
+        }
+        return;
+    }
+    const LogEntry &entry = d->mLog.at(index.row());
+    for (QModelRoleData &roleData : roleDataSpan) {
+        roleData.setData(d->roleData(entry, index.row(), roleData.role()));
+    }
+}
+
 QDateTime JournaldViewModel::datetime(int indexRow) const
 {
-    return data(index(indexRow, 0), JournaldViewModel::Roles::DATE).toDateTime();
+    if (indexRow < 0 || indexRow >= d->mLog.size()) {
+        return QDateTime();
+    }
+    return d->mLog.at(indexRow).date();
 }
 
 bool JournaldViewModel::canFetchMore(const QModelIndex &parent) const
@@ -632,8 +941,10 @@ std::pair<int, int> JournaldViewModel::fetchMoreLogEntries()
     { // append to log
         QVector<LogEntry> chunk = d->readEntries(JournaldViewModelPrivate::Direction::TOWARDS_TAIL);
         if (chunk.size() > 0) {
-            beginInsertRows(QModelIndex(), d->mLog.size(), d->mLog.size() + chunk.size() - 1);
+            const qsizetype firstRow = d->mLog.size();
+            beginInsertRows(QModelIndex(), firstRow, firstRow + chunk.size() - 1);
             d->mLog.append(chunk);
+            d->updateContinuity(firstRow, d->mLog.size() - 1);
             endInsertRows();
             qCDebug(KJOURNALDLIB_GENERAL) << "read towards tail" << chunk.size();
             fetchResult.first = chunk.size();
@@ -644,8 +955,17 @@ std::pair<int, int> JournaldViewModel::fetchMoreLogEntries()
         QVector<LogEntry> chunk = d->readEntries(JournaldViewModelPrivate::Direction::TOWARDS_HEAD);
         if (chunk.size() > 0) {
             beginInsertRows(QModelIndex(), 0, chunk.size() - 1);
+            const bool hadRows = !d->mLog.isEmpty();
             d->mLog = chunk << d->mLog; // TODO find more performant way than constructing a new vector every time
+            d->mPrependedRows += chunk.size();
+            // former first row now has a predecessor
+            d->updateContinuity(0, chunk.size());
             endInsertRows();
+            if (hadRows) {
+                Q_EMIT dataChanged(index(chunk.size(), 0),
+                                   index(chunk.size(), 0),
+                                   {Roles::SYSTEMD_UNIT_CHANGED_SUBSTRING, Roles::EXE_CHANGED_SUBSTRING});
+            }
             qCDebug(KJOURNALDLIB_GENERAL) << "read towards head" << chunk.size();
             fetchResult.second = chunk.size();
         }
@@ -654,6 +974,177 @@ std::pair<int, int> JournaldViewModel::fetchMoreLogEntries()
     return fetchResult;
 }
 
+qsizetype JournaldViewModel::exportRows(QIODevice *device, int first, int last, JournaldViewModel::ExportFormat format)
+{
+    if (last < 0 || last >= d->mLog.size()) {
+        last = rowCount() - 1;
+    }
+    first = std::max(first, 0);
+    if (first > last) {
+        return 0;
+    }
+
+    const qsizetype total = last - first + 1;
+    if (format == JournaldViewModel::PLAIN_TEXT) {
+        // plain text only contains data of the loaded rows, no need to read the journal again
+        const QByteArray text = exportRowsToText(first, last).toUtf8();
+        if (device->write(text) != text.size()) {
+            qCWarning(KJOURNALDLIB_GENERAL) << "Could not write journal entries:" << device->errorString();
+            return -1;
+        }
+        Q_EMIT exportProgress(total, total);
+        return total;
+    }
+    auto progress = [this, total](qsizetype written) {
+        if (written % JournaldViewModelPrivate::EXPORT_PROGRESS_INTERVAL == 0) {
+            Q_EMIT exportProgress(written, total);
+        }
+        return true;
+    };
+    JournalWriter writer(device, format);
+    qsizetype written{-1};
+    if (d->mJournalIndex) {
+        written = d->writeIndexEntries(*d->mJournalIndex, d->mIndexEntries, writer, d->mIndexWindowBegin + first, d->mIndexWindowBegin + last + 1, progress);
+    } else if (std::unique_ptr<SdJournal> journal = d->openExportJournal(d->mJournalProvider)) {
+        written = d->writeJournalEntries(journal->get(), d->mFilter, writer, d->mLog.at(first).cursor(), total, progress);
+    }
+    if (written < 0 || !writer.flush()) {
+        return -1;
+    }
+    Q_EMIT exportProgress(written, total);
+    return written;
+}
+
+qsizetype JournaldViewModel::exportJournal(QIODevice *device, JournaldViewModel::ExportFormat format)
+{
+    const qsizetype total = d->mJournalIndex ? d->mIndexEntries.size() : -1;
+    auto progress = [this, total](qsizetype written) {
+        if (written % JournaldViewModelPrivate::EXPORT_PROGRESS_INTERVAL == 0) {
+            Q_EMIT exportProgress(written, total);
+        }
+        return true;
+    };
+    JournalWriter writer(device, format);
+    qsizetype written{-1};
+    if (d->mJournalIndex) {
+        written = d->writeIndexEntries(*d->mJournalIndex, d->mIndexEntries, writer, 0, d->mIndexEntries.size(), progress);
+    } else if (std::unique_ptr<SdJournal> journal = d->openExportJournal(d->mJournalProvider)) {
+        written = d->writeJournalEntries(journal->get(), d->mFilter, writer, QStringView(), -1, progress);
+    }
+    if (written < 0 || !writer.flush()) {
+        return -1;
+    }
+    Q_EMIT exportProgress(written, written);
+    return written;
+}
+
+qsizetype JournaldViewModel::exportJournal(const IJournalProvider *provider, const Filter &filter, QIODevice *device, JournaldViewModel::ExportFormat format)
+{
+    auto progress = [](qsizetype) {
+        return true;
+    };
+    JournalWriter writer(device, format);
+    qsizetype written{-1};
+    if (const std::shared_ptr<const JournalIndex> index = provider ? provider->journalIndex() : nullptr) {
+        const QList<qsizetype> entries = index->filter(filter);
+        written = JournaldViewModelPrivate::writeIndexEntries(*index, entries, writer, 0, entries.size(), progress);
+    } else if (std::unique_ptr<SdJournal> journal = JournaldViewModelPrivate::openExportJournal(provider)) {
+        written = JournaldViewModelPrivate::writeJournalEntries(journal->get(), filter, writer, QStringView(), -1, progress);
+    }
+    if (written < 0 || !writer.flush()) {
+        return -1;
+    }
+    return written;
+}
+
+QString JournaldViewModel::exportRowsToText(int first, int last)
+{
+    qsizetype begin = std::min(first, last);
+    qsizetype end = std::max(first, last);
+    if (end < 0 || end >= d->mLog.size()) {
+        end = d->mLog.size() - 1;
+    }
+    begin = std::max<qsizetype>(begin, 0);
+
+    // loaded rows already contain normalized unit names, hence no separate journal is needed
+    QString text;
+    for (qsizetype row = begin; row <= end; ++row) {
+        const LogEntry &entry = d->mLog.at(row);
+        text += entry.date().toUTC().toString(QStringLiteral("HH:mm:ss.zzz")) + QLatin1String(" UTC ") + entry.unit() + QLatin1Char(' ') + entry.message()
+            + QLatin1Char('\n');
+    }
+    return text;
+}
+
+bool JournaldViewModel::exportJournalToFile(const QUrl &file, JournaldViewModel::ExportFormat format)
+{
+    if (d->mExportWatcher) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Skipping export, another export is still running";
+        return false;
+    }
+    // the worker only uses objects that are not touched by the model: a separate journal or the immutable index
+    std::shared_ptr<SdJournal> journal;
+    if (!d->mJournalIndex) {
+        journal = d->openExportJournal(d->mJournalProvider);
+        if (!journal) {
+            return false;
+        }
+    }
+    const qsizetype total = d->mJournalIndex ? d->mIndexEntries.size() : -1;
+
+    d->mExportWatcher = std::make_unique<QFutureWatcher<JournaldViewModelPrivate::ExportResult>>();
+    connect(d->mExportWatcher.get(), &QFutureWatcherBase::progressValueChanged, this, [this, total](int written) {
+        Q_EMIT exportProgress(written, total);
+    });
+    connect(d->mExportWatcher.get(), &QFutureWatcherBase::finished, this, [this, total]() {
+        const JournaldViewModelPrivate::ExportResult result =
+            d->mExportWatcher->future().resultCount() > 0 ? d->mExportWatcher->result() : JournaldViewModelPrivate::ExportResult{};
+        d->mExportWatcher.release()->deleteLater();
+        if (result.mWritten >= 0) {
+            Q_EMIT exportProgress(result.mWritten, total < 0 ? result.mWritten : total);
+        } else {
+            qCWarning(KJOURNALDLIB_GENERAL) << "Export failed:" << result.mErrorString;
+        }
+        Q_EMIT exportFinished(result.mWritten >= 0, result.mErrorString);
+    });
+    d->mExportWatcher->setFuture(QtConcurrent::run(
+        [journal, index = d->mJournalIndex, entries = d->mIndexEntries, filter = d->mFilter, fileName = file.toLocalFile(), format](
+            QPromise<JournaldViewModelPrivate::ExportResult> &promise) {
+            JournaldViewModelPrivate::ExportResult result;
+            QSaveFile saveFile(fileName);
+            if (!saveFile.open(QIODevice::WriteOnly)) {
+                result.mErrorString = saveFile.errorString();
+                promise.addResult(result);
+                return;
+            }
+            auto progress = [&promise](qsizetype written) {
+                if (written % JournaldViewModelPrivate::EXPORT_PROGRESS_INTERVAL == 0) {
+                    promise.setProgressValue(static_cast<int>(std::min<qsizetype>(written, std::numeric_limits<int>::max())));
+                }
+                return !promise.isCanceled();
+            };
+            bool writeError{false};
+            {
+                JournalWriter writer(&saveFile, format);
+                if (index) {
+                    result.mWritten = JournaldViewModelPrivate::writeIndexEntries(*index, entries, writer, 0, entries.size(), progress);
+                } else {
+                    result.mWritten = JournaldViewModelPrivate::writeJournalEntries(journal->get(), filter, writer, QStringView(), -1, progress);
+                }
+                writeError = !writer.flush();
+            }
+            if (result.mWritten < 0 && !writeError) {
+                saveFile.cancelWriting();
+                result.mErrorString = promise.isCanceled() ? QString() : i18nc("@info error message", "Could not read the journal entries");
+            } else if (writeError || !saveFile.commit()) {
+                result.mErrorString = saveFile.errorString();
+                result.mWritten = -1;
+            }
+            promise.addResult(result);
+        }));
+    return true;
+}
+
 void JournaldViewModel::setFetchMoreChunkSize(quint32 size)
 {
     if (size > 0) {
@@ -666,11 +1157,12 @@ void JournaldViewModel::setFetchMoreChunkSize(quint32 size)
 void JournaldViewModel::seekHead()
 {
     guardedBeginResetModel();
-    d->mLog.clear();
-    if (d->mJournal && d->mJournal->isValid()) {
+    d->clearLog();
+    if (d->isReadable()) {
         d->seekHeadAndMakeCurrent();
         QVector<LogEntry> chunk = d->readEntries(JournaldViewModelPrivate::Direction::TOWARDS_TAIL);
         d->mLog = chunk;
+        d->updateContinuity(0, d->mLog.size() - 1);
     } else {
         qCCritical(KJOURNALDLIB_GENERAL) << "Cannot seek head of invalid journal";
     }
@@ -680,11 +1172,12 @@ void JournaldViewModel::seekHead()
 void JournaldViewModel::seekTail()
 {
     guardedBeginResetModel();
-    d->mLog.clear();
-    if (d->mJournal && d->mJournal->isValid()) {
+    d->clearLog();
+    if (d->isReadable()) {
         d->seekTailAndMakeCurrent();
         QVector<LogEntry> chunk = d->readEntries(JournaldViewModelPrivate::Direction::TOWARDS_HEAD);
         d->mLog = chunk;
+        d->updateContinuity(0, d->mLog.size() - 1);
     } else {
         qCCritical(KJOURNALDLIB_GENERAL) << "Cannot seek head of invalid journal";
     }
@@ -10,10 +10,12 @@
 #include "kjournald_export.h"
 #include <QAbstractItemModel>
 #include <QQmlEngine>
+#include <QUrl>
 #include <ijournalprovider.h>
 #include <memory>
 
 class JournaldViewModelPrivate;
+class QIODevice;
 
 /**
  * @brief Item model class that provides convienence access to journald database
@@ -45,7 +47,7 @@ public:
     enum Roles {
         MESSAGE = Qt::DisplayRole, //!< journal entry's message text
         MESSAGE_ID = Qt::UserRole + 1, //!< ID of log entry in journald DB (might not exist for non systemd services)
-        ENTRY, //!< gadget with basic log information
+        ENTRY, //!< lightweight LogEntryHandle gadget with basic log information
         DATE, //!< date of journal entry
         DATETIME, //!< date and time of journal entry
         MONOTONIC_TIMESTAMP, //!< monotonic timestamp in miliseconds for journal entry
@@ -60,6 +62,7 @@ public:
         EXE, //!< executable path, when available; field "_EXE"
         EXE_CHANGED_SUBSTRING, //!< changed part of EXE string when compared to previous line
         CURSOR, //!< journald internal unique identifier for a log entry
+        SOURCE, //!< machine of the entry, i.e. hostname or machine ID; only set for merged journals, see IJournalProvider::hasMultipleSources()
     };
     Q_ENUM(Roles);
 
@@ -69,6 +72,13 @@ public:
     };
     Q_ENUM(Direction);
 
+    enum ExportFormat {
+        PLAIN_TEXT, //!< one line per entry with UTC time, unit and message
+        JOURNAL_EXPORT, //!< journald export format, see "journalctl -o export"
+        JSON_LINES, //!< one JSON object per line, see "journalctl -o json"
+    };
+    Q_ENUM(ExportFormat);
+
     /**
      * @brief Construct model from the default local journald database
      *
@@ -130,9 +140,16 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
 
     /**
-     * @brief Convenience method that returns date for a given model row
+     * @copydoc QAbstractItemModel::multiData()
+     *
+     * Fill all roles of @p roleDataSpan from a single row lookup.
+     */
+    void multiData(const QModelIndex &index, QModelRoleDataSpan roleDataSpan) const override;
+
+    /**
+     * @brief Convenience method that returns date and time for a given model row
      * @param indexRow the index row
-     * @return the QDateItem object for the entry found
+     * @return the date and time of the entry found or invalid QDateTime if row is out of range
      */
     Q_INVOKABLE QDateTime datetime(int indexRow) const;
 
@@ -192,6 +209,57 @@ public:
      */
     Q_INVOKABLE int closestIndexForData(const QDateTime &datetime);
 
+    /**
+     * @brief Write the entries of rows @p first to @p last (inclusive) to @p device
+     *
+     * Plain text is composed from the loaded rows like exportRowsToText(). For all other formats, all
+     * fields of the entries are read from a separate journal object, such that the model state is not
+     * changed. Entries are written with buffered writes and exportProgress() is emitted regularly.
+     *
+     * @param last last row to write, negative values select the last row of the model
+     * @return number of written entries or -1 if an error occurred
+     */
+    qsizetype exportRows(QIODevice *device, int first, int last, JournaldViewModel::ExportFormat format);
+
+    /**
+     * @brief Write all entries that match the current filter to @p device
+     *
+     * In contrast to exportRows(), this is independent of the rows that are currently loaded.
+     *
+     * @return number of written entries or -1 if an error occurred
+     */
+    qsizetype exportJournal(QIODevice *device, JournaldViewModel::ExportFormat format);
+
+    /**
+     * @brief Write all entries of @p provider that match @p filter to @p device
+     *
+     * Entries are streamed from a separate journal or the index of the provider, no model is created
+     * and no entries are kept in memory. This is intended for tools that only export journals.
+     *
+     * @return number of written entries or -1 if an error occurred
+     */
+    static qsizetype exportJournal(const IJournalProvider *provider, const Filter &filter, QIODevice *device, JournaldViewModel::ExportFormat format);
+
+    /**
+     * @brief Convenience method that returns the plain text of rows @p first to @p last (inclusive)
+     *
+     * The text is composed from the loaded rows with their normalized unit names, as shown by the view.
+     * @see exportRows()
+     */
+    Q_INVOKABLE QString exportRowsToText(int first, int last);
+
+    /**
+     * @brief Write all entries that match the current filter to local file @p file in a worker thread
+     *
+     * The entries are read from a separate journal object or the immutable index of the provider, such
+     * that the model can be used while the file is written. Progress is reported by exportProgress()
+     * and the result by exportFinished(). The file is only replaced if the export succeeded.
+     *
+     * @see exportJournal()
+     * @return true if the export was started, false if another export is running or the journal cannot be read
+     */
+    Q_INVOKABLE bool exportJournalToFile(const QUrl &file, JournaldViewModel::ExportFormat format);
+
     /**
      * @brief Set how many log entries shall be read on each request of read-mode.
      * @param size
@@ -224,12 +292,27 @@ Q_SIGNALS:
     void journalProviderChanged();
     void availableChanged();
     void groupTemplatedSystemdUnitsChanged();
+    /**
+     * Signal is emitted regularly while entries are exported and once when the export finished
+     * @param written number of entries written so far
+     * @param total number of entries to be written or -1 if not known before the export finished,
+     *        which is the case for exportJournal() and exportJournalToFile() of sd-journal based
+     *        providers because counting the filtered entries requires an additional pass over the journal
+     */
+    void exportProgress(qsizetype written, qsizetype total);
+    /**
+     * Signal is emitted when an export that was started by exportJournalToFile() finished
+     * @param success true if the file was written completely
+     * @param errorString human readable reason if the export failed
+     */
+    void exportFinished(bool success, const QString &errorString);
 
 protected:
     void guardedBeginResetModel();
     void guardedEndResetModel();
 
 private:
+    friend class LogEntryHandle;
     std::unique_ptr<JournaldViewModelPrivate> d;
 };
 
@@ -7,17 +7,23 @@
 #define JOURNALDVIEWMODEL_P_H
 
 #include "filter.h"
+#include "journaldhelper.h"
+#include "journalindex.h"
 #include "logentry.h"
 #include "sdjournal.h"
 #include <QAtomicInt>
 #include <QColor>
 #include <QDateTime>
+#include <QFutureWatcher>
 #include <QHash>
 #include <QString>
 #include <QVector>
+#include <functional>
 #include <ijournalprovider.h>
 #include <memory>
 
+class JournalWriter;
+
 class JournaldViewModelPrivate
 {
 public:
@@ -37,6 +43,11 @@ public:
      */
     void resetJournal();
 
+    /**
+     * @brief replace all matches of @p journal with the boolean expression of @p filter
+     */
+    static void applyFilter(sd_journal *journal, const Filter &filter);
+
     /**
      * Seek head of journal and already position at first entry with
      * sd_journal_next().
@@ -72,17 +83,159 @@ public:
     QList<LogEntry> readEntries(Direction direction);
 
     /**
-     * @brief seekCursor in journal an handle issues
+     * @brief variant of readEntries() for journals that are provided by a JournalIndex
+     */
+    QList<LogEntry> readIndexEntries(Direction direction);
+
+    /**
+     * @brief accessor for the raw value of a field of the current entry, null view if not set
+     */
+    using RawFieldAccessor = std::function<QByteArrayView(const char *name)>;
+
+    /**
+     * @brief create entry with message, ids, priority, unit and process from @p rawField
+     *
+     * Units and processes are normalized via the caches. Timestamps and cursor must be set by the caller.
+     */
+    LogEntry createEntry(const RawFieldAccessor &rawField);
+
+    /**
+     * @return true if either a valid journal or a journal index is available for reading
+     */
+    bool isReadable() const;
+
+    /**
+     * @brief compute continuity of entries in rows @p first to @p last (inclusive) with their predecessors
+     *
+     * Must be called for inserted rows and for the first row that follows inserted rows.
+     */
+    void updateContinuity(qsizetype first, qsizetype last);
+
+    /**
+     * @return value of @p role for @p entry, which is stored at @p row
+     */
+    QVariant roleData(const LogEntry &entry, qsizetype row, int role) const;
+
+    /**
+     * @return value of @p role for an index outside of the model
+     */
+    static QVariant invalidRoleData(int role);
+
+    /**
+     * @brief remove all entries, handles of removed entries become invalid
+     */
+    void clearLog();
+
+    /**
+     * @return entry referenced by handle position @p position of generation @p generation or nullptr if it does not exist anymore
+     */
+    const LogEntry *entryAt(quint64 generation, qsizetype position) const;
+
+    /**
+     * @brief seekCursor in @p journal an handle issues
      * @return
      */
-    SeekCursorResult seekCursor(QStringView cursor);
+    static SeekCursorResult seekCursor(sd_journal *journal, QStringView cursor);
+
+    /**
+     * @brief recover journal position for @p cursor when sd_journal_test_cursor fails
+     *
+     * Parses timestamps from the cursor, seeks close to the expected position and then compares
+     * the entries within a bounded window around it. This avoids a linear scan over the whole journal.
+     */
+    static SeekCursorResult recoverCursor(sd_journal *journal, QStringView cursor);
+
+    /**
+     * @brief callback with the number of entries that were written so far
+     * @return false if the export shall be aborted
+     */
+    using ExportProgressCallback = std::function<bool(qsizetype written)>;
+
+    /**
+     * @brief result of an export that was written by a worker thread
+     */
+    struct ExportResult {
+        qsizetype mWritten{-1}; //!< number of written entries or -1 on error
+        QString mErrorString;
+    };
+
+    /**
+     * @brief open a separate journal of @p provider for exports, such that the model journal stays at its position
+     * @return journal that exports complete field data or nullptr if no valid journal could be opened
+     */
+    static std::unique_ptr<SdJournal> openExportJournal(const IJournalProvider *provider);
+
+    /**
+     * @brief write up to @p count entries of @p journal that match @p filter to @p writer
+     *
+     * This does not depend on the model state and can be called from worker threads, as long as
+     * @p journal is not used concurrently.
+     *
+     * @param cursor first entry to write, the head of the journal if empty
+     * @param count number of entries to write, all remaining entries if negative
+     * @return number of written entries or -1 on error
+     */
+    static qsizetype
+    writeJournalEntries(sd_journal *journal, const Filter &filter, JournalWriter &writer, QStringView cursor, qsizetype count, const ExportProgressCallback &progress);
+
+    /**
+     * @brief write entries of the filtered index positions @p entries from @p first to before @p last to @p writer
+     *
+     * The index is immutable, hence this can be called from worker threads.
+     *
+     * @return number of written entries or -1 on error
+     */
+    static qsizetype writeIndexEntries(const JournalIndex &index,
+                                       const QList<qsizetype> &entries,
+                                       JournalWriter &writer,
+                                       qsizetype first,
+                                       qsizetype last,
+                                       const ExportProgressCallback &progress);
+
+    /**
+     * number of written entries after which export progress is reported
+     */
+    static constexpr qsizetype EXPORT_PROGRESS_INTERVAL{10'000};
+
+    /**
+     * number of entries that are checked in each direction around the seeked timestamp
+     */
+    static constexpr uint32_t CURSOR_RECOVERY_WINDOW{256};
 
     IJournalProvider *mJournalProvider{nullptr};
     std::unique_ptr<SdJournal> mJournal;
+    std::shared_ptr<const JournalIndex> mJournalIndex; //!< used instead of mJournal if the provider has an index
+    QList<qsizetype> mIndexEntries; //!< index positions that match mFilter
+    qsizetype mIndexWindowBegin{0}; //!< first position in mIndexEntries that is contained in mLog
+    qsizetype mIndexWindowEnd{0}; //!< position after last one in mIndexEntries that is contained in mLog
+    /**
+     * @brief Normalized unit and template names together with their Colorizer palette indices
+     */
+    struct InternedUnit {
+        QString mName;
+        QString mTemplate;
+        quint8 mNameColorIndex{0};
+        quint8 mTemplateColorIndex{0};
+    };
+    QHash<QByteArray, InternedUnit> mUnitCache; //!< maps raw unit value to normalized unit
+    /**
+     * @brief Interned process path together with its Colorizer palette index
+     */
+    struct InternedExe {
+        QString mExe;
+        quint8 mColorIndex{0};
+    };
+    QHash<QByteArray, InternedExe> mExeCache; //!< maps raw _EXE value to interned process path
+    QHash<QByteArray, QString> mSourceCache; //!< maps raw _HOSTNAME or _MACHINE_ID value to interned source
+    bool mReadSource{false}; //!< only merged journals need the source of every entry, see IJournalProvider::hasMultipleSources()
     bool mJournalAvailable{false};
+    const JournaldViewModel *q{nullptr};
     QList<LogEntry> mLog;
+    quint64 mLogGeneration{0}; //!< incremented whenever mLog is cleared
+    qsizetype mPrependedRows{0}; //!< rows prepended since last clear, handle position is row minus this value
     Filter mFilter;
     bool mEnableServiceTemplateGrouping{true};
+    std::unique_ptr<QFutureWatcher<ExportResult>> mExportWatcher; //!< running export of exportJournalToFile()
     bool mHeadCursorReached{false};
     bool mTailCursorReached{false};
     bool mModelResetActive{false};
@@ -0,0 +1,392 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "journalindex.h"
+#include "journalindex_p.h"
+#include "kjournaldlib_log_general.h"
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QSet>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <optional>
+
+namespace
+{
+// special slots for fields that are not stored as interned values
+constexpr int SLOT_NONE{-1};
+constexpr int SLOT_PRIORITY{-2};
+constexpr int SLOT_REALTIME{-3};
+constexpr int SLOT_MONOTONIC{-4};
+
+int slotForFieldName(QByteArrayView name)
+{
+    if (name == "_BOOT_ID") {
+        return JournalIndexPrivate::BOOT_ID;
+    } else if (name == "_TRANSPORT") {
+        return JournalIndexPrivate::TRANSPORT;
+    } else if (name == "_SYSTEMD_UNIT") {
+        return JournalIndexPrivate::SYSTEMD_UNIT;
+    } else if (name == "_SYSTEMD_USER_UNIT") {
+        return JournalIndexPrivate::SYSTEMD_USER_UNIT;
+    } else if (name == "_EXE") {
+        return JournalIndexPrivate::EXE;
+    } else if (name == "PRIORITY") {
+        return SLOT_PRIORITY;
+    } else if (name == "__REALTIME_TIMESTAMP") {
+        return SLOT_REALTIME;
+    } else if (name == "__MONOTONIC_TIMESTAMP") {
+        return SLOT_MONOTONIC;
+    }
+    return SLOT_NONE;
+}
+
+std::optional<JournalIndexPrivate::IndexedField> indexedField(JournaldHelper::Field field)
+{
+    switch (field) {
+    case JournaldHelper::Field::_BOOT_ID:
+        return JournalIndexPrivate::BOOT_ID;
+    case JournaldHelper::Field::_TRANSPORT:
+        return JournalIndexPrivate::TRANSPORT;
+    case JournaldHelper::Field::_SYSTEMD_UNIT:
+        return JournalIndexPrivate::SYSTEMD_UNIT;
+    case JournaldHelper::Field::_SYSTEMD_USER_UNIT:
+        return JournalIndexPrivate::SYSTEMD_USER_UNIT;
+    case JournaldHelper::Field::_EXE:
+        return JournalIndexPrivate::EXE;
+    default:
+        return std::nullopt;
+    }
+}
+}
+
+void JournalIndexPrivate::buildIndex(int threadCount, const std::atomic_bool *canceled)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const QList<JournaldExportReader::Partition> partitions = mReader->partitions(std::max(1, threadCount));
+    QList<PartitionIndex> partitionIndices;
+    if (partitions.size() == 1) {
+        partitionIndices.append(indexPartition(partitions.constFirst(), canceled));
+    } else {
+        QThreadPool pool;
+        pool.setMaxThreadCount(threadCount);
+        partitionIndices =
+            QtConcurrent::blockingMapped<QList<PartitionIndex>>(&pool, partitions, [this, canceled](const JournaldExportReader::Partition &partition) {
+                return indexPartition(partition, canceled);
+            });
+    }
+    if (canceled && canceled->load(std::memory_order_relaxed)) {
+        qCDebug(KJOURNALDLIB_GENERAL) << "Indexing of" << mFile.fileName() << "canceled after" << timer.elapsed() << "ms";
+        return;
+    }
+
+    // merge in file order, a partition whose begin was no real entry boundary is parsed again
+    // from the position at which the previous partition stopped
+    qsizetype position{0};
+    for (const PartitionIndex &partitionIndex : std::as_const(partitionIndices)) {
+        if (partitionIndex.mPartition.begin == position) {
+            mergePartition(partitionIndex);
+            position = std::max(position, partitionIndex.mEnd);
+        } else {
+            qCDebug(KJOURNALDLIB_GENERAL) << "Partition begin" << partitionIndex.mPartition.begin << "is inside of an entry, parse again from" << position;
+            const PartitionIndex reparsedIndex = indexPartition({position, partitionIndex.mPartition.end});
+            mergePartition(reparsedIndex);
+            position = std::max(position, reparsedIndex.mEnd);
+        }
+    }
+    qCDebug(KJOURNALDLIB_GENERAL) << "Indexed" << mEntries.size() << "entries of" << mFile.fileName() << "with" << partitions.size() << "partitions in"
+                                  << timer.elapsed() << "ms";
+}
+
+JournalIndexPrivate::PartitionIndex JournalIndexPrivate::indexPartition(const JournaldExportReader::Partition &partition, const std::atomic_bool *canceled) const
+{
+    PartitionIndex result;
+    result.mPartition = partition;
+    QHash<QByteArray, int> fieldSlots;
+    QHash<QByteArray, quint32> valueIds;
+    auto handler = [&](qsizetype offset, const QList<JournaldExportReader::Field> &fields) {
+        IndexedEntry entry;
+        entry.mOffset = offset;
+        for (const JournaldExportReader::Field &field : fields) {
+            const QByteArray name = QByteArray::fromRawData(field.name.data(), field.name.size());
+            auto slotIter = fieldSlots.constFind(name);
+            if (slotIter == fieldSlots.cend()) {
+                slotIter = fieldSlots.insert(name, slotForFieldName(field.name));
+            }
+            switch (slotIter.value()) {
+            case SLOT_NONE:
+                break;
+            case SLOT_PRIORITY: {
+                bool ok{false};
+                const int priority = field.value.toInt(&ok);
+                if (ok && priority >= 0 && priority < NO_PRIORITY) {
+                    entry.mPriority = priority;
+                }
+                break;
+            }
+            case SLOT_REALTIME:
+                entry.mRealtime = field.value.toULongLong();
+                break;
+            case SLOT_MONOTONIC:
+                entry.mMonotonic = field.value.toULongLong();
+                break;
+            default: {
+                const QByteArray value = QByteArray::fromRawData(field.value.data(), field.value.size());
+                auto valueIter = valueIds.constFind(value);
+                if (valueIter == valueIds.cend()) {
+                    valueIter = valueIds.insert(value, static_cast<quint32>(result.mValues.size()));
+                    result.mValues.append(field.value);
+                }
+                entry.mValues[slotIter.value()] = valueIter.value();
+            }
+            }
+        }
+        result.mEntries.append(entry);
+    };
+    // parse in steps to check for cancellation, every step ends at an entry boundary because the last
+    // entry of a step is parsed completely
+    qsizetype position = partition.begin;
+    while (position < partition.end) {
+        if (canceled && canceled->load(std::memory_order_relaxed)) {
+            break;
+        }
+        position = mReader->parsePartition({position, std::min(position + CANCEL_CHECK_INTERVAL, partition.end)}, handler);
+    }
+    result.mEnd = position;
+    return result;
+}
+
+void JournalIndexPrivate::mergePartition(const PartitionIndex &partitionIndex)
+{
+    QList<quint32> globalIds(partitionIndex.mValues.size(), 0);
+    for (qsizetype i = 1; i < partitionIndex.mValues.size(); ++i) {
+        globalIds[i] = internValue(partitionIndex.mValues.at(i));
+    }
+    mEntries.reserve(mEntries.size() + partitionIndex.mEntries.size());
+    for (IndexedEntry entry : partitionIndex.mEntries) {
+        for (quint32 &id : entry.mValues) {
+            id = globalIds.at(id);
+        }
+        mEntries.append(entry);
+    }
+}
+
+quint32 JournalIndexPrivate::internValue(QByteArrayView value)
+{
+    const QByteArray key = QByteArray::fromRawData(value.data(), value.size());
+    auto iter = mValueIds.constFind(key);
+    if (iter != mValueIds.cend()) {
+        return iter.value();
+    }
+    const auto id = static_cast<quint32>(mValues.size());
+    mValues.append(value);
+    mValueIds.insert(key, id);
+    return id;
+}
+
+quint32 JournalIndexPrivate::valueId(QByteArrayView value) const
+{
+    return mValueIds.value(QByteArray::fromRawData(value.data(), value.size()), 0);
+}
+
+JournalIndex::JournalIndex(const QString &exportFile, int threadCount, const std::atomic_bool *canceled)
+    : d(new JournalIndexPrivate)
+{
+    d->mFile.setFileName(exportFile);
+    if (!d->mFile.exists()) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "Export file does not exist, no index created" << exportFile;
+        return;
+    }
+    d->mReader = std::make_unique<JournaldExportReader>(&d->mFile);
+    d->buildIndex(threadCount, canceled);
+}
+
+JournalIndex::~JournalIndex() = default;
+
+bool JournalIndex::isValid() const
+{
+    return d->mReader && d->mFile.isOpen();
+}
+
+qsizetype JournalIndex::size() const
+{
+    return d->mEntries.size();
+}
+
+QList<qsizetype> JournalIndex::filter(const Filter &filter) const
+{
+    auto valueIds = [this](const QStringList &values) -> QSet<quint32> {
+        QSet<quint32> ids;
+        for (const QString &value : values) {
+            if (const quint32 id = d->valueId(value.toUtf8()); id != 0) {
+                ids.insert(id);
+            }
+        }
+        return ids;
+    };
+    struct Clause {
+        JournalIndexPrivate::IndexedField mField;
+        QSet<quint32> mValues;
+    };
+
+    // same boolean expression as created from journald matches in JournaldViewModelPrivate::resetJournal()
+    const QSet<quint32> kernelTransports = valueIds({QLatin1String("audit"), QLatin1String("driver"), QLatin1String("kernel")});
+    const QSet<quint32> nonKernelTransports = valueIds({QLatin1String("syslog"), QLatin1String("journal"), QLatin1String("stdout")});
+    const bool noCategoryFilter = filter.systemdUserUnitFilter().empty() && filter.systemdSystemUnitFilter().empty() && filter.exeFilter().empty();
+    QList<Clause> clauses;
+    if (filter.areKernelMessagesEnabled()) {
+        clauses.append({JournalIndexPrivate::TRANSPORT, noCategoryFilter ? kernelTransports + nonKernelTransports : kernelTransports});
+    } else if (noCategoryFilter) {
+        clauses.append({JournalIndexPrivate::TRANSPORT, nonKernelTransports});
+    }
+    if (!filter.systemdUserUnitFilter().empty()) {
+        clauses.append({JournalIndexPrivate::SYSTEMD_USER_UNIT, valueIds(filter.systemdUserUnitFilter())});
+    }
+    if (!filter.systemdSystemUnitFilter().empty()) {
+        clauses.append({JournalIndexPrivate::SYSTEMD_UNIT, valueIds(filter.systemdSystemUnitFilter())});
+    }
+    if (!filter.exeFilter().empty()) {
+        clauses.append({JournalIndexPrivate::EXE, valueIds(filter.exeFilter())});
+    }
+    const bool hasBootFilter = !filter.bootFilter().isEmpty();
+    const QSet<quint32> boots = valueIds(filter.bootFilter());
+    const std::optional<quint8> priorityLimit = filter.priorityFilter();
+
+    QList<qsizetype> positions;
+    for (qsizetype position = 0; position < d->mEntries.size(); ++position) {
+        const JournalIndexPrivate::IndexedEntry &entry = d->mEntries.at(position);
+        if (hasBootFilter && !boots.contains(entry.mValues[JournalIndexPrivate::BOOT_ID])) {
+            continue;
+        }
+        if (priorityLimit.has_value() && (entry.mPriority == JournalIndexPrivate::NO_PRIORITY || entry.mPriority > priorityLimit.value())) {
+            continue;
+        }
+        const bool matches = std::any_of(clauses.cbegin(), clauses.cend(), [&entry](const Clause &clause) {
+            return clause.mValues.contains(entry.mValues[clause.mField]);
+        });
+        if (matches) {
+            positions.append(position);
+        }
+    }
+    return positions;
+}
+
+QList<JournaldHelper::BootInfo> JournalIndex::bootInfo() const
+{
+    struct BootRange {
+        quint32 mBootId;
+        quint64 mSince;
+        quint64 mUntil;
+    };
+    QList<BootRange> ranges;
+    QHash<quint32, qsizetype> rangeForBoot;
+    for (const JournalIndexPrivate::IndexedEntry &entry : std::as_const(d->mEntries)) {
+        const quint32 bootId = entry.mValues[JournalIndexPrivate::BOOT_ID];
+        if (bootId == 0) {
+            continue;
+        }
+        auto iter = rangeForBoot.constFind(bootId);
+        if (iter == rangeForBoot.cend()) {
+            iter = rangeForBoot.insert(bootId, ranges.size());
+            ranges.append({bootId, entry.mRealtime, entry.mRealtime});
+        }
+        BootRange &range = ranges[iter.value()];
+        range.mSince = std::min(range.mSince, entry.mRealtime);
+        range.mUntil = std::max(range.mUntil, entry.mRealtime);
+    }
+
+    QList<JournaldHelper::BootInfo> boots;
+    boots.reserve(ranges.size());
+    for (const BootRange &range : std::as_const(ranges)) {
+        boots.append({QString::fromUtf8(d->mValues.at(range.mBootId)),
+                      QDateTime::fromMSecsSinceEpoch(range.mSince / 1000),
+                      QDateTime::fromMSecsSinceEpoch(range.mUntil / 1000)});
+    }
+    std::sort(boots.begin(), boots.end(), [](const JournaldHelper::BootInfo &lhs, const JournaldHelper::BootInfo &rhs) {
+        return lhs.mSince < rhs.mSince;
+    });
+    return boots;
+}
+
+QMap<JournaldHelper::Field, QHash<QString, quint64>> JournalIndex::uniqueCounts(const QString &bootId, const QList<JournaldHelper::Field> &fields) const
+{
+    const quint32 boot = d->valueId(bootId.toUtf8());
+    if (boot == 0) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Boot id not contained in export file" << bootId;
+        return {};
+    }
+
+    // count on value ids and convert only the distinct values to strings
+    QList<std::pair<JournaldHelper::Field, JournalIndexPrivate::IndexedField>> indexedFields;
+    bool countPriority{false};
+    for (const JournaldHelper::Field field : fields) {
+        if (field == JournaldHelper::Field::PRIORITY) {
+            countPriority = true;
+        } else if (const auto indexed = indexedField(field)) {
+            indexedFields.append({field, indexed.value()});
+        } else {
+            qCWarning(KJOURNALDLIB_GENERAL) << "Field is not indexed, skipping count of" << field;
+        }
+    }
+    QList<QHash<quint32, quint64>> valueCounts(indexedFields.size());
+    std::array<quint64, JournalIndexPrivate::NO_PRIORITY> priorityCounts{};
+    for (const JournalIndexPrivate::IndexedEntry &entry : std::as_const(d->mEntries)) {
+        if (entry.mValues[JournalIndexPrivate::BOOT_ID] != boot) {
+            continue;
+        }
+        for (qsizetype i = 0; i < indexedFields.size(); ++i) {
+            if (const quint32 id = entry.mValues[indexedFields.at(i).second]; id != 0) {
+                ++valueCounts[i][id];
+            }
+        }
+        if (countPriority && entry.mPriority != JournalIndexPrivate::NO_PRIORITY) {
+            ++priorityCounts[entry.mPriority];
+        }
+    }
+
+    QMap<JournaldHelper::Field, QHash<QString, quint64>> result;
+    for (qsizetype i = 0; i < indexedFields.size(); ++i) {
+        QHash<QString, quint64> &counts = result[indexedFields.at(i).first];
+        for (auto iter = valueCounts.at(i).cbegin(); iter != valueCounts.at(i).cend(); ++iter) {
+            counts.insert(QString::fromUtf8(d->mValues.at(iter.key())), iter.value());
+        }
+    }
+    if (countPriority) {
+        QHash<QString, quint64> &counts = result[JournaldHelper::Field::PRIORITY];
+        for (std::size_t priority = 0; priority < priorityCounts.size(); ++priority) {
+            if (priorityCounts.at(priority) > 0) {
+                counts.insert(QString::number(priority), priorityCounts.at(priority));
+            }
+        }
+    }
+    return result;
+}
+
+QList<JournaldExportReader::Field> JournalIndex::fields(qsizetype position) const
+{
+    if (position < 0 || position >= d->mEntries.size()) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Requested entry outside of index" << position;
+        return {};
+    }
+    QMutexLocker locker(&d->mReaderMutex);
+    if (!d->mReader->seek(d->mEntries.at(position).mOffset) || !d->mReader->readNext()) {
+        return {};
+    }
+    return d->mReader->fields();
+}
+
+quint64 JournalIndex::realtime(qsizetype position) const
+{
+    return d->mEntries.at(position).mRealtime;
+}
+
+quint64 JournalIndex::monotonic(qsizetype position) const
+{
+    return d->mEntries.at(position).mMonotonic;
+}
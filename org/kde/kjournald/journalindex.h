@@ -0,0 +1,97 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef JOURNALINDEX_H
+#define JOURNALINDEX_H
+
+#include "filter.h"
+#include "journaldexportreader.h"
+#include "journaldhelper.h"
+#include "kjournald_export.h"
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QThread>
+#include <atomic>
+#include <memory>
+
+class JournalIndexPrivate;
+
+/**
+ * @brief In-memory index over a journal in systemd's export format
+ *
+ * The export file is memory mapped and indexed once on construction. The index stores per entry
+ * its offset in the file, its timestamps and interned values of the fields that are used for
+ * filtering. All other fields are parsed on demand when an entry is accessed.
+ *
+ * Entries are expected in the chronological order in which journalctl exports them. Large files are
+ * split into partitions that are parsed in parallel and merged in file order.
+ *
+ * @note all methods are thread-safe
+ */
+class KJOURNALD_EXPORT JournalIndex
+{
+public:
+    /**
+     * @brief Create index for export file at @p exportFile using @p threadCount parser threads
+     *
+     * @param canceled optional flag that is checked regularly while parsing, if it is set the parsing stops
+     *        early and the index is left empty; the flag must outlive the constructor call
+     */
+    explicit JournalIndex(const QString &exportFile, int threadCount = QThread::idealThreadCount(), const std::atomic_bool *canceled = nullptr);
+    ~JournalIndex();
+
+    /**
+     * @return true if the export file could be read
+     */
+    bool isValid() const;
+
+    /**
+     * @return number of indexed entries
+     */
+    qsizetype size() const;
+
+    /**
+     * @brief Evaluate @p filter with the same semantics as the journald matches created by JournaldViewModel
+     * @return ordered positions of all matching entries
+     */
+    QList<qsizetype> filter(const Filter &filter) const;
+
+    /**
+     * @return ordered list of boots (first is earliest boot in time)
+     */
+    QList<JournaldHelper::BootInfo> bootInfo() const;
+
+    /**
+     * @brief Count entries per value of @p fields in boot @p bootId
+     *
+     * Only the indexed fields _BOOT_ID, PRIORITY, _TRANSPORT, _SYSTEMD_UNIT, _SYSTEMD_USER_UNIT and _EXE
+     * are supported, other fields are skipped.
+     *
+     * @return map of field to value and number of entries with that value
+     */
+    QMap<JournaldHelper::Field, QHash<QString, quint64>> uniqueCounts(const QString &bootId, const QList<JournaldHelper::Field> &fields) const;
+
+    /**
+     * @return all fields of entry at @p position, the views are valid as long as the index exists
+     */
+    QList<JournaldExportReader::Field> fields(qsizetype position) const;
+
+    /**
+     * @return realtime timestamp in microseconds of entry at @p position
+     */
+    quint64 realtime(qsizetype position) const;
+
+    /**
+     * @return monotonic timestamp in microseconds of entry at @p position
+     */
+    quint64 monotonic(qsizetype position) const;
+
+private:
+    std::unique_ptr<JournalIndexPrivate> d;
+};
+
+#endif // JOURNALINDEX_H
@@ -0,0 +1,93 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef JOURNALINDEX_P_H
+#define JOURNALINDEX_P_H
+
+#include "journaldexportreader.h"
+#include <QByteArray>
+#include <QFile>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <array>
+#include <atomic>
+#include <memory>
+
+class JournalIndexPrivate
+{
+public:
+    /**
+     * @brief Fields whose values are stored in the index for filtering
+     */
+    enum IndexedField {
+        BOOT_ID,
+        TRANSPORT,
+        SYSTEMD_UNIT,
+        SYSTEMD_USER_UNIT,
+        EXE,
+        INDEXED_FIELD_COUNT,
+    };
+
+    static constexpr quint8 NO_PRIORITY{0xFF};
+
+    struct IndexedEntry {
+        qsizetype mOffset{0}; //!< begin of entry in export data
+        quint64 mRealtime{0};
+        quint64 mMonotonic{0};
+        std::array<quint32, INDEXED_FIELD_COUNT> mValues{}; //!< interned value ids, 0 if field is not set
+        quint8 mPriority{NO_PRIORITY};
+    };
+
+    /**
+     * @brief Index of a single partition, value ids are local to the partition
+     */
+    struct PartitionIndex {
+        JournaldExportReader::Partition mPartition;
+        qsizetype mEnd{0}; //!< position at which parsing of the partition stopped
+        QList<IndexedEntry> mEntries;
+        QList<QByteArrayView> mValues{QByteArrayView()};
+    };
+
+    /**
+     * @brief parse all entries of the export data with @p threadCount workers and fill the index
+     *
+     * If @p canceled is set while parsing, the index stays empty.
+     */
+    void buildIndex(int threadCount, const std::atomic_bool *canceled);
+
+    /**
+     * @brief parse entries of @p partition, can be called concurrently
+     *
+     * Parsing stops early if @p canceled is set, it is checked every CANCEL_CHECK_INTERVAL bytes.
+     */
+    PartitionIndex indexPartition(const JournaldExportReader::Partition &partition, const std::atomic_bool *canceled = nullptr) const;
+
+    static constexpr qsizetype CANCEL_CHECK_INTERVAL{4 * 1024 * 1024};
+
+    /**
+     * @brief append entries of @p partitionIndex and map its local value ids to global ids
+     */
+    void mergePartition(const PartitionIndex &partitionIndex);
+
+    /**
+     * @return interned id of @p value, creates a new id if value was not seen before
+     */
+    quint32 internValue(QByteArrayView value);
+
+    /**
+     * @return id of @p value or 0 if value is not contained in any entry
+     */
+    quint32 valueId(QByteArrayView value) const;
+
+    QFile mFile;
+    std::unique_ptr<JournaldExportReader> mReader; //!< owns mapping of export data, all views point into it
+    mutable QMutex mReaderMutex;
+    QList<IndexedEntry> mEntries;
+    QList<QByteArrayView> mValues{QByteArrayView()}; //!< id to value, id 0 is reserved for unset fields
+    QHash<QByteArray, quint32> mValueIds; //!< keys are raw data references into export data
+};
+
+#endif // JOURNALINDEX_P_H
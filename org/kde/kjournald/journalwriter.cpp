@@ -0,0 +1,218 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "journalwriter.h"
+#include "kjournaldlib_log_general.h"
+#include <QIODevice>
+#include <QUtf8StringView>
+#include <QtEndian>
+#include <algorithm>
+#include <charconv>
+
+namespace
+{
+/**
+ * append @p value as decimal number with at least @p width digits
+ */
+void appendNumber(QByteArray &buffer, quint64 value, int width = 0)
+{
+    char digits[24];
+    const auto result = std::to_chars(std::begin(digits), std::end(digits), value);
+    const qsizetype length = result.ptr - digits;
+    if (length < width) {
+        buffer.append(width - length, '0');
+    }
+    buffer.append(digits, length);
+}
+
+/**
+ * @return true if the export format requires binary serialization for @p value
+ */
+bool requiresBinarySerialization(QByteArrayView value)
+{
+    const bool hasControlCharacter = std::any_of(value.cbegin(), value.cend(), [](char c) {
+        return static_cast<uchar>(c) < ' ' && c != '\t';
+    });
+    return hasControlCharacter || !QUtf8StringView(value).isValidUtf8();
+}
+}
+
+JournalWriter::JournalWriter(QIODevice *device, JournaldViewModel::ExportFormat format)
+    : mDevice(device)
+    , mFormat(format)
+{
+    mBuffer.reserve(BUFFER_CAPACITY + 64 * 1024);
+    if (!mDevice || !mDevice->isWritable()) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Journal writer requires device that is open for writing";
+        mError = true;
+    }
+}
+
+JournalWriter::~JournalWriter()
+{
+    flush();
+}
+
+void JournalWriter::beginEntry()
+{
+    mFirstField = true;
+    switch (mFormat) {
+    case JournaldViewModel::ExportFormat::PLAIN_TEXT:
+        // keep capacity, such that no allocations are needed for following entries
+        mRealtime.resize(0);
+        mSystemUnit.resize(0);
+        mUserUnit.resize(0);
+        mMessage.resize(0);
+        break;
+    case JournaldViewModel::ExportFormat::JOURNAL_EXPORT:
+        break;
+    case JournaldViewModel::ExportFormat::JSON_LINES:
+        mBuffer.append('{');
+        break;
+    }
+}
+
+void JournalWriter::addField(QByteArrayView name, QByteArrayView value)
+{
+    switch (mFormat) {
+    case JournaldViewModel::ExportFormat::PLAIN_TEXT:
+        if (name == "__REALTIME_TIMESTAMP") {
+            mRealtime.append(value);
+        } else if (name == "_SYSTEMD_UNIT") {
+            mSystemUnit.append(value);
+        } else if (name == "_SYSTEMD_USER_UNIT") {
+            mUserUnit.append(value);
+        } else if (name == "MESSAGE") {
+            mMessage.append(value);
+        }
+        break;
+    case JournaldViewModel::ExportFormat::JOURNAL_EXPORT:
+        mBuffer.append(name);
+        if (requiresBinarySerialization(value)) {
+            mBuffer.append('\n');
+            char size[8];
+            qToLittleEndian<quint64>(value.size(), size);
+            mBuffer.append(size, sizeof(size));
+        } else {
+            mBuffer.append('=');
+        }
+        mBuffer.append(value);
+        mBuffer.append('\n');
+        break;
+    case JournaldViewModel::ExportFormat::JSON_LINES:
+        if (!mFirstField) {
+            mBuffer.append(',');
+        }
+        appendJsonString(name);
+        mBuffer.append(':');
+        if (QUtf8StringView(value).isValidUtf8()) {
+            appendJsonString(value);
+        } else {
+            mBuffer.append('[');
+            for (qsizetype i = 0; i < value.size(); ++i) {
+                if (i > 0) {
+                    mBuffer.append(',');
+                }
+                appendNumber(mBuffer, static_cast<uchar>(value.at(i)));
+            }
+            mBuffer.append(']');
+        }
+        break;
+    }
+    mFirstField = false;
+}
+
+bool JournalWriter::endEntry()
+{
+    switch (mFormat) {
+    case JournaldViewModel::ExportFormat::PLAIN_TEXT:
+        appendPlainTextLine();
+        break;
+    case JournaldViewModel::ExportFormat::JOURNAL_EXPORT:
+        mBuffer.append('\n');
+        break;
+    case JournaldViewModel::ExportFormat::JSON_LINES:
+        mBuffer.append("}\n");
+        break;
+    }
+    if (mBuffer.size() >= BUFFER_CAPACITY) {
+        return flush();
+    }
+    return !mError;
+}
+
+bool JournalWriter::flush()
+{
+    if (mError) {
+        mBuffer.resize(0);
+        return false;
+    }
+    if (!mBuffer.isEmpty()) {
+        if (mDevice->write(mBuffer) != mBuffer.size()) {
+            qCWarning(KJOURNALDLIB_GENERAL) << "Could not write journal entries:" << mDevice->errorString();
+            mError = true;
+        }
+        mBuffer.resize(0);
+    }
+    return !mError;
+}
+
+bool JournalWriter::hasError() const
+{
+    return mError;
+}
+
+void JournalWriter::appendJsonString(QByteArrayView value)
+{
+    static constexpr char hexDigits[] = "0123456789abcdef";
+    mBuffer.append('"');
+    for (const char c : value) {
+        switch (c) {
+        case '"':
+            mBuffer.append("\\\"");
+            break;
+        case '\\':
+            mBuffer.append("\\\\");
+            break;
+        case '\n':
+            mBuffer.append("\\n");
+            break;
+        case '\t':
+            mBuffer.append("\\t");
+            break;
+        case '\r':
+            mBuffer.append("\\r");
+            break;
+        default:
+            if (static_cast<uchar>(c) < ' ') {
+                mBuffer.append("\\u00");
+                mBuffer.append(hexDigits[c >> 4]);
+                mBuffer.append(hexDigits[c & 0xF]);
+            } else {
+                mBuffer.append(c);
+            }
+        }
+    }
+    mBuffer.append('"');
+}
+
+void JournalWriter::appendPlainTextLine()
+{
+    // time of day in UTC, formatted as HH:mm:ss.zzz without creating QDateTime objects
+    constexpr quint64 msecsPerDay{24 * 60 * 60 * 1000};
+    const quint64 msecs = (mRealtime.toULongLong() / 1000) % msecsPerDay;
+    appendNumber(mBuffer, msecs / (60 * 60 * 1000), 2);
+    mBuffer.append(':');
+    appendNumber(mBuffer, msecs / (60 * 1000) % 60, 2);
+    mBuffer.append(':');
+    appendNumber(mBuffer, msecs / 1000 % 60, 2);
+    mBuffer.append('.');
+    appendNumber(mBuffer, msecs % 1000, 3);
+    mBuffer.append(" UTC ");
+    mBuffer.append(mUserUnit.isEmpty() ? mSystemUnit : mUserUnit);
+    mBuffer.append(' ');
+    mBuffer.append(mMessage);
+    mBuffer.append('\n');
+}
@@ -0,0 +1,82 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef JOURNALWRITER_H
+#define JOURNALWRITER_H
+
+#include "journaldviewmodel.h"
+#include "kjournald_export.h"
+#include <QByteArray>
+#include <QByteArrayView>
+
+class QIODevice;
+
+/**
+ * @brief Buffered serialization of journal entries into a QIODevice
+ *
+ * Entries are written field by field between beginEntry() and endEntry(). Field data is copied into
+ * an internal buffer immediately, such that callers can pass views that are only valid during the
+ * call (e.g. data from sd_journal_enumerate_data()). The buffer is written to the device whenever it
+ * exceeds its capacity and when flush() is called.
+ *
+ * Supported formats:
+ * - plain text: one line per entry with UTC time, unit and message
+ * - journald export format: as created by "journalctl -o export", including binary fields
+ * - JSON lines: one JSON object per entry as created by "journalctl -o json", data that is no valid
+ *   UTF-8 is written as array of byte values
+ */
+class KJOURNALD_EXPORT JournalWriter
+{
+public:
+    explicit JournalWriter(QIODevice *device, JournaldViewModel::ExportFormat format);
+
+    /**
+     * Destroys the writer and flushes remaining data
+     */
+    ~JournalWriter();
+
+    JournalWriter(const JournalWriter &) = delete;
+    JournalWriter &operator=(const JournalWriter &) = delete;
+
+    void beginEntry();
+    void addField(QByteArrayView name, QByteArrayView value);
+
+    /**
+     * @brief finish current entry
+     * @return false if writing to device failed
+     */
+    bool endEntry();
+
+    /**
+     * @brief write all buffered data to device
+     * @return false if writing to device failed
+     */
+    bool flush();
+
+    /**
+     * @return true if any write to the device failed
+     */
+    bool hasError() const;
+
+private:
+    void appendJsonString(QByteArrayView value);
+    void appendPlainTextLine();
+
+    static constexpr qsizetype BUFFER_CAPACITY{1024 * 1024};
+
+    QIODevice *const mDevice;
+    const JournaldViewModel::ExportFormat mFormat;
+    QByteArray mBuffer;
+    bool mFirstField{true};
+    bool mError{false};
+    // plain text lines are composed of fields in fixed order, the values are copied because the
+    // passed views may become invalid before the entry ends
+    QByteArray mRealtime;
+    QByteArray mSystemUnit;
+    QByteArray mUserUnit;
+    QByteArray mMessage;
+};
+
+#endif // JOURNALWRITER_H
@@ -64,6 +64,16 @@ QString LocalJournal::currentBootId() const
     return d->mCurrentBootId;
 }
 
+QFileInfoList LocalJournal::journalFiles() const
+{
+    if (!d->mPath.isEmpty()) {
+        const QFileInfo info(d->mPath);
+        return info.isFile() ? QFileInfoList{info} : SdJournal::journalFiles(d->mPath);
+    }
+    // default locations of persistent and volatile system and user journals
+    return SdJournal::journalFiles(QLatin1String("/var/log/journal")) + SdJournal::journalFiles(QLatin1String("/run/log/journal"));
+}
+
 uint64_t LocalJournal::usage() const
 {
     auto journal = openJournal();
@@ -55,6 +55,11 @@ public:
      */
     QString currentBootId() const override;
 
+    /**
+     * @copydoc IJournalProvider::journalFiles()
+     */
+    QFileInfoList journalFiles() const override;
+
     /**
      * @brief Get file system usage of journal
      * @return size of journal in bytes
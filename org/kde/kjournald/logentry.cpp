@@ -4,6 +4,7 @@
 */
 
 #include "logentry.h"
+#include "colorizer.h"
 
 LogEntry::LogEntry(const QDateTime &date,
                    quint64 monotonicTimestamp,
@@ -22,6 +23,8 @@ LogEntry::LogEntry(const QDateTime &date,
     , m_exe{exe}
     , m_priority{priority}
     , m_cursor{cursor}
+    , m_unitColorIndex{Colorizer::colorIndex(QStringView(unit))}
+    , m_exeColorIndex{Colorizer::colorIndex(QStringView(exe))}
 {
     setMessage(message);
 }
@@ -70,18 +73,79 @@ void LogEntry::setBootId(const QString &bootId)
 }
 
 void LogEntry::setUnit(const QString &unit)
+{
+    setUnit(unit, Colorizer::colorIndex(QStringView(unit)));
+}
+
+void LogEntry::setUnit(const QString &unit, quint8 colorIndex)
 {
     m_unit = unit;
+    m_unitColorIndex = colorIndex;
 }
 
 void LogEntry::setUnitTemplateGroup(const QString &unit)
+{
+    setUnitTemplateGroup(unit, Colorizer::colorIndex(QStringView(unit)));
+}
+
+void LogEntry::setUnitTemplateGroup(const QString &unit, quint8 colorIndex)
 {
     m_unitTemplateGroup = unit;
+    m_unitTemplateGroupColorIndex = colorIndex;
 }
 
 void LogEntry::setExe(const QString &exe)
+{
+    setExe(exe, Colorizer::colorIndex(QStringView(exe)));
+}
+
+void LogEntry::setExe(const QString &exe, quint8 colorIndex)
 {
     m_exe = exe;
+    m_exeColorIndex = colorIndex;
+}
+
+namespace
+{
+LogEntry::Continuity continuity(const QString &value, const QString &previous)
+{
+    // removing an empty string does not change the value
+    if (previous.isEmpty()) {
+        return LogEntry::Continuity::CHANGED;
+    }
+    if (value == previous) {
+        return LogEntry::Continuity::UNCHANGED;
+    }
+    return value.contains(previous) ? LogEntry::Continuity::EXTENDED : LogEntry::Continuity::CHANGED;
+}
+
+QString changedSubstring(LogEntry::Continuity continuity, const QString &value, const QString &previous)
+{
+    switch (continuity) {
+    case LogEntry::Continuity::UNCHANGED:
+        return QString();
+    case LogEntry::Continuity::CHANGED:
+        return value;
+    case LogEntry::Continuity::EXTENDED:
+        return QString(value).remove(previous);
+    }
+    return QString();
+}
+}
+
+void LogEntry::updateContinuity(const LogEntry *previous)
+{
+    if (!previous) {
+        m_unitContinuity = Continuity::CHANGED;
+        m_exeContinuity = Continuity::CHANGED;
+        m_unitChangedSubstring = m_unit;
+        m_exeChangedSubstring = m_exe;
+        return;
+    }
+    m_unitContinuity = continuity(m_unit, previous->m_unit);
+    m_exeContinuity = continuity(m_exe, previous->m_exe);
+    m_unitChangedSubstring = changedSubstring(m_unitContinuity, m_unit, previous->m_unit);
+    m_exeChangedSubstring = changedSubstring(m_exeContinuity, m_exe, previous->m_exe);
 }
 
 void LogEntry::setCursor(const QString &cursor)
@@ -89,4 +153,9 @@ void LogEntry::setCursor(const QString &cursor)
     m_cursor = cursor;
 }
 
+void LogEntry::setSource(const QString &source)
+{
+    m_source = source;
+}
+
 #include "moc_logentry.cpp"
@@ -22,10 +22,20 @@ class LogEntry
     Q_PROPERTY(QString unit READ unit WRITE setUnit)
     Q_PROPERTY(QString exe READ exe WRITE setExe)
     Q_PROPERTY(QString cursor READ cursor WRITE setCursor)
+    Q_PROPERTY(QString source READ source WRITE setSource)
 
     QML_VALUE_TYPE(entry)
 
 public:
+    /**
+     * @brief Relation of a field value to the same field of the previous entry
+     */
+    enum class Continuity : quint8 {
+        CHANGED, //!< value is shown completely
+        UNCHANGED, //!< value equals the previous one
+        EXTENDED, //!< value differs but contains the previous one, only the remainder is shown
+    };
+
     LogEntry() = default;
     ~LogEntry() = default;
     /** convenience constructor **/
@@ -86,12 +96,81 @@ public:
         return m_exe;
     }
     void setExe(const QString &exe);
+    /**
+     * @return Colorizer palette index of unit(), set together with the unit
+     */
+    inline quint8 unitColorIndex() const
+    {
+        return m_unitColorIndex;
+    }
+    /**
+     * @return Colorizer palette index of unitTemplateGroup(), set together with the template group
+     */
+    inline quint8 unitTemplateGroupColorIndex() const
+    {
+        return m_unitTemplateGroupColorIndex;
+    }
+    /**
+     * @return Colorizer palette index of exe(), set together with the exe
+     */
+    inline quint8 exeColorIndex() const
+    {
+        return m_exeColorIndex;
+    }
+    /**
+     * @brief set unit, template group and process together with their precomputed palette indices
+     *
+     * Readers that intern these values use this to avoid computing palette indices for every entry.
+     */
+    void setUnit(const QString &unit, quint8 colorIndex);
+    void setUnitTemplateGroup(const QString &unit, quint8 colorIndex);
+    void setExe(const QString &exe, quint8 colorIndex);
     inline QString cursor() const
     {
         return m_cursor;
     }
     void setCursor(const QString &cursor);
 
+    /**
+     * @return machine the entry originates from, i.e. its hostname or machine ID if no hostname is logged
+     */
+    inline QString source() const
+    {
+        return m_source;
+    }
+    void setSource(const QString &source);
+
+    /**
+     * @brief compute the continuity and changed substrings of unit and process compared to the @p previous entry
+     *
+     * The changed substrings are stored with the entry, such that displaying them needs no string operations.
+     *
+     * @param previous the preceding entry or nullptr if this is the first entry
+     */
+    void updateContinuity(const LogEntry *previous);
+    inline Continuity unitContinuity() const
+    {
+        return m_unitContinuity;
+    }
+    inline Continuity exeContinuity() const
+    {
+        return m_exeContinuity;
+    }
+    /**
+     * @return part of unit() that is not contained in the unit of the previous entry, empty if unchanged
+     */
+    inline QString unitChangedSubstring() const
+    {
+        return m_unitChangedSubstring;
+    }
+    /**
+     * @return part of exe() that is not contained in the process of the previous entry, empty if unchanged
+     */
+    inline QString exeChangedSubstring() const
+    {
+        return m_exeChangedSubstring;
+    }
+
 private:
     QString m_id;
     QString m_message;
@@ -103,6 +182,14 @@ private:
     QString m_unitTemplateGroup;
     QString m_exe;
     QString m_cursor;
+    QString m_source;
+    QString m_unitChangedSubstring;
+    QString m_exeChangedSubstring;
+    quint8 m_unitColorIndex{0};
+    quint8 m_unitTemplateGroupColorIndex{0};
+    quint8 m_exeColorIndex{0};
+    Continuity m_unitContinuity{Continuity::CHANGED};
+    Continuity m_exeContinuity{Continuity::CHANGED};
 };
 
 #endif // LOGENTRY_H
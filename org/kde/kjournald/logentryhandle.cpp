@@ -0,0 +1,102 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "logentryhandle.h"
+#include "journaldviewmodel.h"
+#include "journaldviewmodel_p.h"
+
+LogEntryHandle::LogEntryHandle(const JournaldViewModel *model, quint64 generation, qsizetype position)
+    : mModel{model}
+    , mGeneration{generation}
+    , mPosition{position}
+{
+}
+
+const LogEntry *LogEntryHandle::resolve() const
+{
+    if (!mModel) {
+        return nullptr;
+    }
+    return mModel->d->entryAt(mGeneration, mPosition);
+}
+
+bool LogEntryHandle::isValid() const
+{
+    return resolve() != nullptr;
+}
+
+QString LogEntryHandle::id() const
+{
+    const LogEntry *entry = resolve();
+    return entry ? entry->id() : QString();
+}
+
+QString LogEntryHandle::message() const
+{
+    const LogEntry *entry = resolve();
+    return entry ? entry->message() : QString();
+}
+
+QDateTime LogEntryHandle::date() const
+{
+    const LogEntry *entry = resolve();
+    return entry ? entry->date() : QDateTime();
+}
+
+quint64 LogEntryHandle::monotonicTimestamp() const
+{
+    const LogEntry *entry = resolve();
+    return entry ? entry->monotonicTimestamp() : 0;
+}
+
+int LogEntryHandle::priority() const
+{
+    const LogEntry *entry = resolve();
+    return entry ? entry->priority() : 0;
+}
+
+QString LogEntryHandle::bootId() const
+{
+    const LogEntry *entry = resolve();
+    return entry ? entry->bootId() : QString();
+}
+
+QString LogEntryHandle::unit() const
+{
+    const LogEntry *entry = resolve();
+    return entry ? entry->unit() : QString();
+}
+
+QString LogEntryHandle::exe() const
+{
+    const LogEntry *entry = resolve();
+    return entry ? entry->exe() : QString();
+}
+
+QString LogEntryHandle::cursor() const
+{
+    const LogEntry *entry = resolve();
+    return entry ? entry->cursor() : QString();
+}
+
+QString LogEntryHandle::source() const
+{
+    const LogEntry *entry = resolve();
+    return entry ? entry->source() : QString();
+}
+
+bool LogEntryHandle::matches(const QString &needle, bool caseSensitive) const
+{
+    const LogEntry *entry = resolve();
+    return entry ? entry->matches(needle, caseSensitive) : false;
+}
+
+LogEntry LogEntryHandle::entry() const
+{
+    const LogEntry *entry = resolve();
+    return entry ? *entry : LogEntry();
+}
+
+#include "moc_logentryhandle.cpp"
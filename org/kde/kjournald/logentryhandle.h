@@ -0,0 +1,82 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef LOGENTRYHANDLE_H
+#define LOGENTRYHANDLE_H
+
+#include "kjournald_export.h"
+#include "logentry.h"
+#include <QDateTime>
+#include <QObject>
+#include <QPointer>
+#include <QQmlEngine>
+
+class JournaldViewModel;
+
+/**
+ * @brief Lightweight reference to a log entry stored in a JournaldViewModel
+ *
+ * Instead of copying the entry, the handle only stores the model, the generation of the model's
+ * storage and a position that stays valid when rows are prepended. All properties are read lazily
+ * from the model. After a model reset the handle becomes invalid and all properties return default
+ * values.
+ */
+class KJOURNALD_EXPORT LogEntryHandle
+{
+    Q_GADGET
+
+    Q_PROPERTY(bool valid READ isValid)
+    Q_PROPERTY(QString id READ id)
+    Q_PROPERTY(QString message READ message)
+    Q_PROPERTY(QDateTime date READ date)
+    Q_PROPERTY(quint64 monotonicTimestamp READ monotonicTimestamp)
+    Q_PROPERTY(int priority READ priority)
+    Q_PROPERTY(QString bootId READ bootId)
+    Q_PROPERTY(QString unit READ unit)
+    Q_PROPERTY(QString exe READ exe)
+    Q_PROPERTY(QString cursor READ cursor)
+    Q_PROPERTY(QString source READ source)
+
+    QML_VALUE_TYPE(logEntryHandle)
+
+public:
+    LogEntryHandle() = default;
+    LogEntryHandle(const JournaldViewModel *model, quint64 generation, qsizetype position);
+
+    /**
+     * @return true if the referenced entry is still stored in the model
+     */
+    bool isValid() const;
+
+    QString id() const;
+    QString message() const;
+    QDateTime date() const;
+    quint64 monotonicTimestamp() const;
+    int priority() const;
+    QString bootId() const;
+    QString unit() const;
+    QString exe() const;
+    QString cursor() const;
+    QString source() const;
+
+    /**
+     * @copydoc LogEntry::matches()
+     */
+    Q_INVOKABLE bool matches(const QString &needle, bool caseSensitive) const;
+
+    /**
+     * @return copy of the referenced entry or a default constructed entry if the handle is invalid
+     */
+    LogEntry entry() const;
+
+private:
+    const LogEntry *resolve() const;
+
+    QPointer<const JournaldViewModel> mModel;
+    quint64 mGeneration{0};
+    qsizetype mPosition{0};
+};
+
+#endif // LOGENTRYHANDLE_H
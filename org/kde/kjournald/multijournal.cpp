@@ -0,0 +1,71 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "multijournal.h"
+#include "kjournaldlib_log_general.h"
+#include <QFileInfo>
+
+MultiJournal::MultiJournal(const QStringList &paths)
+    : mPaths(paths)
+{
+    if (paths.isEmpty()) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "No paths provided for merged journal";
+    }
+}
+
+MultiJournal::~MultiJournal() = default;
+
+std::unique_ptr<SdJournal> MultiJournal::openJournal() const
+{
+    QStringList files;
+    const QFileInfoList fileInfos = journalFiles();
+    files.reserve(fileInfos.size());
+    for (const QFileInfo &info : fileInfos) {
+        files.append(info.absoluteFilePath());
+    }
+    qCDebug(KJOURNALDLIB_GENERAL) << "create sd_journal instance from merged files" << files;
+    return std::make_unique<SdJournal>(files);
+}
+
+QString MultiJournal::currentBootId() const
+{
+    return QString();
+}
+
+QFileInfoList MultiJournal::journalFiles() const
+{
+    QFileInfoList files;
+    for (const QString &path : mPaths) {
+        const QFileInfo info(path);
+        if (info.isFile()) {
+            files.append(info);
+        } else {
+            files.append(SdJournal::journalFiles(path));
+        }
+    }
+    // the same file might be reachable via several paths
+    QFileInfoList uniqueFiles;
+    for (const QFileInfo &file : std::as_const(files)) {
+        if (!uniqueFiles.contains(file)) {
+            uniqueFiles.append(file);
+        }
+    }
+    if (uniqueFiles.isEmpty()) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "No journal files found in paths" << mPaths;
+    }
+    return uniqueFiles;
+}
+
+bool MultiJournal::hasMultipleSources() const
+{
+    return true;
+}
+
+QStringList MultiJournal::paths() const
+{
+    return mPaths;
+}
+
+#include "moc_multijournal.cpp"
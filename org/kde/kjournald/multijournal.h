@@ -0,0 +1,70 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef MULTIJOURNAL_H
+#define MULTIJOURNAL_H
+
+#include "ijournalprovider.h"
+#include "kjournald_export.h"
+#include <QStringList>
+#include <memory>
+
+/**
+ * @brief The MultiJournal class merges several journald databases into one journal
+ *
+ * This is useful to correlate logs of several machines. All journal files of the given directories and
+ * files are opened as a single sd_journal object, which interleaves their entries by time. Thus the merged
+ * journal can be paged, filtered and searched like a single journal. The machine an entry originates
+ * from is available via its "_HOSTNAME" and "_MACHINE_ID" fields, see JournaldViewModel::SOURCE.
+ *
+ * @note Journal files that are created later in one of the directories are not considered.
+ */
+class KJOURNALD_EXPORT MultiJournal : public IJournalProvider
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief Construct merged journal from journald DBs at @p paths
+     * Every path can be a directory or a file.
+     */
+    explicit MultiJournal(const QStringList &paths);
+
+    /**
+     * @brief Destroys the journal
+     */
+    ~MultiJournal() override;
+
+    /**
+     * @copydoc IJournalProvider::openJournal()
+     */
+    std::unique_ptr<SdJournal> openJournal() const override;
+
+    /**
+     * @brief Merged journals have no common current boot
+     * @return always empty string
+     */
+    QString currentBootId() const override;
+
+    /**
+     * @copydoc IJournalProvider::journalFiles()
+     */
+    QFileInfoList journalFiles() const override;
+
+    /**
+     * @brief Merged journals usually combine logs of several machines
+     * @return always true
+     */
+    bool hasMultipleSources() const override;
+
+    /**
+     * @return directories and files that are merged
+     */
+    QStringList paths() const;
+
+private:
+    const QStringList mPaths;
+};
+
+#endif // MULTIJOURNAL_H
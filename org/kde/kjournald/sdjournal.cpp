@@ -6,7 +6,10 @@
 #include "sdjournal.h"
 #include "kjournaldlib_log_general.h"
 #include <QDir>
+#include <QFile>
 #include <QLatin1StringView>
+#include <QMetaMethod>
+#include <vector>
 
 SdJournal::SdJournal(const QString &path, int flags)
 {
@@ -26,18 +29,17 @@ SdJournal::SdJournal(const QString &path, int flags)
             return;
         }
     } else if (QFileInfo(path).isFile()) {
-        const char **files = new const char *[1];
-        QByteArray journalPath = path.toLocal8Bit();
-        files[0] = journalPath.data();
+        openFiles({path}, flags);
+    }
+}
 
-        auto expectedJournal = owning_ptr_call<sd_journal>(sd_journal_open_files, files, flags);
-        if (expectedJournal.ret < 0) {
-            qCCritical(KJOURNALDLIB_GENERAL) << "Could not open journal from file" << path << ":" << strerror(-expectedJournal.ret);
-        } else {
-            mJournal = std::move(expectedJournal.value);
-        }
-        delete[] files;
+SdJournal::SdJournal(const QStringList &files, int flags)
+{
+    if (files.isEmpty()) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "No journal files provided, abort opening";
+        return;
     }
+    openFiles(files, flags);
 }
 
 SdJournal::SdJournal(int flags)
@@ -47,19 +49,32 @@ SdJournal::SdJournal(int flags)
         qCCritical(KJOURNALDLIB_GENERAL) << "Failed to open journal:" << strerror(-expectedJournal.ret);
     } else {
         mJournal = std::move(expectedJournal.value);
-        mFd = sd_journal_get_fd(mJournal.get());
-        if (mFd > 0) {
-            mJournalSocketNotifier = std::make_unique<QSocketNotifier>(mFd, QSocketNotifier::Read);
-            connect(mJournalSocketNotifier.get(), &QSocketNotifier::activated, this, &SdJournal::handleFdUpdate);
-        } else {
-            qCWarning(KJOURNALDLIB_GENERAL) << "Could not create FD" << strerror(-mFd);
-            mFd = 0;
-        }
     }
 }
 
 SdJournal::~SdJournal() = default;
 
+void SdJournal::openFiles(const QStringList &files, int flags)
+{
+    QList<QByteArray> paths;
+    paths.reserve(files.size());
+    // sd_journal_open_files() expects a NULL terminated array
+    std::vector<const char *> pathPointers;
+    pathPointers.reserve(files.size() + 1);
+    for (const QString &file : files) {
+        paths.append(QFile::encodeName(file));
+        pathPointers.push_back(paths.last().constData());
+    }
+    pathPointers.push_back(nullptr);
+
+    auto expectedJournal = owning_ptr_call<sd_journal>(sd_journal_open_files, pathPointers.data(), flags);
+    if (expectedJournal.ret < 0) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "Could not open journal from files" << files << ":" << strerror(-expectedJournal.ret);
+    } else {
+        mJournal = std::move(expectedJournal.value);
+    }
+}
+
 sd_journal *SdJournal::get()
 {
     return mJournal.get();
@@ -70,20 +85,44 @@ bool SdJournal::isValid() const
     return mJournal != nullptr;
 }
 
+void SdJournal::connectNotify(const QMetaMethod &signal)
+{
+    if (signal == QMetaMethod::fromSignal(&SdJournal::journalUpdated)) {
+        setupNotifier();
+    }
+}
+
+void SdJournal::setupNotifier()
+{
+    if (mJournalSocketNotifier || !mJournal) {
+        return;
+    }
+    // the inotify watches are created with the first call, thus only for journals that are followed
+    mFd = sd_journal_get_fd(mJournal.get());
+    if (mFd > 0) {
+        mJournalSocketNotifier = std::make_unique<QSocketNotifier>(mFd, QSocketNotifier::Read);
+        connect(mJournalSocketNotifier.get(), &QSocketNotifier::activated, this, &SdJournal::handleFdUpdate);
+    } else {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Could not create FD" << strerror(-mFd);
+        mFd = 0;
+    }
+}
+
 void SdJournal::handleFdUpdate()
 {
     if (mFd == 0) {
         return;
     }
-    // reset descriptor
-    QFile file;
-    if (file.open(mFd, QIODevice::ReadOnly)) {
-        file.readAll();
-        file.close();
-    } else {
-        qCWarning(KJOURNALDLIB_GENERAL) << "Could not open journal FD";
+    // consumes the inotify events and picks up journal files that were created meanwhile
+    const int result = sd_journal_process(mJournal.get());
+    if (result < 0) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Could not process journal changes:" << strerror(-result);
+        return;
     }
-    qCDebug(KJOURNALDLIB_GENERAL) << "Local journal FD updated";
+    if (result == SD_JOURNAL_NOP) {
+        return;
+    }
+    qCDebug(KJOURNALDLIB_GENERAL) << "Journal FD updated";
     Q_EMIT journalUpdated();
 }
 
@@ -94,6 +133,21 @@ bool SdJournal::areJournalFilesAvailable(const QString &path)
     // we expect the very basic setup to not change any time soon; also, no existing sd-journal API provides
     // information about available journal files as of systemd v258
 
+    const QFileInfoList files = journalFiles(path);
+    for (const auto &fileInfo : files) {
+        // first 8 bytes of those journal files must start with specific ASCII identifier
+        QFile file{fileInfo.absoluteFilePath()};
+        if (file.open(QIODevice::ReadOnly)) {
+            if (QLatin1StringView(file.read(8)) == QLatin1StringView{"LPKSHHRH"}) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+QFileInfoList SdJournal::journalFiles(const QString &path)
+{
     // implement logic of sd_journal_open_directory() which looks two folder levels deep
     const QDir firstDir = QDir(path);
     QFileInfoList files;
@@ -105,17 +159,7 @@ bool SdJournal::areJournalFilesAvailable(const QString &path)
             files << subDir.entryInfoList({QLatin1String{"*.journal"}}, QDir::Filter::Files);
         }
     }
-
-    for (const auto &fileInfo : std::as_const(files)) {
-        // first 8 bytes of those journal files must start with specific ASCII identifier
-        QFile file{fileInfo.absoluteFilePath()};
-        if (file.open(QIODevice::ReadOnly)) {
-            if (QLatin1StringView(file.read(8)) == QLatin1StringView{"LPKSHHRH"}) {
-                return true;
-            }
-        }
-    }
-    return false;
+    return files;
 }
 
 #include "moc_sdjournal.cpp"
@@ -8,7 +8,9 @@
 
 #include "kjournald_export.h"
 #include "memory.h"
+#include <QFileInfoList>
 #include <QSocketNotifier>
+#include <QStringList>
 #include <systemd/sd-journal.h>
 
 class KJOURNALD_EXPORT SdJournal : public QObject
@@ -16,6 +18,14 @@ class KJOURNALD_EXPORT SdJournal : public QObject
     Q_OBJECT
 public:
     explicit SdJournal(const QString &path, int flags = 0);
+
+    /**
+     * @brief Open all journal @p files as one journal
+     *
+     * Entries of all files are interleaved by sd-journal, such that the journal can be iterated, filtered
+     * and searched like a single journal.
+     */
+    explicit SdJournal(const QStringList &files, int flags = 0);
     explicit SdJournal(int flags = 0);
     ~SdJournal() override;
     sd_journal *get();
@@ -29,16 +39,35 @@ public:
 
     static bool areJournalFilesAvailable(const QString &path);
 
+    /**
+     * @brief list all journal files that sd_journal_open_directory() would consider for @p path
+     *
+     * This considers "*.journal" files in the directory and in its direct subdirectories.
+     */
+    static QFileInfoList journalFiles(const QString &path);
+
+protected:
+    /**
+     * Changes of the journal are only monitored once journalUpdated() is connected
+     */
+    void connectNotify(const QMetaMethod &signal) override;
+
 private Q_SLOTS:
     void handleFdUpdate();
 
 Q_SIGNALS:
     /**
      * @brief signal is fired when new entries are added to the journal
+     *
+     * This applies to the system journal as well as to journal directories and files, including
+     * journal files that are created in a monitored directory after the journal was opened.
      */
     void journalUpdated();
 
 private:
+    void openFiles(const QStringList &files, int flags);
+    void setupNotifier();
+
     std::unique_ptr<sd_journal> mJournal;
     qintptr mFd{0};
     std::unique_ptr<QSocketNotifier> mJournalSocketNotifier;
@@ -6,15 +6,22 @@
 #include "systemdjournalremote.h"
 #include "kjournaldlib_log_general.h"
 #include "systemdjournalremote_p.h"
+#include "journaldexportreader.h"
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFileInfo>
 #include <QFileSystemWatcher>
 #include <QProcess>
 #include <QThread>
+#include <algorithm>
 
 SystemdJournalRemotePrivate::SystemdJournalRemotePrivate(SystemdJournalRemote *q)
+    : q(q)
 {
     QObject::connect(&mJournalRemoteProcess, &QProcess::errorOccurred, q, &SystemdJournalRemote::handleJournalRemoteProcessErrors);
+    QObject::connect(&mTemporaryJournalDirWatcher, &QFileSystemWatcher::directoryChanged, q, [this]() {
+        checkJournalCreated();
+    });
     mJournalRemoteProcess.setProcessChannelMode(QProcess::ForwardedChannels);
     if (!sanityCheckForSystemdJournalRemoteExec()) {
         qCCritical(KJOURNALDLIB_GENERAL) << "Sanity checks failed, which indidate systemd-journal-remote libexe is not available";
@@ -43,6 +50,105 @@ QString SystemdJournalRemotePrivate::journalFile() const
     return mTemporyJournalDir.path() + QLatin1String("/remote.journal");
 }
 
+void SystemdJournalRemotePrivate::startImport(const QString &filePath)
+{
+    mImportTimer.start();
+    mImportFile.setFileName(filePath);
+    mImportDecompressor = JournaldExportReader::createDecompressionDevice(&mImportFile);
+    mImportDevice = mImportDecompressor ? mImportDecompressor.get() : static_cast<QIODevice *>(&mImportFile);
+    if (!mImportDevice->open(QIODevice::ReadOnly)) {
+        qCCritical(KJOURNALDLIB_GENERAL) << "Could not open export file" << filePath << mImportDevice->errorString();
+        finishImport();
+        return;
+    }
+    mImportChunk.resize(IMPORT_CHUNK_SIZE);
+
+    QObject::connect(&mJournalRemoteProcess, &QProcess::started, q, [this]() {
+        writeNextChunk();
+    });
+    QObject::connect(&mJournalRemoteProcess, &QProcess::bytesWritten, q, [this]() {
+        // only continue once the previous chunk is consumed, such that at most one chunk is buffered
+        if (mJournalRemoteProcess.bytesToWrite() == 0) {
+            writeNextChunk();
+        }
+    });
+    QObject::connect(&mJournalRemoteProcess, &QProcess::finished, q, [this]() {
+        finishImport();
+    });
+
+    // command structure: systemd-journal-remote --output=foo.journal - < foo.export
+    qCDebug(KJOURNALDLIB_GENERAL) << QLatin1String("starting process: ") + mSystemdJournalRemoteExec + QLatin1String(" --output=") + journalFile()
+            + QLatin1String(" - < ") + filePath;
+    mJournalRemoteProcess.start(mSystemdJournalRemoteExec, QStringList() << QLatin1String("--output=") + journalFile() << QLatin1String("-"));
+}
+
+void SystemdJournalRemotePrivate::writeNextChunk()
+{
+    if (mJournalRemoteProcess.state() != QProcess::Running || !mImportDevice->isOpen()) {
+        return;
+    }
+    const qint64 bytesRead = mImportDevice->read(mImportChunk.data(), mImportChunk.size());
+    if (bytesRead <= 0) {
+        if (bytesRead < 0) {
+            qCCritical(KJOURNALDLIB_GENERAL) << "Could not read export file" << mImportFile.fileName() << mImportDevice->errorString();
+        }
+        // end of input, process terminates after importing the remaining data
+        mImportDevice->close();
+        mJournalRemoteProcess.closeWriteChannel();
+        return;
+    }
+    mJournalRemoteProcess.write(mImportChunk.constData(), bytesRead);
+    mImportedBytes += bytesRead;
+
+    // the position of the input file also covers data that is buffered by the decompressor
+    const qint64 size = mImportFile.size();
+    const qreal progress = size > 0 ? std::min<qreal>(static_cast<qreal>(mImportFile.pos()) / size, 1.) : 0.;
+    if (progress != mImportProgress) {
+        mImportProgress = progress;
+        Q_EMIT q->importProgressChanged();
+    }
+    // the directory watcher only reports creation of the file, but not when its header is written
+    checkJournalCreated();
+}
+
+void SystemdJournalRemotePrivate::finishImport()
+{
+    if (mImportFinished) {
+        return;
+    }
+    mImportFinished = true;
+    if (mImportDevice->isOpen()) {
+        mImportDevice->close();
+    }
+    if (mJournalRemoteProcess.exitStatus() != QProcess::NormalExit || mJournalRemoteProcess.exitCode() != 0) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "systemd-journal-remote did not finish regularly, exit code:" << mJournalRemoteProcess.exitCode();
+    }
+
+    const double seconds = std::max<qint64>(mImportTimer.nsecsElapsed(), 1) / 1e9;
+    const qint64 inputSize = mImportFile.size();
+    qCInfo(KJOURNALDLIB_GENERAL).nospace() << "Imported " << mImportFile.fileName() << " in " << seconds << "s: " << inputSize / 1e6 << " MB input ("
+                                           << inputSize / 1e6 / seconds << " MB/s), " << mImportedBytes / 1e6 << " MB export data ("
+                                           << mImportedBytes / 1e6 / seconds << " MB/s)";
+
+    mImportProgress = 1.;
+    Q_EMIT q->importProgressChanged();
+    checkJournalCreated();
+    if (!mJournalReady) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Import finished without creating a journal file:" << journalFile();
+    }
+    Q_EMIT q->importFinished();
+}
+
+void SystemdJournalRemotePrivate::checkJournalCreated()
+{
+    if (mJournalReady || !q->isJournalCreated()) {
+        return;
+    }
+    mJournalReady = true;
+    Q_EMIT q->journalFileChanged();
+    Q_EMIT q->journalReady();
+}
+
 // TODO additional access can easily be implemented by using systemd-journal-remote CLI:
 //   --listen-raw=ADDR      Listen for connections at ADDR
 //   --listen-http=ADDR     Listen for HTTP connections at ADDR
@@ -58,7 +164,8 @@ SystemdJournalRemote::SystemdJournalRemote(const QString &filePath)
     if (!QFile::exists(filePath)) {
         qCCritical(KJOURNALDLIB_GENERAL) << "Provided export journal file format does not exists, no journal created" << filePath;
     }
-    if (!filePath.endsWith(QLatin1String("export"))) {
+    const bool compressed = JournaldExportReader::isCompressed(filePath);
+    if (!(compressed ? QFileInfo(filePath).completeBaseName() : filePath).endsWith(QLatin1String("export"))) {
         qCWarning(KJOURNALDLIB_GENERAL) << "Provided export file has uncommon file ending that is not \".export\":" << filePath;
     }
 
@@ -66,17 +173,16 @@ SystemdJournalRemote::SystemdJournalRemote(const QString &filePath)
     if (!d->mTemporaryJournalDirWatcher.addPath(d->mTemporyJournalDir.path())) {
         qCWarning(KJOURNALDLIB_GENERAL) << "could not add path to system watcher:" << d->mTemporyJournalDir.path();
     }
-    // command structure: systemd-journal-remote --output=foo.journal foo.export
-    qCDebug(KJOURNALDLIB_GENERAL) << QLatin1String("starting process: ") + d->mSystemdJournalRemoteExec + QLatin1String(" --output=") + d->journalFile()
-            + QLatin1String(" ") + filePath;
-    d->mJournalRemoteProcess.start(d->mSystemdJournalRemoteExec, QStringList() << QLatin1String("--output=") + d->journalFile() << filePath);
-    // local file access currently only works when the full journal file is written
-    d->mJournalRemoteProcess.waitForFinished();
+    d->startImport(filePath);
 }
 
 void SystemdJournalRemote::handleJournalRemoteProcessErrors(QProcess::ProcessError error)
 {
     qCCritical(KJOURNALDLIB_GENERAL) << "systemd-journal-remote error occured:" << error;
+    // no finished signal follows for processes that never started
+    if (error == QProcess::FailedToStart && d->mImportDevice) {
+        d->finishImport();
+    }
 }
 
 SystemdJournalRemote::SystemdJournalRemote(const QString &url, const QString &port)
@@ -95,6 +201,9 @@ SystemdJournalRemote::SystemdJournalRemote(const QString &url, const QString &po
 
 SystemdJournalRemote::~SystemdJournalRemote()
 {
+    // no import handling and signals during destruction
+    QObject::disconnect(&d->mJournalRemoteProcess, nullptr, this, nullptr);
+    QObject::disconnect(&d->mTemporaryJournalDirWatcher, nullptr, this, nullptr);
     d->mJournalRemoteProcess.terminate();
     d->mJournalRemoteProcess.waitForFinished(1000);
     if (d->mJournalRemoteProcess.state() == QProcess::Running) {
@@ -129,6 +238,11 @@ QString SystemdJournalRemote::currentBootId() const
     return QString();
 }
 
+QFileInfoList SystemdJournalRemote::journalFiles() const
+{
+    return SdJournal::journalFiles(d->mTemporyJournalDir.path());
+}
+
 uint64_t SystemdJournalRemote::usage() const
 {
     auto journal = openJournal();
@@ -148,4 +262,14 @@ bool SystemdJournalRemote::isSystemdRemoteAvailable() const
     return d->sanityCheckForSystemdJournalRemoteExec();
 }
 
+qreal SystemdJournalRemote::importProgress() const
+{
+    return d->mImportProgress;
+}
+
+bool SystemdJournalRemote::isImportFinished() const
+{
+    return d->mImportFinished;
+}
+
 #include "moc_systemdjournalremote.cpp"
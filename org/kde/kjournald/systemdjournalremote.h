@@ -24,9 +24,18 @@ class KJOURNALD_EXPORT SystemdJournalRemote : public IJournalProvider
 {
     Q_OBJECT
     Q_PROPERTY(QString journalFile READ journalFile NOTIFY journalFileChanged)
+    Q_PROPERTY(qreal importProgress READ importProgress NOTIFY importProgressChanged)
+    Q_PROPERTY(bool importFinished READ isImportFinished NOTIFY importFinished)
 public:
     /**
      * @brief Construct journal object from file containing logs in systemd's journal export format
+     *
+     * Export files that are compressed with gzip, bzip2, xz or zstd (see JournaldExportReader::isCompressed())
+     * are decompressed while being imported.
+     *
+     * The import runs asynchronously in the event loop: the export data is written chunk-wise to the stdin
+     * of systemd-journal-remote. The signal journalReady() is emitted as soon as the journal file can be
+     * opened, which usually happens long before importFinished().
      */
     explicit SystemdJournalRemote(const QString &filePath);
 
@@ -68,6 +77,11 @@ public:
      */
     QString currentBootId() const override;
 
+    /**
+     * @copydoc IJournalProvider::journalFiles()
+     */
+    QFileInfoList journalFiles() const override;
+
     /**
      * @brief Get file system usage of journal
      * @return size of journal in bytes
@@ -76,8 +90,30 @@ public:
 
     bool isSystemdRemoteAvailable() const;
 
+    /**
+     * @brief Progress of the import from an export file
+     *
+     * The progress is computed from the bytes consumed from the input file, i.e. for compressed files
+     * from the compressed size. For journals that are received from a URL, the progress stays at 0.
+     *
+     * @return value between 0 and 1
+     */
+    qreal importProgress() const;
+
+    /**
+     * @return true if all data of the export file is written into the journal file
+     */
+    bool isImportFinished() const;
+
 Q_SIGNALS:
     void journalFileChanged();
+    void importProgressChanged();
+    void importFinished();
+
+    /**
+     * @brief emitted once when the journal file is created and openJournal() provides a valid journal
+     */
+    void journalReady();
 
 private Q_SLOTS:
     void handleJournalRemoteProcessErrors(QProcess::ProcessError error);
@@ -6,10 +6,13 @@
 #ifndef SYSTEMDJOURNALREMOTE_PRIVATE_H
 #define SYSTEMDJOURNALREMOTE_PRIVATE_H
 
+#include <QElapsedTimer>
+#include <QFile>
 #include <QFileSystemWatcher>
 #include <QProcess>
 #include <QString>
 #include <QTemporaryDir>
+#include <memory>
 #include <systemd/sd-journal.h>
 
 class SystemdJournalRemote;
@@ -21,10 +24,46 @@ public:
     bool sanityCheckForSystemdJournalRemoteExec() const;
     QString journalFile() const;
 
+    /**
+     * @brief start streaming the export file at @p filePath into systemd-journal-remote
+     *
+     * Compressed export files are decompressed on the fly, no decompressed copy of the export file is
+     * stored. The import continues asynchronously via writeNextChunk().
+     */
+    void startImport(const QString &filePath);
+
+    /**
+     * @brief write next chunk of the export file to the process, closes the write channel at the end of input
+     */
+    void writeNextChunk();
+
+    /**
+     * @brief handle termination of the import process, the import rate is logged as compressed and uncompressed MB/s
+     */
+    void finishImport();
+
+    /**
+     * @brief emit journalReady() once the journal file exists
+     */
+    void checkJournalCreated();
+
+    static constexpr qint64 IMPORT_CHUNK_SIZE{1024 * 1024};
+
+    SystemdJournalRemote *const q;
     QTemporaryDir mTemporyJournalDir;
     QFileSystemWatcher mTemporaryJournalDirWatcher;
     QProcess mJournalRemoteProcess;
     const QString mSystemdJournalRemoteExec = QLatin1String("/lib/systemd/systemd-journal-remote");
+
+    QFile mImportFile;
+    std::unique_ptr<QIODevice> mImportDecompressor; //!< only set for compressed export files
+    QIODevice *mImportDevice{nullptr}; //!< either mImportFile or mImportDecompressor
+    QByteArray mImportChunk;
+    qint64 mImportedBytes{0}; //!< uncompressed bytes written to process
+    QElapsedTimer mImportTimer;
+    qreal mImportProgress{0};
+    bool mImportFinished{false};
+    bool mJournalReady{false};
 };
 
 #endif
@@ -0,0 +1,203 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "uniquevaluescache.h"
+#include "kjournaldlib_log_general.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTextStream>
+#include <algorithm>
+
+namespace
+{
+constexpr quint32 CACHE_MAGIC{0x4b4a5556}; // "KJUV"
+constexpr quint8 CACHE_VERSION{2}; // version 2 adds entry counts
+
+/**
+ * @return ID of the running boot of this system, the format matches the _BOOT_ID field
+ */
+QString systemBootId()
+{
+    static const QString bootId = []() {
+        QFile file(QLatin1String("/proc/sys/kernel/random/boot_id"));
+        if (!file.open(QIODevice::ReadOnly | QFile::Text)) {
+            return QString();
+        }
+        // example value: "918581c5-a27a-4ac6-9f37-c160fd20d1b5"
+        return QTextStream(&file).readAll().trimmed().remove(QLatin1Char('-'));
+    }();
+    return bootId;
+}
+}
+
+QString UniqueValuesCache::cacheDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/uniquevalues");
+}
+
+QByteArray UniqueValuesCache::journalIdentity(const QFileInfoList &files)
+{
+    if (files.isEmpty()) {
+        return {};
+    }
+    // temporary journals get new paths for every session, cache entries for them would never be used again
+    const QString tempPath = QDir(QDir::tempPath()).canonicalPath() + QLatin1Char('/');
+    for (const QFileInfo &file : files) {
+        const QString path = file.canonicalFilePath().isEmpty() ? file.absoluteFilePath() : file.canonicalFilePath();
+        if (path.startsWith(tempPath)) {
+            return {};
+        }
+    }
+    QStringList locations;
+    if (files.size() == 1) {
+        locations << files.constFirst().absoluteFilePath();
+    } else {
+        for (const QFileInfo &file : files) {
+            locations << file.absolutePath();
+        }
+        locations.removeDuplicates();
+        locations.sort();
+    }
+    return QCryptographicHash::hash(locations.join(QLatin1Char('\n')).toUtf8(), QCryptographicHash::Sha1).toHex();
+}
+
+bool UniqueValuesCache::isValidBootId(const QString &bootId)
+{
+    return bootId.size() == 32 && std::all_of(bootId.cbegin(), bootId.cend(), [](QChar c) {
+               return (c >= QLatin1Char('0') && c <= QLatin1Char('9')) || (c >= QLatin1Char('a') && c <= QLatin1Char('f'))
+                   || (c >= QLatin1Char('A') && c <= QLatin1Char('F'));
+           });
+}
+
+QString UniqueValuesCache::cacheFilePath(const QByteArray &journalIdentity, const QString &bootId)
+{
+    return cacheDirectory() + QLatin1Char('/') + bootId + QLatin1Char('_') + QString::fromLatin1(journalIdentity) + QLatin1String(".cache");
+}
+
+std::optional<UniqueValuesCache::UniqueValues>
+UniqueValuesCache::load(const QByteArray &journalIdentity, const JournaldHelper::BootInfo &boot, ValueCounts *counts)
+{
+    if (journalIdentity.isEmpty() || !isValidBootId(boot.mBootId)) {
+        return std::nullopt;
+    }
+    QFile file(cacheFilePath(journalIdentity, boot.mBootId));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic{0};
+    quint8 version{0};
+    QString bootId;
+    qint64 since{0};
+    qint64 until{0};
+    QByteArray payload;
+    stream >> magic >> version >> bootId >> since >> until >> payload;
+    if (stream.status() != QDataStream::Ok || magic != CACHE_MAGIC || version != CACHE_VERSION) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Discarding unreadable unique values cache" << file.fileName();
+        return std::nullopt;
+    }
+    if (bootId != boot.mBootId || since != boot.mSince.toMSecsSinceEpoch() || until != boot.mUntil.toMSecsSinceEpoch()) {
+        qCDebug(KJOURNALDLIB_GENERAL) << "Unique values cache outdated for boot" << boot.mBootId;
+        return std::nullopt;
+    }
+
+    QByteArray data = qUncompress(payload);
+    QDataStream payloadStream(&data, QIODevice::ReadOnly);
+    payloadStream.setVersion(QDataStream::Qt_6_0);
+    quint32 fieldCount{0};
+    payloadStream >> fieldCount;
+    UniqueValues values;
+    ValueCounts valueCounts;
+    for (quint32 i = 0; i < fieldCount && payloadStream.status() == QDataStream::Ok; ++i) {
+        quint32 field{0};
+        QStringList list;
+        QList<quint64> listCounts; // aligned with list, empty if counts are unknown
+        payloadStream >> field >> list >> listCounts;
+        values.insert(static_cast<JournaldHelper::Field>(field), list);
+        if (!listCounts.isEmpty() && listCounts.size() == list.size()) {
+            QHash<QString, quint64> &fieldCounts = valueCounts[static_cast<JournaldHelper::Field>(field)];
+            for (qsizetype j = 0; j < list.size(); ++j) {
+                fieldCounts.insert(list.at(j), listCounts.at(j));
+            }
+        }
+    }
+    if (payloadStream.status() != QDataStream::Ok) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Discarding corrupted unique values cache" << file.fileName();
+        return std::nullopt;
+    }
+    if (counts) {
+        *counts = std::move(valueCounts);
+    }
+    // modification time tracks last use for pruning
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    return values;
+}
+
+bool UniqueValuesCache::store(const QByteArray &journalIdentity, const JournaldHelper::BootInfo &boot, const UniqueValues &values, const ValueCounts &counts)
+{
+    if (journalIdentity.isEmpty() || !isValidBootId(boot.mBootId)) {
+        return false;
+    }
+    if (boot.mBootId == systemBootId()) {
+        qCDebug(KJOURNALDLIB_GENERAL) << "Skip storing unique values of running boot" << boot.mBootId;
+        return false;
+    }
+    if (!QDir().mkpath(cacheDirectory())) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Could not create cache directory" << cacheDirectory();
+        return false;
+    }
+
+    QByteArray data;
+    QDataStream payloadStream(&data, QIODevice::WriteOnly);
+    payloadStream.setVersion(QDataStream::Qt_6_0);
+    payloadStream << static_cast<quint32>(values.size());
+    for (auto iter = values.cbegin(); iter != values.cend(); ++iter) {
+        QList<quint64> listCounts;
+        if (counts.contains(iter.key())) {
+            const QHash<QString, quint64> &fieldCounts = counts[iter.key()];
+            listCounts.reserve(iter.value().size());
+            for (const QString &value : iter.value()) {
+                listCounts.append(fieldCounts.value(value));
+            }
+        }
+        payloadStream << static_cast<quint32>(iter.key()) << iter.value() << listCounts;
+    }
+
+    QSaveFile file(cacheFilePath(journalIdentity, boot.mBootId));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(KJOURNALDLIB_GENERAL) << "Could not write unique values cache" << file.fileName() << file.errorString();
+        return false;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << CACHE_MAGIC << CACHE_VERSION << boot.mBootId << boot.mSince.toMSecsSinceEpoch() << boot.mUntil.toMSecsSinceEpoch() << qCompress(data);
+    if (!file.commit()) {
+        return false;
+    }
+    prune();
+    return true;
+}
+
+void UniqueValuesCache::prune(int maxAgeDays, qint64 maxSize)
+{
+    const QFileInfoList files = QDir(cacheDirectory()).entryInfoList({QStringLiteral("*.cache")}, QDir::Files, QDir::Time);
+    // sorted by modification time, most recently used first
+    const QDateTime oldest = QDateTime::currentDateTime().addDays(-maxAgeDays);
+    qint64 size{0};
+    for (const QFileInfo &file : std::as_const(files)) {
+        size += file.size();
+        if (file.lastModified() < oldest || size > maxSize) {
+            qCDebug(KJOURNALDLIB_GENERAL) << "Removing unique values cache" << file.fileName();
+            QFile::remove(file.absoluteFilePath());
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#ifndef UNIQUEVALUESCACHE_H
+#define UNIQUEVALUESCACHE_H
+
+#include "journaldhelper.h"
+#include "kjournald_export.h"
+#include <QByteArray>
+#include <QFileInfoList>
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <optional>
+
+/**
+ * @brief Persistent cache for unique field values of a boot
+ *
+ * Entries of a finished boot never change, hence the unique values of its fields can be stored
+ * on disk and reused across application runs. Every cache file is identified by the boot id and
+ * the identity of the journal it was computed from. On load, the first and last entry time of
+ * the boot are compared with the stored ones, such that a boot that got new entries or a journal
+ * that was truncated is never served from stale data.
+ */
+class KJOURNALD_EXPORT UniqueValuesCache
+{
+public:
+    using UniqueValues = QMap<JournaldHelper::Field, QStringList>;
+    using ValueCounts = QMap<JournaldHelper::Field, QHash<QString, quint64>>;
+
+    /**
+     * @return directory in which cache files are stored
+     */
+    static QString cacheDirectory();
+
+    /**
+     * @brief Compute identity of a journal from its files
+     *
+     * Only the directories (or single file path) are considered, such that rotation of journal
+     * files does not invalidate the cache of other boots. Journals in the temporary directory, like
+     * imports of systemd-journal-remote, are never opened again and thus get no identity.
+     *
+     * @return identity or empty byte array if @p files is empty or located in a temporary directory
+     */
+    static QByteArray journalIdentity(const QFileInfoList &files);
+
+    /**
+     * @brief Load unique values of boot @p boot from cache
+     *
+     * If @p counts is set, it is filled with the stored number of entries per value. Fields for which
+     * no counts were stored are omitted.
+     *
+     * @return cached unique values or std::nullopt if there is no valid cache entry
+     */
+    static std::optional<UniqueValues> load(const QByteArray &journalIdentity, const JournaldHelper::BootInfo &boot, ValueCounts *counts = nullptr);
+
+    /**
+     * @brief Store unique values @p values of boot @p boot together with optional entry counts @p counts
+     *
+     * The running boot of the system is not stored, because its entries still change. After storing,
+     * cache files that were not used for MAX_AGE_DAYS are removed and the least recently used files are
+     * removed until the cache is smaller than MAX_SIZE.
+     *
+     * @return true if cache file was written successfully
+     */
+    static bool store(const QByteArray &journalIdentity, const JournaldHelper::BootInfo &boot, const UniqueValues &values, const ValueCounts &counts = {});
+
+    /**
+     * @brief remove cache files that are older than @p maxAgeDays days and, beginning with the least recently
+     * used ones, further files until the cache size is at most @p maxSize bytes
+     */
+    static void prune(int maxAgeDays = MAX_AGE_DAYS, qint64 maxSize = MAX_SIZE);
+
+    static constexpr int MAX_AGE_DAYS{90};
+    static constexpr qint64 MAX_SIZE{64 * 1024 * 1024};
+
+private:
+    /**
+     * @return true if @p bootId is a boot ID with 32 hex digits, such that it can be used in file names
+     */
+    static bool isValidBootId(const QString &bootId);
+    static QString cacheFilePath(const QByteArray &journalIdentity, const QString &bootId);
+};
+
+#endif // UNIQUEVALUESCACHE_H
@@ -79,6 +79,7 @@ ListView {
                 required property color color
                 required text
                 required property string longtext
+                required property var count
                 required property var model
 
                 width: ListView.view.width
@@ -91,7 +92,12 @@ ListView {
                         text: checkboxDelegate.text
                         textFormat: Text.PlainText
                         elide: Text.ElideRight
-                        width: parent.width - checkbox.width - 0.5 * Kirigami.Units.gridUnit
+                        width: parent.width - checkbox.width - checkboxCount.width - 2 * parent.spacing
+                    }
+                    Label {
+                        id: checkboxCount
+                        text: checkboxDelegate.count !== undefined ? checkboxDelegate.count.toLocaleString(Qt.locale(), 'f', 0) : ""
+                        color: Kirigami.Theme.disabledTextColor
                     }
                     ColoredCheckbox {
                         id: checkbox
@@ -124,6 +130,7 @@ ListView {
                 required property bool selected
                 required text
                 required property string longtext
+                required property var count
                 required property var model
 
                 width: ListView.view.width
@@ -136,6 +143,10 @@ ListView {
                         elide: Text.ElideRight
                         Layout.fillWidth: true
                     }
+                    Label {
+                        text: radioDelegate.count !== undefined ? radioDelegate.count.toLocaleString(Qt.locale(), 'f', 0) : ""
+                        color: Kirigami.Theme.disabledTextColor
+                    }
 
                     RadioButton {
                         id: radiobox
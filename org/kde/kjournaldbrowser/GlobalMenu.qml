@@ -17,6 +17,7 @@ Labs.MenuBar {
     signal openJournalFileSelectionDialog()
     signal openJournalFolderSelectionDialog()
     signal copyViewToClipboard()
+    signal openJournalExportDialog()
 
     Labs.Menu {
         title: KI18n.i18nc("@title:menu", "File")
@@ -66,6 +67,11 @@ Labs.MenuBar {
             icon.name: "edit-copy"
             onTriggered: root.copyViewToClipboard()
         }
+        Labs.MenuItem {
+            text: KI18n.i18nc("@action:inmenu", "Export filtered journal…")
+            icon.name: "document-save-as"
+            onTriggered: root.openJournalExportDialog()
+        }
         Labs.Menu {
             title: KI18n.i18nc("@title:menu", "Limit Accessed Logs")
             icon.name: "view-filter"
@@ -0,0 +1,95 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Dialogs
+import QtQuick.Layouts
+import org.kde.kjournald
+import org.kde.ki18n
+
+pragma ComponentBehavior: Bound
+
+Item {
+    id: root
+
+    /**
+     * journalModel the JournaldViewModel object whose filtered journal shall be exported
+     */
+    required property JournaldViewModel journalModel
+
+    function open() {
+        fileDialog.open()
+    }
+
+    FileDialog {
+        id: fileDialog
+        title: KI18n.i18nc("@title", "Export filtered journal")
+        fileMode: FileDialog.SaveFile
+        // order matches JournaldViewModel.ExportFormat
+        nameFilters: [KI18n.i18nc("@item", "Text files (*.txt)"), KI18n.i18nc("@item", "Journal export files (*.export)"), KI18n.i18nc("@item", "JSON lines files (*.jsonl)")]
+        onAccepted: {
+            const formats = [JournaldViewModel.PLAIN_TEXT, JournaldViewModel.JOURNAL_EXPORT, JournaldViewModel.JSON_LINES]
+            progressBar.value = 0
+            progressBar.to = -1
+            progressLabel.text = ""
+            if (root.journalModel.exportJournalToFile(fileDialog.selectedFile, formats[fileDialog.selectedNameFilter.index])) {
+                progressDialog.open()
+            } else {
+                errorDialog.informativeText = ""
+                errorDialog.open()
+            }
+        }
+    }
+
+    Connections {
+        target: root.journalModel
+        function onExportProgress(written, total) {
+            progressBar.to = total
+            progressBar.value = written
+            progressLabel.text = total < 0 ? KI18n.i18ncp("@info", "%1 entry written", "%1 entries written", written)
+                                           : KI18n.i18nc("@info", "%1 of %2 entries written", written, total)
+        }
+        function onExportFinished(success, errorString) {
+            progressDialog.close()
+            if (!success) {
+                errorDialog.informativeText = errorString
+                errorDialog.open()
+            }
+        }
+    }
+
+    Dialog {
+        id: progressDialog
+        parent: Overlay.overlay
+        anchors.centerIn: parent
+        modal: true
+        closePolicy: Popup.NoAutoClose
+        title: KI18n.i18nc("@title", "Exporting journal")
+
+        ColumnLayout {
+            anchors.fill: parent
+            ProgressBar {
+                id: progressBar
+                Layout.fillWidth: true
+                Layout.minimumWidth: 300
+                from: 0
+                // total number of entries is unknown for journals that are not indexed
+                indeterminate: to < 0
+            }
+            Label {
+                id: progressLabel
+                Layout.fillWidth: true
+            }
+        }
+    }
+
+    MessageDialog {
+        id: errorDialog
+        title: KI18n.i18nc("@title", "Export failed")
+        text: KI18n.i18nc("@info", "The journal could not be exported to %1.", fileDialog.selectedFile.toString())
+        buttons: MessageDialog.Ok
+    }
+}
@@ -18,10 +18,12 @@ Item {
 
     FileDialog {
         id: fileDialog
-        title: KI18n.i18nc("@title", "Select journal file")
-        nameFilters: [KI18n.i18nc("@item", "Journal files (*.journal)"), KI18n.i18nc("@item", "All files (*)")]
+        title: KI18n.i18nc("@title", "Select journal files")
+        fileMode: FileDialog.OpenFiles
+        nameFilters: [KI18n.i18nc("@item", "Journal files (*.journal)"), KI18n.i18nc("@item", "Journal export files (*.export *.export.gz *.export.bz2 *.export.xz *.export.zst)"), KI18n.i18nc("@item", "All files (*)")]
         onAccepted: {
-            DatabaseProvider.loadJournalFromLocalPath(fileDialog.selectedFile)
+            // several selected journal files are interleaved into one journal
+            DatabaseProvider.loadJournalFromLocalPaths(fileDialog.selectedFiles)
         }
     }
 }
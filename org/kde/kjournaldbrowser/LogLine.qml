@@ -9,7 +9,7 @@ import org.kde.kjournaldbrowser
 
 Item {
     id: root
-    required property entry logEntry
+    required property logEntryHandle logEntry
     readonly property bool __isHighlighted : logEntry.matches(TextSearch.needle, TextSearch.caseSensitive)
 
     implicitWidth: text.implicitWidth
@@ -48,23 +48,16 @@ ListView {
     signal textCopied(string text)
 
     /**
-     * Copy all log entries from the visible part of the view.
+     * Copy log entries of rows @p from to @p to, by default the visible part of the view.
      * The result of this copy operation will be provided with the @see textCopied signal
      */
     function copyTextFromView(from, to) {
-        var startIndex = Math.min(from, to)
-        var endIndex = Math.max(from, to)
-        if (endIndex < 0) {
-            endIndex = root.journalModel.rowCount()
+        if (from === undefined || to === undefined) {
+            from = root.indexAt(1, root.contentY)
+            to = root.indexAt(1, root.contentY + root.height)
         }
-        var content = ""
-        for (var i = startIndex; i <= endIndex; ++i) {
-            // TODO print date/time information with user selected time zone
-            content += Formatter.formatTime(root.journalModel.data(root.journalModel.index(i, 0), JournaldViewModel.DATETIME), true) + " UTC "
-                        + root.journalModel.data(root.journalModel.index(i, 0), JournaldViewModel.SYSTEMD_UNIT) + " "
-                        + root.journalModel.data(root.journalModel.index(i, 0), JournaldViewModel.MESSAGE) + "\n"
-        }
-        root.textCopied(content)
+        // TODO print date/time information with user selected time zone
+        root.textCopied(root.journalModel.exportRowsToText(from, to))
     }
 
     function scrollToSearchResult(needle, direction, caseSensitive) {
@@ -131,7 +124,7 @@ ListView {
         id: coloredLogLineDelegate
 
         required property int index
-        required property entry entry
+        required property logEntryHandle entry
         required property string systemdunit
         required property string systemdunit_changed_substring
         required property string exe
@@ -35,6 +35,10 @@ StatefulApp.StatefulWindow {
     JournalFileSelectionDialog {
         id: journalFileSelectionDialog
     }
+    JournalExportDialog {
+        id: journalExportDialog
+        journalModel: journalModel
+    }
 
     Component.onCompleted: {
         if (root.initialJournalPath !== "" && initialJournalPathViaPortal === false) {
@@ -91,6 +95,7 @@ StatefulApp.StatefulWindow {
     menuBar: TopMenuBar {
         visible: (Kirigami.Settings.hasPlatformMenuBar === false || Kirigami.Settings.hasPlatformMenuBar === undefined) && !Kirigami.Settings.isMobile
         onCopyViewToClipboard: logView.copyTextFromView()
+        onOpenJournalExportDialog: journalExportDialog.open()
         onOpenJournalFolderSelectionDialog: journalFolderSelectionDialog.open()
         onOpenJournalFileSelectionDialog: journalFileSelectionDialog.open()
     }
@@ -101,6 +106,7 @@ StatefulApp.StatefulWindow {
         sourceComponent: GlobalMenu {
             onOpenJournalFolderSelectionDialog: journalFolderSelectionDialog.open()
             onOpenJournalFileSelectionDialog: journalFileSelectionDialog.open()
+            onOpenJournalExportDialog: journalExportDialog.open()
         }
     }
     Connections {
@@ -349,7 +355,7 @@ StatefulApp.StatefulWindow {
                 anchors.centerIn: parent
                 width: parent.width - (Kirigami.Units.largeSpacing * 4)
 
-                visible: !journalModel.available && !(root.initialJournalPathViaPortal && root.initialJournalPath)
+                visible: !journalModel.available && !DatabaseProvider.importing && !(root.initialJournalPathViaPortal && root.initialJournalPath)
 
                 icon.name: "data-error"
                 text: KI18n.i18nc("@title", "Unable to load journal database from selected location: ") + DatabaseProvider.localJournalPath
@@ -367,12 +373,33 @@ StatefulApp.StatefulWindow {
                 explanation: KI18n.i18nc("@info", "Application is running in sandboxed mode and requires user consent to load the selected path: ") + root.initialJournalPath
             }
 
+            Kirigami.PlaceholderMessage {
+                anchors.centerIn: parent
+                width: parent.width - (Kirigami.Units.largeSpacing * 4)
+                visible: !journalModel.available && DatabaseProvider.importing
+                icon.name: "document-import"
+                text: KI18n.i18nc("@info", "Importing journal export file…")
+            }
+
             Kirigami.PlaceholderMessage {
                 anchors.centerIn: parent
                 width: parent.width - (Kirigami.Units.largeSpacing * 4)
                 visible: journalModel.available && logView.count === 0
                 text: KI18n.i18nc("@info:tooltip", "No log entries apply to selected filters.")
             }
+
+            ProgressBar {
+                anchors {
+                    left: parent.left
+                    right: parent.right
+                    bottom: parent.bottom
+                }
+                visible: DatabaseProvider.importing
+                from: 0
+                to: 1
+                indeterminate: DatabaseProvider.importProgress < 0
+                value: DatabaseProvider.importProgress
+            }
         }
     }
 
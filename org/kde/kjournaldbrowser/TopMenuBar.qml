@@ -14,6 +14,7 @@ MenuBar {
     property StatefulApp.AbstractKirigamiApplication application: BrowserApplication
 
     signal copyViewToClipboard()
+    signal openJournalExportDialog()
     signal openJournalFileSelectionDialog()
     signal openJournalFolderSelectionDialog()
 
@@ -65,6 +66,11 @@ MenuBar {
             icon.name: "edit-copy"
             onTriggered: root.copyViewToClipboard()
         }
+        MenuItem {
+            text: KI18n.i18nc("@action:inmenu", "Export Filtered Journal…")
+            icon.name: "document-save-as"
+            onTriggered: root.openJournalExportDialog()
+        }
         Menu {
             title: KI18n.i18nc("@title:menu", "Limit Accessed Logs")
             icon.name: "view-filter"
@@ -4,8 +4,11 @@
 */
 
 #include "databaseprovider.h"
+#include "exportjournal.h"
+#include "journaldexportreader.h"
 #include "kjournaldlib_log_general.h"
 #include "localjournal.h"
+#include "multijournal.h"
 #include "systemdjournalremote.h"
 #include <QFileInfo>
 
@@ -14,6 +17,7 @@ DatabaseProvider::DatabaseProvider(QObject *parent)
 {
     connect(this, &DatabaseProvider::accessChanged, this, &DatabaseProvider::reloadJournal);
     connect(this, &DatabaseProvider::journalChanged, this, &DatabaseProvider::currentJournalInfoTextChanged);
+    connect(this, &DatabaseProvider::journalChanged, this, &DatabaseProvider::importProgressChanged);
 }
 
 DatabaseProvider::~DatabaseProvider() = default;
@@ -68,7 +72,44 @@ void DatabaseProvider::loadJournalFromLocalPath(const QUrl &url)
     Q_EMIT localJournalPathChanged();
 
     mDatabaseType = DatabaseType::FOLDER;
-    mJournalProvider = std::make_shared<LocalJournal>(mJournalPath);
+    if (QFileInfo(mJournalPath).isFile() && mJournalPath.endsWith(QLatin1String(".export"))) {
+        // large export files take seconds to index, models are populated once the index is ready
+        auto exportJournal = std::make_shared<ExportJournal>(mJournalPath, ExportJournal::IndexMode::Background);
+        connect(exportJournal.get(), &ExportJournal::indexReady, this, &DatabaseProvider::journalChanged);
+        mJournalProvider = exportJournal;
+    } else if (QFileInfo(mJournalPath).isFile() && JournaldExportReader::isCompressed(mJournalPath)) {
+        // compressed exports cannot be indexed in place, thus they are streamed into a temporary journal
+        auto importJournal = std::make_shared<SystemdJournalRemote>(mJournalPath);
+        connect(importJournal.get(), &SystemdJournalRemote::importProgressChanged, this, &DatabaseProvider::importProgressChanged);
+        // models open the journal once it is readable and follow the remaining import via journal updates
+        connect(importJournal.get(), &SystemdJournalRemote::journalReady, this, &DatabaseProvider::journalChanged);
+        mJournalProvider = importJournal;
+    } else {
+        mJournalProvider = std::make_shared<LocalJournal>(mJournalPath);
+    }
+    Q_EMIT journalChanged();
+}
+
+void DatabaseProvider::loadJournalFromLocalPaths(const QList<QUrl> &urls)
+{
+    if (urls.size() == 1) {
+        loadJournalFromLocalPath(urls.first());
+        return;
+    }
+    QStringList paths;
+    for (const QUrl &url : urls) {
+        paths.append(url.toString(QUrl::PreferLocalFile));
+    }
+    qCInfo(KJOURNALDLIB_GENERAL) << "Loading merged journal from:" << paths;
+    if (mDatabaseType == DatabaseType::MERGED && paths == mMergedJournalPaths) {
+        return;
+    }
+    mMergedJournalPaths = paths;
+    mJournalPath = QString();
+    Q_EMIT localJournalPathChanged();
+
+    mDatabaseType = DatabaseType::MERGED;
+    mJournalProvider = std::make_shared<MultiJournal>(mMergedJournalPaths);
     Q_EMIT journalChanged();
 }
 
@@ -102,6 +143,25 @@ IJournalProvider *DatabaseProvider::journalProvider()
     return mJournalProvider.get();
 }
 
+bool DatabaseProvider::isImporting() const
+{
+    if (const auto exportJournal = qobject_cast<ExportJournal *>(mJournalProvider.get())) {
+        return !exportJournal->isIndexReady();
+    }
+    const auto importJournal = qobject_cast<SystemdJournalRemote *>(mJournalProvider.get());
+    return mDatabaseType == DatabaseType::FOLDER && importJournal && !importJournal->isImportFinished();
+}
+
+qreal DatabaseProvider::importProgress() const
+{
+    if (const auto exportJournal = qobject_cast<ExportJournal *>(mJournalProvider.get())) {
+        // indexing does not report progress
+        return exportJournal->isIndexReady() ? 1. : -1.;
+    }
+    const auto importJournal = qobject_cast<SystemdJournalRemote *>(mJournalProvider.get());
+    return importJournal ? importJournal->importProgress() : 1.;
+}
+
 QString DatabaseProvider::localJournalPath() const
 {
     return mJournalPath;
@@ -116,6 +176,8 @@ QString DatabaseProvider::currentJournalInfoText() const
         return QString("[system]");
     case DatabaseType::REMOTE:
         return QString("%1:%2 [remote]").arg(mRemoteJournalUrl, mRemoteJournalPort);
+    case DatabaseType::MERGED:
+        return QString("%1 [merged]").arg(mMergedJournalPaths.join(QLatin1String(", ")));
     }
     return QString();
 }
@@ -125,11 +187,12 @@ void DatabaseProvider::initJournal()
     if (mRemoteJournalUrl.isEmpty() || mRemoteJournalPort == 0) {
         return;
     }
+    // the provider is kept for the whole session, once the journal file is created the models open it
+    // and new entries are appended via journal updates
     auto remoteJournal = std::make_shared<SystemdJournalRemote>(mRemoteJournalUrl, QString::number(mRemoteJournalPort));
-    connect(remoteJournal.get(), &SystemdJournalRemote::journalFileChanged, this, [=]() {
+    connect(remoteJournal.get(), &SystemdJournalRemote::journalReady, this, [this, remoteJournal = remoteJournal.get()]() {
         mJournalPath = QFileInfo(remoteJournal->journalFile()).absolutePath();
         Q_EMIT localJournalPathChanged();
-        mJournalProvider = std::make_shared<LocalJournal>(mJournalPath);
         Q_EMIT journalChanged();
     });
     mJournalProvider = remoteJournal;
@@ -9,6 +9,7 @@
 #include <QObject>
 #include <QQmlEngine>
 #include <QSettings>
+#include <QStringList>
 #include <ijournalprovider.h>
 
 /**
@@ -32,6 +33,15 @@ class DatabaseProvider : public QObject
     Q_PROPERTY(QString currentJournalInfoText READ currentJournalInfoText NOTIFY currentJournalInfoTextChanged FINAL)
 
     Q_PROPERTY(IJournalProvider *journalProvider READ journalProvider NOTIFY journalChanged FINAL)
+    /**
+     * true while a compressed export file is imported or an export file is indexed, the journal of a
+     * compressed export file is readable already during the import
+     */
+    Q_PROPERTY(bool importing READ isImporting NOTIFY importProgressChanged FINAL)
+    /**
+     * progress of the current import between 0 and 1, negative if the progress is unknown
+     */
+    Q_PROPERTY(qreal importProgress READ importProgress NOTIFY importProgressChanged FINAL)
 
     QML_ELEMENT
     QML_SINGLETON
@@ -41,6 +51,7 @@ public:
         FOLDER, //!< arbitrary folder that is not associated with machine-id / current-user
         LOCAL_SYSTEM, //!< local system journald database
         REMOTE, //!< reading from remote port
+        MERGED, //!< several journal files or folders that are presented as one interleaved journal
     };
     Q_ENUM(DatabaseType);
 
@@ -66,6 +77,12 @@ public:
     void setAccess(DatabaseProvider::DatabaseAccessLimit limit);
 
     Q_INVOKABLE void loadJournalFromLocalPath(const QUrl &path);
+    /**
+     * open all journal files and folders at @p urls as one journal whose entries are ordered by time
+     *
+     * @note export files are not supported here, for a single url this is equivalent to loadJournalFromLocalPath()
+     */
+    Q_INVOKABLE void loadJournalFromLocalPaths(const QList<QUrl> &urls);
     Q_INVOKABLE void loadSystemJournal();
     Q_INVOKABLE void loadJournalFromRemoteAddress(const QString &url, quint32 port);
 
@@ -78,6 +95,10 @@ public:
 
     IJournalProvider *journalProvider();
 
+    bool isImporting() const;
+
+    qreal importProgress() const;
+
 Q_SIGNALS:
     void journalChanged();
     void accessChanged();
@@ -85,6 +106,7 @@ Q_SIGNALS:
     void remoteJournalUrlChanged();
     void remoteJournalPortChanged();
     void currentJournalInfoTextChanged();
+    void importProgressChanged();
 
 private:
     void initJournal();
@@ -93,6 +115,7 @@ private:
     DatabaseType mDatabaseType{DatabaseType::LOCAL_SYSTEM};
     DatabaseAccessLimit mAccessLimit{DatabaseAccessLimit::ALL};
     QString mJournalPath;
+    QStringList mMergedJournalPaths;
     QString mRemoteJournalUrl;
     quint32 mRemoteJournalPort{0};
 
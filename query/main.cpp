@@ -0,0 +1,308 @@
+/*
+    SPDX-License-Identifier: LGPL-2.1-or-later OR MIT
+    SPDX-FileCopyrightText: 2026 Andreas Cord-Landwehr <cordlandwehr@kde.org>
+*/
+
+#include "exportjournal.h"
+#include "filter.h"
+#include "journaldhelper.h"
+#include "journaldviewmodel.h"
+#include "journalindex.h"
+#include "journalwriter.h"
+#include "kjournald_version.h"
+#include "localjournal.h"
+#include "multijournal.h"
+#include "sdjournal.h"
+#include <KAboutData>
+#include <KLocalizedString>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QMetaEnum>
+#include <algorithm>
+#include <memory>
+#include <optional>
+
+namespace
+{
+/**
+ * @return provider for the journal files and folders at @p paths, system journal if @p paths is empty
+ */
+std::unique_ptr<IJournalProvider> createProvider(const QStringList &paths)
+{
+    if (paths.isEmpty()) {
+        return std::make_unique<LocalJournal>(LocalJournal::Mode::AnyLocal);
+    }
+    if (paths.size() > 1) {
+        return std::make_unique<MultiJournal>(paths);
+    }
+    const QFileInfo info(paths.first());
+    if (info.isFile() && paths.first().endsWith(QLatin1String(".export"))) {
+        return std::make_unique<ExportJournal>(info.absoluteFilePath());
+    }
+    return std::make_unique<LocalJournal>(info.absoluteFilePath());
+}
+
+std::optional<JournaldHelper::Field> parseField(const QString &name)
+{
+    const QMetaEnum fields = QMetaEnum::fromType<JournaldHelper::Field>();
+    for (int i = 0; i < fields.keyCount(); ++i) {
+        const auto field = static_cast<JournaldHelper::Field>(fields.value(i));
+        if (JournaldHelper::mapField(field) == name) {
+            return field;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<JournaldViewModel::ExportFormat> parseFormat(const QString &name)
+{
+    if (name == QLatin1String("text")) {
+        return JournaldViewModel::PLAIN_TEXT;
+    } else if (name == QLatin1String("export")) {
+        return JournaldViewModel::JOURNAL_EXPORT;
+    } else if (name == QLatin1String("json")) {
+        return JournaldViewModel::JSON_LINES;
+    }
+    return std::nullopt;
+}
+
+/**
+ * write all entries of @p provider that match @p filter, the entries are streamed by the same code paths
+ * as the export of the browser without loading them into a model
+ */
+bool writeEntries(IJournalProvider *provider, const Filter &filter, QIODevice *device, JournaldViewModel::ExportFormat format)
+{
+    if (JournaldViewModel::exportJournal(provider, filter, device, format) < 0) {
+        qCritical() << "Journal is not readable";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * write unique values of @p field, sorted by value and optionally with their number of occurrences
+ */
+bool writeUniqueValues(IJournalProvider *provider,
+                       const QStringList &bootFilter,
+                       JournaldHelper::Field field,
+                       bool withCounts,
+                       QIODevice *device,
+                       JournaldViewModel::ExportFormat format)
+{
+    const std::shared_ptr<const JournalIndex> index = provider->journalIndex();
+    std::unique_ptr<SdJournal> journal = index ? nullptr : provider->openJournal();
+    if (!index && (!journal || !journal->isValid())) {
+        qCritical() << "Journal is not readable";
+        return false;
+    }
+
+    QStringList boots = bootFilter;
+    if (boots.isEmpty() && (withCounts || index)) {
+        // value counts are only available per boot
+        const auto bootInfo = JournaldHelper::queryOrderedBootIds(provider);
+        for (const auto &boot : bootInfo) {
+            boots.append(boot.mBootId);
+        }
+    }
+
+    QHash<QString, quint64> counts;
+    if (withCounts || index) {
+        for (const QString &bootId : std::as_const(boots)) {
+            const auto bootCounts = index ? index->uniqueCounts(bootId, {field}).value(field)
+                                          : JournaldHelper::queryUniqueCounts(journal->get(), bootId, {field}).value(field);
+            for (auto iter = bootCounts.cbegin(); iter != bootCounts.cend(); ++iter) {
+                counts[iter.key()] += iter.value();
+            }
+        }
+    } else if (boots.isEmpty()) {
+        // unique queries only use the field hash tables of the journal files and are much cheaper than counting
+        const QList<QString> values = JournaldHelper::queryUnique(journal->get(), field);
+        for (const QString &value : values) {
+            counts.insert(value, 0);
+        }
+    } else {
+        for (const QString &bootId : std::as_const(boots)) {
+            const QList<QString> values = JournaldHelper::queryUnique(journal->get(), bootId, field);
+            for (const QString &value : values) {
+                counts.insert(value, 0);
+            }
+        }
+    }
+
+    QStringList values = counts.keys();
+    std::sort(values.begin(), values.end());
+
+    const QLatin1StringView fieldName = JournaldHelper::mapField(field);
+    JournalWriter writer(device, JournaldViewModel::JSON_LINES);
+    QByteArray line;
+    for (const QString &value : std::as_const(values)) {
+        const QByteArray count = QByteArray::number(counts.value(value));
+        if (format == JournaldViewModel::JSON_LINES) {
+            writer.beginEntry();
+            writer.addField(QByteArrayView(fieldName.data(), fieldName.size()), value.toUtf8());
+            if (withCounts) {
+                writer.addField("COUNT", count);
+            }
+            if (!writer.endEntry()) {
+                return false;
+            }
+        } else {
+            line.resize(0);
+            if (withCounts) {
+                line.append(count);
+                line.append('\t');
+            }
+            line.append(value.toUtf8());
+            line.append('\n');
+            if (device->write(line) != line.size()) {
+                qCritical() << "Could not write unique values:" << device->errorString();
+                return false;
+            }
+        }
+    }
+    return writer.flush();
+}
+
+/**
+ * write boots ordered by time, i.e. last boot is written last
+ */
+bool writeBoots(IJournalProvider *provider, QIODevice *device, JournaldViewModel::ExportFormat format)
+{
+    const auto bootInfo = JournaldHelper::queryOrderedBootIds(provider);
+    JournalWriter writer(device, JournaldViewModel::JSON_LINES);
+    for (const auto &boot : bootInfo) {
+        const QByteArray since = boot.mSince.toUTC().toString(Qt::ISODateWithMs).toUtf8();
+        const QByteArray until = boot.mUntil.toUTC().toString(Qt::ISODateWithMs).toUtf8();
+        if (format == JournaldViewModel::JSON_LINES) {
+            writer.beginEntry();
+            writer.addField("_BOOT_ID", boot.mBootId.toUtf8());
+            writer.addField("SINCE", since);
+            writer.addField("UNTIL", until);
+            if (!writer.endEntry()) {
+                return false;
+            }
+        } else {
+            const QByteArray line = boot.mBootId.toUtf8() + ' ' + since + ' ' + until + '\n';
+            if (device->write(line) != line.size()) {
+                qCritical() << "Could not write boots:" << device->errorString();
+                return false;
+            }
+        }
+    }
+    return writer.flush();
+}
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setOrganizationName("KDE");
+
+    KLocalizedString::setApplicationDomain("kjournald");
+    KAboutData aboutData(QStringLiteral("kjournaldquery"),
+                         i18nc("@title Displayed program name", "KJournald Query"),
+                         KJOURNALD_VERSION_STRING,
+                         i18nc("@title KAboutData: short program description", "Command line queries for Journald logs"),
+                         KAboutLicense::LGPL_V2_1,
+                         i18nc("@info:credit", "(c) 2026 The KJournald Developers"));
+    aboutData.addAuthor(i18nc("@info:credit Developer name", "Andreas Cord-Landwehr"),
+                        i18nc("@info:credit Role", "Original Author"),
+                        QStringLiteral("cordlandwehr@kde.org"));
+    aboutData.setBugAddress("submit@bugs.kde.org");
+    KAboutData::setApplicationData(aboutData);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(i18n("Query journald databases without user interface"));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument(QStringLiteral("command"),
+                                 i18n("\"entries\" (default) writes all matching log entries, "
+                                      "\"unique <field>\" writes the unique values of a field like _SYSTEMD_UNIT, "
+                                      "\"boots\" writes all boots ordered by time"),
+                                 QStringLiteral("[entries|unique <field>|boots]"));
+    const QCommandLineOption pathOption("D", i18n("Path to journald database folder or file, if given several times the journals are merged"), "path");
+    const QCommandLineOption outputOption({"o", "output"}, i18n("Output format: text (default), export or json"), "format", "text");
+    const QCommandLineOption bootOption({"b", "boot"}, i18n("Only consider entries of this boot ID, can be given several times"), "id");
+    const QCommandLineOption unitOption({"u", "unit"}, i18n("Only consider entries of this systemd system unit, can be given several times"), "unit");
+    const QCommandLineOption userUnitOption("user-unit", i18n("Only consider entries of this systemd user unit, can be given several times"), "unit");
+    const QCommandLineOption exeOption({"e", "exe"}, i18n("Only consider entries of this executable, can be given several times"), "path");
+    const QCommandLineOption priorityOption({"p", "priority"}, i18n("Only consider entries with this or higher priority (0-7)"), "priority");
+    const QCommandLineOption kernelOption({"k", "kernel"}, i18n("Include kernel messages"));
+    const QCommandLineOption countsOption("counts", i18n("For unique values, also write their number of occurrences"));
+    parser.addOptions({pathOption, outputOption, bootOption, unitOption, userUnitOption, exeOption, priorityOption, kernelOption, countsOption});
+    parser.process(app);
+
+    const std::optional<JournaldViewModel::ExportFormat> format = parseFormat(parser.value(outputOption));
+    if (!format) {
+        qCritical() << "Unknown output format:" << parser.value(outputOption);
+        return 1;
+    }
+
+    Filter filter;
+    filter.setBootFilter(parser.values(bootOption));
+    filter.setSystemdSystemUnitFilter(parser.values(unitOption));
+    filter.setSystemdUserUnitFilter(parser.values(userUnitOption));
+    filter.setExeFilter(parser.values(exeOption));
+    filter.setKernelMessagesEnabled(parser.isSet(kernelOption));
+    if (parser.isSet(priorityOption)) {
+        bool ok{false};
+        const int priority = parser.value(priorityOption).toInt(&ok);
+        if (!ok || priority < 0 || priority > 7) {
+            qCritical() << "Invalid priority:" << parser.value(priorityOption);
+            return 1;
+        }
+        filter.setPriorityFilter(priority);
+    }
+
+    std::unique_ptr<IJournalProvider> provider = createProvider(parser.values(pathOption));
+
+    QFile output;
+    if (!output.open(stdout, QIODevice::WriteOnly)) {
+        qCritical() << "Could not open standard output:" << output.errorString();
+        return 1;
+    }
+
+    // unique values and boots are read from the field hash tables of the journal, which cannot be
+    // restricted by entry filters, hence only the boot filter is supported for unique values
+    const bool hasEntryFilter = parser.isSet(unitOption) || parser.isSet(userUnitOption) || parser.isSet(exeOption) || parser.isSet(priorityOption)
+        || parser.isSet(kernelOption);
+
+    const QStringList arguments = parser.positionalArguments();
+    const QString command = arguments.value(0, QStringLiteral("entries"));
+    bool success{false};
+    if (command == QLatin1String("entries") && arguments.size() <= 1) {
+        success = writeEntries(provider.get(), filter, &output, format.value());
+    } else if (command == QLatin1String("unique") && arguments.size() == 2) {
+        const std::optional<JournaldHelper::Field> field = parseField(arguments.at(1));
+        if (!field) {
+            qCritical() << "Unsupported field:" << arguments.at(1);
+            return 1;
+        }
+        if (format == JournaldViewModel::JOURNAL_EXPORT) {
+            qCritical() << "Export format is only supported for entries";
+            return 1;
+        }
+        if (hasEntryFilter) {
+            qCritical() << "Unique values can only be filtered by boot, the unit, user-unit, exe, priority and kernel options are only supported for entries";
+            return 1;
+        }
+        success = writeUniqueValues(provider.get(), filter.bootFilter(), field.value(), parser.isSet(countsOption), &output, format.value());
+    } else if (command == QLatin1String("boots") && arguments.size() == 1) {
+        if (format == JournaldViewModel::JOURNAL_EXPORT) {
+            qCritical() << "Export format is only supported for entries";
+            return 1;
+        }
+        if (hasEntryFilter || parser.isSet(bootOption)) {
+            qCritical() << "Boots cannot be filtered, filter options are only supported for entries and unique values";
+            return 1;
+        }
+        success = writeBoots(provider.get(), &output, format.value());
+    } else {
+        parser.showHelp(1);
+    }
+
+    return success ? 0 : 1;
+}